@@ -0,0 +1,61 @@
+#ifndef MATCHING_ENGINE_ALLOCATIONCOUNTER_HPP
+#define MATCHING_ENGINE_ALLOCATIONCOUNTER_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Counts global operator new calls made by the benchmark binary, so each
+// benchmark can report heap allocations per operation next to ns/op.
+class AllocationCounter {
+public:
+    static uint64_t allocations();
+    static uint64_t bytes();
+};
+
+// Tracks allocations over a benchmark's timed region. Use pauseTiming() and
+// resumeTiming() instead of the State methods so that setup done while the
+// clock is stopped is not charged to the operation either.
+class AllocationScope {
+public:
+    explicit AllocationScope(benchmark::State& state)
+        : state(state),
+          startAllocations(AllocationCounter::allocations()),
+          startBytes(AllocationCounter::bytes()),
+          pausedAllocations(0),
+          pausedBytes(0),
+          pauseStartAllocations(0),
+          pauseStartBytes(0) {
+    }
+
+    ~AllocationScope() {
+        state.counters["allocs/op"] = benchmark::Counter(
+            static_cast<double>(AllocationCounter::allocations() - startAllocations - pausedAllocations),
+            benchmark::Counter::kAvgIterations);
+        state.counters["bytes/op"] = benchmark::Counter(
+            static_cast<double>(AllocationCounter::bytes() - startBytes - pausedBytes),
+            benchmark::Counter::kAvgIterations);
+    }
+
+    void pauseTiming() {
+        state.PauseTiming();
+        pauseStartAllocations = AllocationCounter::allocations();
+        pauseStartBytes = AllocationCounter::bytes();
+    }
+
+    void resumeTiming() {
+        pausedAllocations += AllocationCounter::allocations() - pauseStartAllocations;
+        pausedBytes += AllocationCounter::bytes() - pauseStartBytes;
+        state.ResumeTiming();
+    }
+
+private:
+    benchmark::State& state;
+    uint64_t startAllocations;
+    uint64_t startBytes;
+    uint64_t pausedAllocations;
+    uint64_t pausedBytes;
+    uint64_t pauseStartAllocations;
+    uint64_t pauseStartBytes;
+};
+
+#endif // MATCHING_ENGINE_ALLOCATIONCOUNTER_HPP
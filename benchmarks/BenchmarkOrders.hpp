@@ -0,0 +1,45 @@
+#ifndef MATCHING_ENGINE_BENCHMARKORDERS_HPP
+#define MATCHING_ENGINE_BENCHMARKORDERS_HPP
+
+#include "../order/Order.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Shared order fixtures for the micro-benchmarks.
+
+constexpr double BENCH_MID_PRICE = 100.0;
+constexpr double BENCH_TICK = 0.01;
+constexpr int BENCH_QUANTITY = 100;
+
+// Book depth (price levels) x resting order count
+inline void bookShapes(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"depth", "orders"});
+    for (int64_t depth : {1, 10, 100, 1000}) {
+        for (int64_t orders : {1000, 10000}) {
+            benchmark->Args({depth, orders});
+        }
+    }
+}
+
+// `count` orders spread round-robin over `depth` levels moving away from
+// `bestPrice` (down for bids, up for asks)
+inline std::vector<std::shared_ptr<Order>> makeLadderOrders(const std::string& idPrefix,
+                                                            OrderSide side,
+                                                            int64_t count,
+                                                            int64_t depth,
+                                                            double bestPrice,
+                                                            int quantity = BENCH_QUANTITY) {
+    std::vector<std::shared_ptr<Order>> orders;
+    orders.reserve(static_cast<size_t>(count));
+    double direction = side == OrderSide::BUY ? -1.0 : 1.0;
+
+    for (int64_t i = 0; i < count; ++i) {
+        double price = bestPrice + direction * static_cast<double>(i % depth) * BENCH_TICK;
+        orders.push_back(std::make_shared<Order>(idPrefix + std::to_string(i), "BENCH", side, price, quantity));
+    }
+    return orders;
+}
+
+#endif // MATCHING_ENGINE_BENCHMARKORDERS_HPP
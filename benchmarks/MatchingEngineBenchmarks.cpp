@@ -0,0 +1,160 @@
+#include "AllocationCounter.hpp"
+#include "BenchmarkOrders.hpp"
+#include "../engine/MatchingEngine.hpp"
+#include "../engine/Trade.hpp"
+#include "../engine/CallAuction.hpp"
+
+namespace {
+
+// Engine whose BENCH book holds `asks` on the sell side
+std::unique_ptr<MatchingEngine> makeEngine(const std::vector<std::shared_ptr<Order>>& asks) {
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->addSymbol("BENCH");
+    auto book = engine->getOrderBook("BENCH");
+    for (const auto& order : asks) {
+        book->addOrder(order);
+    }
+    return engine;
+}
+
+double topOfLadder(int64_t depth) {
+    return BENCH_MID_PRICE + static_cast<double>(depth) * BENCH_TICK;
+}
+
+} // namespace
+
+// A buy that does not cross and rests, against `orders` asks across `depth` levels
+static void BM_ProcessOrderPassive(benchmark::State& state) {
+    int64_t depth = state.range(0);
+    int64_t count = state.range(1);
+    auto asks = makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE);
+    auto bids = makeLadderOrders("B", OrderSide::BUY, count, depth, BENCH_MID_PRICE - BENCH_TICK);
+    auto engine = makeEngine(asks);
+    size_t next = 0;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        if (next == bids.size()) {
+            allocations.pauseTiming();
+            bids = makeLadderOrders("B", OrderSide::BUY, count, depth, BENCH_MID_PRICE - BENCH_TICK);
+            engine = makeEngine(asks);
+            next = 0;
+            allocations.resumeTiming();
+        }
+        benchmark::DoNotOptimize(engine->processOrder(bids[next++]));
+    }
+}
+BENCHMARK(BM_ProcessOrderPassive)->Apply(bookShapes);
+
+// A buy that completely fills exactly one resting ask
+static void BM_ProcessOrderSingleFill(benchmark::State& state) {
+    int64_t depth = state.range(0);
+    int64_t count = state.range(1);
+    auto makeBuys = [&]() {
+        return makeLadderOrders("B", OrderSide::BUY, count, 1, topOfLadder(depth));
+    };
+    auto asks = makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE);
+    auto buys = makeBuys();
+    auto engine = makeEngine(asks);
+    size_t next = 0;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        if (next == buys.size()) {
+            allocations.pauseTiming();
+            asks = makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE);
+            buys = makeBuys();
+            engine = makeEngine(asks);
+            next = 0;
+            allocations.resumeTiming();
+        }
+        benchmark::DoNotOptimize(engine->processOrder(buys[next++]));
+    }
+}
+BENCHMARK(BM_ProcessOrderSingleFill)->Apply(bookShapes);
+
+// One buy that sweeps every resting ask across all `depth` levels
+static void BM_ProcessOrderSweep(benchmark::State& state) {
+    int64_t depth = state.range(0);
+    int64_t count = state.range(1);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        allocations.pauseTiming();
+        auto engine = makeEngine(makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE));
+        auto sweep = std::make_shared<Order>("SWEEP", "BENCH", OrderSide::BUY, topOfLadder(depth),
+                                             static_cast<int>(count) * BENCH_QUANTITY);
+        allocations.resumeTiming();
+
+        benchmark::DoNotOptimize(engine->processOrder(sweep));
+
+        // Tear the book down off the clock
+        allocations.pauseTiming();
+        engine.reset();
+        allocations.resumeTiming();
+    }
+    state.counters["fills/op"] = static_cast<double>(count);
+}
+BENCHMARK(BM_ProcessOrderSweep)
+    ->ArgNames({"depth", "orders"})
+    ->Args({1, 1})
+    ->Args({10, 10})
+    ->Args({10, 100})
+    ->Args({100, 100})
+    ->Args({100, 1000})
+    ->Args({1000, 1000});
+
+// Clearing-price search on a fully crossed book: `orders` bids and `orders`
+// asks over the same `depth` levels
+static void BM_AuctionClearing(benchmark::State& state) {
+    int64_t depth = state.range(0);
+    int64_t count = state.range(1);
+    auto engine = makeEngine(makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE));
+    auto book = engine->getOrderBook("BENCH");
+    for (const auto& bid : makeLadderOrders("B", OrderSide::BUY, count, depth, topOfLadder(depth - 1))) {
+        book->addOrder(bid);
+    }
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CallAuction::computeClearing(*book));
+    }
+}
+BENCHMARK(BM_AuctionClearing)
+    ->ArgNames({"depth", "orders"})
+    ->Args({100, 10000})
+    ->Args({1000, 100000})
+    ->Args({10000, 100000})
+    ->Unit(benchmark::kMicrosecond);
+
+// Full uncross of the same book, clearing search plus execution
+static void BM_AuctionUncross(benchmark::State& state) {
+    int64_t depth = state.range(0);
+    int64_t count = state.range(1);
+    size_t trades = 0;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        allocations.pauseTiming();
+        auto engine = makeEngine(makeLadderOrders("S", OrderSide::SELL, count, depth, BENCH_MID_PRICE));
+        engine->setMatchingMode("BENCH", MatchingMode::AUCTION);
+        for (const auto& bid : makeLadderOrders("B", OrderSide::BUY, count, depth, topOfLadder(depth - 1))) {
+            engine->processOrder(bid);
+        }
+        allocations.resumeTiming();
+
+        auto result = engine->uncross("BENCH");
+        trades = result.size();
+        benchmark::DoNotOptimize(result);
+
+        allocations.pauseTiming();
+        result.clear();
+        engine.reset();
+        allocations.resumeTiming();
+    }
+    state.counters["trades/op"] = static_cast<double>(trades);
+}
+BENCHMARK(BM_AuctionUncross)
+    ->ArgNames({"depth", "orders"})
+    ->Args({1000, 100000})
+    ->Unit(benchmark::kMillisecond);
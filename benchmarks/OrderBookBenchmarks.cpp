@@ -0,0 +1,92 @@
+#include "AllocationCounter.hpp"
+#include "BenchmarkOrders.hpp"
+#include "../order/OrderBook.hpp"
+
+namespace {
+
+std::unique_ptr<OrderBook> makeBook(const std::vector<std::shared_ptr<Order>>& orders) {
+    auto book = std::make_unique<OrderBook>("BENCH");
+    for (const auto& order : orders) {
+        book->addOrder(order);
+    }
+    return book;
+}
+
+} // namespace
+
+// Add one resting order to a book that grows up to `orders` entries across `depth` levels
+static void BM_OrderBookAddOrder(benchmark::State& state) {
+    auto orders = makeLadderOrders("B", OrderSide::BUY, state.range(1), state.range(0), BENCH_MID_PRICE);
+    auto book = std::make_unique<OrderBook>("BENCH");
+    size_t next = 0;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        if (next == orders.size()) {
+            allocations.pauseTiming();
+            book = std::make_unique<OrderBook>("BENCH");
+            next = 0;
+            allocations.resumeTiming();
+        }
+        benchmark::DoNotOptimize(book->addOrder(orders[next++]));
+    }
+}
+BENCHMARK(BM_OrderBookAddOrder)->Apply(bookShapes);
+
+// Cancel one resting order by id from a book holding `orders` entries across `depth` levels
+static void BM_OrderBookCancelOrder(benchmark::State& state) {
+    auto orders = makeLadderOrders("B", OrderSide::BUY, state.range(1), state.range(0), BENCH_MID_PRICE);
+    std::vector<std::string> ids;
+    for (const auto& order : orders) {
+        ids.push_back(order->getId());
+    }
+    auto book = makeBook(orders);
+    size_t next = 0;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        if (next == ids.size()) {
+            allocations.pauseTiming();
+            book = makeBook(orders);
+            next = 0;
+            allocations.resumeTiming();
+        }
+        benchmark::DoNotOptimize(book->cancelOrder(ids[next++]));
+    }
+}
+BENCHMARK(BM_OrderBookCancelOrder)->Apply(bookShapes);
+
+// Read the best bid and best ask from a two-sided book
+static void BM_OrderBookBestPrices(benchmark::State& state) {
+    auto bids = makeLadderOrders("B", OrderSide::BUY, state.range(1) / 2, state.range(0), BENCH_MID_PRICE - BENCH_TICK);
+    auto asks = makeLadderOrders("S", OrderSide::SELL, state.range(1) / 2, state.range(0), BENCH_MID_PRICE);
+    auto book = makeBook(bids);
+    for (const auto& order : asks) {
+        book->addOrder(order);
+    }
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->getBestBidPrice());
+        benchmark::DoNotOptimize(book->getBestAskPrice());
+    }
+}
+BENCHMARK(BM_OrderBookBestPrices)->Apply(bookShapes);
+
+// Empty the best ask level and read the new best, with the next populated
+// level `gap` ticks away. The cycle re-adds the order so the book stays the
+// same; the cost should not depend on the gap.
+static void BM_OrderBookBestLevelRecovery(benchmark::State& state) {
+    double gap = static_cast<double>(state.range(0)) * BENCH_TICK;
+    auto book = makeBook(makeLadderOrders("S", OrderSide::SELL, 1000, 100, BENCH_MID_PRICE + gap));
+    auto best = std::make_shared<Order>("BEST", "BENCH", OrderSide::SELL, BENCH_MID_PRICE, BENCH_QUANTITY);
+    book->addOrder(best);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        book->cancelOrder("BEST");
+        benchmark::DoNotOptimize(book->getBestAskPrice());
+        book->addOrder(best);
+    }
+}
+BENCHMARK(BM_OrderBookBestLevelRecovery)->ArgName("gap")->Arg(1)->Arg(1000)->Arg(1000000);
@@ -0,0 +1,394 @@
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include "../metrics/LatencyHistogram.hpp"
+#include "../workload/OrderFlowGenerator.hpp"
+#include "../workload/OrderFlowReplayer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-core scaling benchmark for ContinuousMatchingEngine.
+//
+// Each producer thread runs its own OrderFlowGenerator: a mix of passive
+// orders, aggressive (crossing) orders and cancels for its own resting
+// orders, fed into one engine for a fixed duration. Symbols are drawn from
+// a Zipf distribution so a few hot symbols can be made to dominate a shard.
+// For every engine thread count given, one run is made and a row is
+// reported with:
+//
+//   - messages/sec completed inside the measurement window
+//   - per-shard utilisation (time spent running tasks / window)
+//   - end-to-end latency percentiles, from the producer handing the message
+//     to the engine until its processing callback fires
+//   - per-shard, per-stage latency (JSON only, when the engine is built
+//     with ENABLE_LATENCY_TRACKING)
+//
+// Usage: scaling_benchmark [--threads 1,2,4,8] [--producers N] [--symbols N]
+//                          [--zipf S] [--cancel-ratio R] [--aggressive-ratio R]
+//                          [--duration SECONDS] [--warmup SECONDS]
+//                          [--rate MSGS_PER_SEC_PER_PRODUCER] [--bursts P]
+//                          [--seed N]
+//                          [--format csv|json] [--output PATH]
+//
+// --zipf 0 draws symbols uniformly; --rate 0 (the default) runs producers
+// open loop, which measures saturation throughput and queueing latency.
+// With --rate, arrivals are Poisson and --bursts sets the per-message
+// probability of entering a 10x rate burst.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t STAMP_RING_SIZE = 1 << 20;
+
+struct Options {
+    std::vector<size_t> threads = {1, 2, 4};
+    size_t producers = 2;
+    size_t symbols = 16;
+    double zipf = 0.0;
+    double cancelRatio = 0.4;
+    double aggressiveRatio = 0.2;
+    double durationSeconds = 5.0;
+    double warmupSeconds = 1.0;
+    double ratePerProducer = 0.0;
+    double burstProbability = 0.0;
+    uint64_t seed = 42;
+    std::string format = "csv";
+    std::string output;
+};
+
+struct RunResult {
+    size_t threads = 0;
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    double messagesPerSecond = 0.0;
+    double p50Micros = 0.0;
+    double p99Micros = 0.0;
+    double p999Micros = 0.0;
+    double maxMicros = 0.0;
+    std::vector<double> shardUtilisation;
+    std::vector<std::vector<StageLatencySummary>> stageLatencies;
+};
+
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Send timestamps for one producer, indexed by the sequence number embedded
+// in its order ids ("P<producer>-<seq>")
+struct ProducerStamps {
+    std::vector<std::atomic<int64_t>> submitted = std::vector<std::atomic<int64_t>>(STAMP_RING_SIZE);
+    std::vector<std::atomic<int64_t>> cancelled = std::vector<std::atomic<int64_t>>(STAMP_RING_SIZE);
+};
+
+struct RunState {
+    std::vector<std::unique_ptr<ProducerStamps>> stamps;
+    LatencyHistogram latencyNanos;
+    std::atomic<bool> stopProducers{false};
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> completedInWindow{0};
+    std::atomic<int64_t> windowStart{INT64_MAX};
+    std::atomic<int64_t> windowEnd{INT64_MAX};
+};
+
+bool parseOrderId(const std::string& id, size_t& producer, uint64_t& sequence) {
+    if (id.size() < 4 || id[0] != 'P') {
+        return false;
+    }
+    char* end = nullptr;
+    producer = static_cast<size_t>(std::strtoul(id.c_str() + 1, &end, 10));
+    if (*end != '-') {
+        return false;
+    }
+    sequence = std::strtoull(end + 1, nullptr, 10);
+    return true;
+}
+
+void onProcessed(RunState& state, const OrderProcessingResult& result) {
+    int64_t now = nowNanos();
+    state.completed.fetch_add(1, std::memory_order_relaxed);
+
+    size_t producer = 0;
+    uint64_t sequence = 0;
+    if (!parseOrderId(result.getOrderId(), producer, sequence) || producer >= state.stamps.size()) {
+        return;
+    }
+
+    auto& stamps = *state.stamps[producer];
+    auto& ring = result.getAction() == OrderProcessingResult::Action::CANCEL ? stamps.cancelled : stamps.submitted;
+    int64_t sentAt = ring[sequence & (STAMP_RING_SIZE - 1)].load(std::memory_order_relaxed);
+
+    int64_t windowStart = state.windowStart.load(std::memory_order_relaxed);
+    int64_t windowEnd = state.windowEnd.load(std::memory_order_relaxed);
+
+    // Throughput counts completions inside the window; latency covers every
+    // message sent inside it, including ones that complete while draining
+    if (now >= windowStart && now < windowEnd) {
+        state.completedInWindow.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (sentAt >= windowStart && sentAt < windowEnd) {
+        state.latencyNanos.record(static_cast<uint64_t>(std::max<int64_t>(now - sentAt, 0)));
+    }
+}
+
+void runProducer(ContinuousMatchingEngine& engine, RunState& state, const Options& options, size_t producerIndex) {
+    OrderFlowConfig config;
+    config.seed = options.seed + producerIndex * 7919;
+    config.orderIdPrefix = "P" + std::to_string(producerIndex) + "-";
+    config.symbolCount = options.symbols;
+    config.zipfExponent = options.zipf;
+    config.cancelRatio = options.cancelRatio;
+    config.aggressorRatio = options.aggressiveRatio;
+    config.meanRatePerSecond = options.ratePerProducer;
+    config.burstProbability = options.burstProbability;
+
+    OrderFlowGenerator generator(config);
+    OrderFlowReplayer replayer(engine, config.orderIdPrefix);
+    auto& stamps = *state.stamps[producerIndex];
+    auto start = Clock::now();
+
+    while (!state.stopProducers.load(std::memory_order_relaxed)) {
+        OrderFlowEvent event = generator.next();
+
+        // Paced runs follow the generator's Poisson arrival times
+        if (options.ratePerProducer > 0.0) {
+            auto due = start + std::chrono::nanoseconds(event.timestampNanos);
+            while (Clock::now() < due) {
+                if (state.stopProducers.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        auto& ring = event.action == OrderFlowAction::CANCEL ? stamps.cancelled : stamps.submitted;
+        ring[event.orderSequence & (STAMP_RING_SIZE - 1)].store(nowNanos(), std::memory_order_relaxed);
+        replayer.submit(event);
+        state.submitted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RunResult runOnce(const Options& options, size_t threads) {
+    RunState state;
+    for (size_t i = 0; i < options.producers; ++i) {
+        state.stamps.push_back(std::make_unique<ProducerStamps>());
+    }
+
+    ContinuousMatchingEngine engine(threads);
+    for (size_t i = 0; i < options.symbols; ++i) {
+        engine.addSymbol(OrderFlowGenerator::symbolName(i));
+    }
+    engine.registerOrderProcessingCallback([&state](std::shared_ptr<OrderProcessingResult> result) {
+        onProcessed(state, *result);
+    });
+    engine.start();
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < options.producers; ++i) {
+        producers.emplace_back(runProducer, std::ref(engine), std::ref(state), std::cref(options), i);
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.warmupSeconds));
+
+    auto statsAtStart = engine.getStats();
+    engine.resetStageLatencies();
+    uint64_t submittedAtStart = state.submitted.load();
+    int64_t windowStart = nowNanos();
+    state.windowStart.store(windowStart);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.durationSeconds));
+
+    int64_t windowEnd = nowNanos();
+    state.windowEnd.store(windowEnd);
+    double windowNanos = static_cast<double>(windowEnd - windowStart);
+
+    RunResult result;
+    result.threads = threads;
+    result.submitted = state.submitted.load() - submittedAtStart;
+    auto statsAtEnd = engine.getStats();
+    for (size_t shard = 0; shard < threads; ++shard) {
+        uint64_t busyNanos = statsAtEnd.workers[shard].busyNanos - statsAtStart.workers[shard].busyNanos;
+        result.shardUtilisation.push_back(static_cast<double>(busyNanos) / windowNanos);
+    }
+
+    state.stopProducers.store(true);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // Let the shards drain so the engine stops with empty queues
+    auto drainDeadline = Clock::now() + std::chrono::seconds(30);
+    while (state.completed.load() < state.submitted.load() && Clock::now() < drainDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (size_t shard = 0; shard < threads; ++shard) {
+        result.stageLatencies.push_back(engine.getStageLatencies(shard));
+    }
+    engine.stop();
+
+    result.completed = state.completedInWindow.load();
+    result.messagesPerSecond = static_cast<double>(result.completed) / (windowNanos / 1e9);
+    result.p50Micros = static_cast<double>(state.latencyNanos.getPercentile(0.50)) / 1000.0;
+    result.p99Micros = static_cast<double>(state.latencyNanos.getPercentile(0.99)) / 1000.0;
+    result.p999Micros = static_cast<double>(state.latencyNanos.getPercentile(0.999)) / 1000.0;
+    result.maxMicros = static_cast<double>(state.latencyNanos.getMax()) / 1000.0;
+    return result;
+}
+
+void writeCsv(std::ostream& out, const Options& options, const std::vector<RunResult>& results) {
+    out << "threads,producers,symbols,zipf,cancel_ratio,aggressive_ratio,duration_s,"
+           "submitted,completed,msgs_per_sec,p50_us,p99_us,p999_us,max_us,shard_utilisation\n";
+    for (const auto& result : results) {
+        out << result.threads << ',' << options.producers << ',' << options.symbols << ','
+            << options.zipf << ',' << options.cancelRatio << ',' << options.aggressiveRatio << ','
+            << options.durationSeconds << ',' << result.submitted << ',' << result.completed << ','
+            << result.messagesPerSecond << ',' << result.p50Micros << ',' << result.p99Micros << ','
+            << result.p999Micros << ',' << result.maxMicros << ',';
+        for (size_t shard = 0; shard < result.shardUtilisation.size(); ++shard) {
+            out << (shard == 0 ? "" : ";") << result.shardUtilisation[shard];
+        }
+        out << '\n';
+    }
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<RunResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << "  {\"threads\": " << result.threads
+            << ", \"producers\": " << options.producers
+            << ", \"symbols\": " << options.symbols
+            << ", \"zipf\": " << options.zipf
+            << ", \"cancel_ratio\": " << options.cancelRatio
+            << ", \"aggressive_ratio\": " << options.aggressiveRatio
+            << ", \"duration_s\": " << options.durationSeconds
+            << ", \"submitted\": " << result.submitted
+            << ", \"completed\": " << result.completed
+            << ", \"msgs_per_sec\": " << result.messagesPerSecond
+            << ", \"latency_us\": {\"p50\": " << result.p50Micros
+            << ", \"p99\": " << result.p99Micros
+            << ", \"p999\": " << result.p999Micros
+            << ", \"max\": " << result.maxMicros << "}"
+            << ", \"shard_utilisation\": [";
+        for (size_t shard = 0; shard < result.shardUtilisation.size(); ++shard) {
+            out << (shard == 0 ? "" : ", ") << result.shardUtilisation[shard];
+        }
+        out << "]";
+
+        // Only populated when the engine is built with ENABLE_LATENCY_TRACKING
+        if (ContinuousMatchingEngine::isLatencyTrackingEnabled()) {
+            out << ", \"stage_latency_us\": [";
+            for (size_t shard = 0; shard < result.stageLatencies.size(); ++shard) {
+                out << (shard == 0 ? "{" : ", {");
+                const auto& stages = result.stageLatencies[shard];
+                for (size_t s = 0; s < stages.size(); ++s) {
+                    out << (s == 0 ? "" : ", ") << "\"" << toString(stages[s].stage) << "\": {"
+                        << "\"count\": " << stages[s].count
+                        << ", \"p50\": " << static_cast<double>(stages[s].p50Nanos) / 1000.0
+                        << ", \"p99\": " << static_cast<double>(stages[s].p99Nanos) / 1000.0
+                        << ", \"p999\": " << static_cast<double>(stages[s].p999Nanos) / 1000.0
+                        << ", \"max\": " << static_cast<double>(stages[s].maxNanos) / 1000.0 << "}";
+                }
+                out << "}";
+            }
+            out << "]";
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+std::vector<size_t> parseList(const std::string& value) {
+    std::vector<size_t> values;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int parsed = std::atoi(item.c_str());
+        if (parsed > 0) {
+            values.push_back(static_cast<size_t>(parsed));
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--threads") {
+            options.threads = parseList(value);
+        } else if (flag == "--producers") {
+            options.producers = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (flag == "--symbols") {
+            options.symbols = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (flag == "--zipf") {
+            options.zipf = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--cancel-ratio") {
+            options.cancelRatio = std::atof(value.c_str());
+        } else if (flag == "--aggressive-ratio") {
+            options.aggressiveRatio = std::atof(value.c_str());
+        } else if (flag == "--duration") {
+            options.durationSeconds = std::atof(value.c_str());
+        } else if (flag == "--warmup") {
+            options.warmupSeconds = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--rate") {
+            options.ratePerProducer = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--bursts") {
+            options.burstProbability = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag == "--format") {
+            options.format = value;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.threads.empty() || options.durationSeconds <= 0.0 ||
+        options.cancelRatio < 0.0 || options.aggressiveRatio < 0.0 ||
+        options.cancelRatio + options.aggressiveRatio > 1.0 ||
+        (options.format != "csv" && options.format != "json")) {
+        std::cerr << "Invalid options" << std::endl;
+        return 1;
+    }
+
+    std::vector<RunResult> results;
+    for (size_t threads : options.threads) {
+        results.push_back(runOnce(options, threads));
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Failed to open " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+
+    if (options.format == "json") {
+        writeJson(out, options, results);
+    } else {
+        writeCsv(out, options, results);
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+#include "AllocationCounter.hpp"
+#include "../engine/Trade.hpp"
+
+// Create one trade between two resting orders
+static void BM_TradeCreateTrade(benchmark::State& state) {
+    auto buyOrder = std::make_shared<Order>("B1", "BENCH", OrderSide::BUY, 100.0, 100);
+    auto sellOrder = std::make_shared<Order>("S1", "BENCH", OrderSide::SELL, 100.0, 100);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Trade::createTrade(buyOrder, sellOrder, 100.0, 10));
+    }
+}
+BENCHMARK(BM_TradeCreateTrade);
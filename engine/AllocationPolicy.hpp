@@ -0,0 +1,94 @@
+#ifndef MATCHING_ENGINE_ALLOCATIONPOLICY_HPP
+#define MATCHING_ENGINE_ALLOCATIONPOLICY_HPP
+
+#include "../order/OrderBook.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// How an incoming order's quantity is shared among the resting orders at
+// the best price. Chosen per symbol when it is added to the engine.
+enum class AllocationPolicy {
+    FIFO,          // price-time: oldest order first
+    PRO_RATA,      // in proportion to displayed size, remainder by time
+    TOP_PRO_RATA   // oldest order filled first, the rest pro-rata
+};
+
+// Each policy below splits `quantity` across one price level and calls
+// fill(order, quantity) per allocation. fill may remove or requeue resting
+// orders, so a policy never touches `level` after its first fill.
+// MatchingEngine instantiates its match loop once per policy, so the
+// per-symbol choice costs one switch per incoming order and no virtual
+// calls in the loop.
+
+struct FifoAllocation {
+    template <typename Fill>
+    static void allocate(const PriceLevel& level, int quantity, Fill&& fill) {
+        auto front = level.orders.front();
+        fill(front, std::min(quantity, front->getQuantity()));
+    }
+};
+
+using Allocations = std::vector<std::pair<std::shared_ptr<Order>, int>>;
+
+// Share `quantity` over [first, last), whose displayed sizes add up to
+// `displayed`: floor of the proportional share each, then the remainder one
+// order at a time in time priority
+template <typename Iterator>
+void allocateProRata(Iterator first, Iterator last, int64_t displayed, int quantity, Allocations& allocations) {
+    size_t start = allocations.size();
+    int allocated = 0;
+    for (auto it = first; it != last; ++it) {
+        int size = (*it)->getQuantity();
+        int share = quantity >= displayed ? size : static_cast<int>(quantity * static_cast<int64_t>(size) / displayed);
+        allocations.emplace_back(*it, share);
+        allocated += share;
+    }
+
+    for (size_t i = start; i < allocations.size() && allocated < quantity; ++i) {
+        int extra = std::min(quantity - allocated, allocations[i].first->getQuantity() - allocations[i].second);
+        allocations[i].second += extra;
+        allocated += extra;
+    }
+}
+
+template <typename Fill>
+void fillAllocations(const Allocations& allocations, Fill&& fill) {
+    for (const auto& [order, quantity] : allocations) {
+        if (quantity > 0) {
+            fill(order, quantity);
+        }
+    }
+}
+
+struct ProRataAllocation {
+    template <typename Fill>
+    static void allocate(const PriceLevel& level, int quantity, Fill&& fill) {
+        Allocations allocations;
+        allocations.reserve(level.orders.size());
+        allocateProRata(level.orders.begin(), level.orders.end(), level.totalQuantity, quantity, allocations);
+        fillAllocations(allocations, fill);
+    }
+};
+
+struct TopProRataAllocation {
+    template <typename Fill>
+    static void allocate(const PriceLevel& level, int quantity, Fill&& fill) {
+        Allocations allocations;
+        allocations.reserve(level.orders.size());
+
+        const auto& top = level.orders.front();
+        int topQuantity = std::min(quantity, top->getQuantity());
+        allocations.emplace_back(top, topQuantity);
+        if (quantity > topQuantity) {
+            allocateProRata(std::next(level.orders.begin()), level.orders.end(),
+                            level.totalQuantity - top->getQuantity(), quantity - topQuantity, allocations);
+        }
+        fillAllocations(allocations, fill);
+    }
+};
+
+#endif // MATCHING_ENGINE_ALLOCATIONPOLICY_HPP
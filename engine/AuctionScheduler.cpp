@@ -0,0 +1,45 @@
+#include "AuctionScheduler.hpp"
+
+AuctionScheduler::AuctionScheduler(ContinuousMatchingEngine& engine,
+                                   const std::vector<std::string>& symbols,
+                                   std::chrono::milliseconds interval)
+    : engine(engine), symbols(symbols), interval(interval), stopRequested(false) {
+}
+
+AuctionScheduler::~AuctionScheduler() {
+    stop();
+}
+
+void AuctionScheduler::start() {
+    if (schedulerThread.joinable()) {
+        return;
+    }
+
+    stopRequested = false;
+    schedulerThread = std::thread(&AuctionScheduler::run, this);
+}
+
+void AuctionScheduler::stop() {
+    if (!schedulerThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopRequested = true;
+    }
+    stopCondition.notify_one();
+    schedulerThread.join();
+}
+
+void AuctionScheduler::run() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopCondition.wait_for(lock, interval, [this] { return stopRequested; })) {
+        if (!engine.isRunning()) {
+            continue;
+        }
+        for (const auto& symbol : symbols) {
+            engine.uncross(symbol);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef MATCHING_ENGINE_AUCTIONSCHEDULER_HPP
+#define MATCHING_ENGINE_AUCTIONSCHEDULER_HPP
+
+#include "ContinuousMatchingEngine.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Periodic batch auctions: sends an uncross command for each symbol every
+// interval. The symbols should be in AUCTION mode; between uncrosses their
+// orders collect on the book.
+class AuctionScheduler {
+public:
+    AuctionScheduler(ContinuousMatchingEngine& engine,
+                     const std::vector<std::string>& symbols,
+                     std::chrono::milliseconds interval);
+    ~AuctionScheduler();
+
+    void start();
+    void stop();
+
+private:
+    ContinuousMatchingEngine& engine;
+    std::vector<std::string> symbols;
+    std::chrono::milliseconds interval;
+    std::thread schedulerThread;
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;
+    bool stopRequested;
+
+    void run();
+};
+
+#endif // MATCHING_ENGINE_AUCTIONSCHEDULER_HPP
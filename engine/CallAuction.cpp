@@ -0,0 +1,91 @@
+#include "CallAuction.hpp"
+#include "Trade.hpp"
+#include <algorithm>
+#include <numeric>
+
+AuctionClearing CallAuction::computeClearing(const OrderBook& book) {
+    const auto& bids = book.getBidLevels();
+    const auto& asks = book.getAskLevels();
+    if (bids.empty() || asks.empty() || bids.begin()->first < asks.begin()->first) {
+        return {};
+    }
+
+    double bestBid = bids.begin()->first;
+    double bestAsk = asks.begin()->first;
+
+    // Crossing slice of each side, ascending
+    std::vector<const PriceLevel*> bidSlice;
+    for (auto it = bids.begin(); it != bids.end() && it->first >= bestAsk; ++it) {
+        bidSlice.push_back(&it->second);
+    }
+    std::reverse(bidSlice.begin(), bidSlice.end());
+
+    std::vector<double> prices;
+    std::vector<int64_t> demand;
+    std::vector<int64_t> supply;
+    prices.reserve(bidSlice.size() + asks.size());
+
+    auto bidIt = bidSlice.begin();
+    auto askIt = asks.begin();
+    while (bidIt != bidSlice.end() || (askIt != asks.end() && askIt->first <= bestBid)) {
+        bool takeBid = bidIt != bidSlice.end();
+        bool takeAsk = askIt != asks.end() && askIt->first <= bestBid;
+        if (takeBid && takeAsk && (*bidIt)->price != askIt->first) {
+            takeBid = (*bidIt)->price < askIt->first;
+            takeAsk = !takeBid;
+        }
+
+        prices.push_back(takeBid ? (*bidIt)->price : askIt->first);
+        demand.push_back(takeBid ? (*bidIt)->totalQuantity + (*bidIt)->hiddenQuantity : 0);
+        supply.push_back(takeAsk ? askIt->second.totalQuantity + askIt->second.hiddenQuantity : 0);
+        if (takeBid) {
+            ++bidIt;
+        }
+        if (takeAsk) {
+            ++askIt;
+        }
+    }
+
+    // Bids buy at their price or lower, asks sell at their price or higher
+    std::partial_sum(demand.rbegin(), demand.rend(), demand.rbegin());
+    std::partial_sum(supply.begin(), supply.end(), supply.begin());
+
+    AuctionClearing best;
+    int64_t bestAbsImbalance = 0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        int64_t volume = std::min(demand[i], supply[i]);
+        int64_t imbalance = demand[i] - supply[i];
+        int64_t absImbalance = imbalance < 0 ? -imbalance : imbalance;
+        if (volume > best.volume || (volume == best.volume && volume > 0 && absImbalance < bestAbsImbalance)) {
+            best = {prices[i], volume, imbalance};
+            bestAbsImbalance = absImbalance;
+        }
+    }
+    return best;
+}
+
+std::vector<std::shared_ptr<Trade>> CallAuction::execute(OrderBook& book, const AuctionClearing& clearing) {
+    std::vector<std::shared_ptr<Trade>> trades;
+    if (clearing.volume <= 0) {
+        return trades;
+    }
+
+    while (true) {
+        auto bid = book.getBestOrder(OrderSide::BUY);
+        auto ask = book.getBestOrder(OrderSide::SELL);
+        if (!bid || !ask || bid->getPrice() < clearing.price || ask->getPrice() > clearing.price) {
+            break;
+        }
+
+        int quantity = std::min(bid->getQuantity(), ask->getQuantity());
+        auto trade = Trade::createTrade(bid, ask, clearing.price, quantity);
+        if (!trade) {
+            break;
+        }
+
+        trades.push_back(trade);
+        book.fillOrder(bid, quantity);
+        book.fillOrder(ask, quantity);
+    }
+    return trades;
+}
@@ -0,0 +1,36 @@
+#ifndef MATCHING_ENGINE_CALLAUCTION_HPP
+#define MATCHING_ENGINE_CALLAUCTION_HPP
+
+#include "../order/OrderBook.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Trade;
+
+// Outcome of a call auction: the single price everything trades at
+struct AuctionClearing {
+    double price = 0.0;
+    int64_t volume = 0;     // 0 if the book does not cross
+    int64_t imbalance = 0;  // demand minus supply at `price`
+};
+
+// Uncrossing for books that collected orders without matching them.
+//
+// Only prices between the best ask and the best bid can clear, so that
+// slice of both sides is flattened into one ascending price ladder with
+// per-price bid and ask volume (hidden reserves included). Cumulative
+// demand is a suffix sum over the bid column and cumulative supply a prefix
+// sum over the ask column; each is one linear scan over a contiguous array.
+// The clearing price maximizes min(demand, supply), then minimizes the
+// imbalance, then takes the lowest price.
+class CallAuction {
+public:
+    static AuctionClearing computeClearing(const OrderBook& book);
+
+    // Trade every order that crosses `clearing.price` at that price, in
+    // price-time priority, and return the trades
+    static std::vector<std::shared_ptr<Trade>> execute(OrderBook& book, const AuctionClearing& clearing);
+};
+
+#endif // MATCHING_ENGINE_CALLAUCTION_HPP
@@ -3,24 +3,54 @@
 //
 
 #include "ContinuousMatchingEngine.hpp"
+#include "../metrics/TscClock.hpp"
+#include "../metrics/Tracer.hpp"
+#include "../logging/AsyncLogger.hpp"
+#include <algorithm>
 #include <iostream>
 
+namespace {
+
+// Shard counters have a single writer, so a plain load/store avoids a locked RMW
+void addTo(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Non-zero key for SymbolThreadPool's same-order ordering; a collision only
+// keeps a cancel in the normal lane
+uint64_t orderKeyFor(const std::string& orderId) {
+    uint64_t key = std::hash<std::string>{}(orderId);
+    return key == 0 ? 1 : key;
+}
+
+} // namespace
+
 OrderProcessingResult::OrderProcessingResult(Status status, 
                                            const std::string& orderId, 
                                            const std::string& symbol, 
                                            const std::vector<std::shared_ptr<Trade>>& trades, 
-                                           const std::string& errorMessage)
+                                           const std::string& errorMessage,
+                                           Action action,
+                                           int cancelledQuantity,
+                                           int modifiedQuantity)
     : status(status), 
       orderId(orderId), 
       symbol(symbol), 
       trades(trades), 
-      errorMessage(errorMessage) {
+      errorMessage(errorMessage),
+      action(action),
+      cancelledQuantity(cancelledQuantity),
+      modifiedQuantity(modifiedQuantity) {
 }
 
 OrderProcessingResult::Status OrderProcessingResult::getStatus() const {
     return status;
 }
 
+OrderProcessingResult::Action OrderProcessingResult::getAction() const {
+    return action;
+}
+
 const std::string& OrderProcessingResult::getOrderId() const {
     return orderId;
 }
@@ -37,17 +67,128 @@ const std::string& OrderProcessingResult::getErrorMessage() const {
     return errorMessage;
 }
 
+int OrderProcessingResult::getCancelledQuantity() const {
+    return cancelledQuantity;
+}
+
+int OrderProcessingResult::getModifiedQuantity() const {
+    return modifiedQuantity;
+}
+
+OrderCompletion::OrderCompletion() : state(PENDING), released(false) {
+}
+
+bool OrderCompletion::isReady() const {
+    return state.load(std::memory_order_acquire) == READY;
+}
+
+std::shared_ptr<OrderProcessingResult> OrderCompletion::get() {
+    uint32_t current = PENDING;
+    if (!state.compare_exchange_strong(current, BLOCKED, std::memory_order_acq_rel)) {
+        // Already READY: the shard had no waiter to wake and is done with us
+        return result;
+    }
+    while (state.load(std::memory_order_acquire) != READY) {
+        state.wait(BLOCKED, std::memory_order_acquire);
+    }
+    // The shard is still inside notify_all(); returning now would let the
+    // caller free the token under it
+    while (!released.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    return result;
+}
+
+void OrderCompletion::reset() {
+    result.reset();
+    continuation = nullptr;
+    released.store(false, std::memory_order_relaxed);
+    state.store(PENDING, std::memory_order_relaxed);
+}
+
+OrderCompletion::Awaiter OrderCompletion::operator co_await() noexcept {
+    return Awaiter{*this};
+}
+
+bool OrderCompletion::Awaiter::await_ready() const noexcept {
+    return completion.isReady();
+}
+
+bool OrderCompletion::Awaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    completion.continuation = handle;
+    uint32_t expected = PENDING;
+    // Fails only if the shard completed the token in between: resume straight away
+    return completion.state.compare_exchange_strong(expected, AWAITED, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<OrderProcessingResult> OrderCompletion::Awaiter::await_resume() {
+    return completion.result;
+}
+
+// Once READY is visible the owner may destroy the token, so nothing here
+// touches it afterwards except what the waiter is known to be waiting on
+void OrderCompletion::complete(std::shared_ptr<OrderProcessingResult> processingResult) {
+    result = std::move(processingResult);
+    uint32_t previous = state.exchange(READY, std::memory_order_acq_rel);
+    if (previous == AWAITED) {
+        // The suspended coroutine cannot free the token until it resumes
+        continuation.resume();
+    } else if (previous == BLOCKED) {
+        state.notify_all();
+        released.store(true, std::memory_order_release);
+    }
+}
+
 // constructor & destructor
 ContinuousMatchingEngine::ContinuousMatchingEngine(size_t numThreads) 
-    : matchingEngine(std::make_unique<MatchingEngine>()), 
+    : ContinuousMatchingEngine(std::make_unique<MatchingEngine>(), numThreads) {
+}
+
+ContinuousMatchingEngine::ContinuousMatchingEngine(std::unique_ptr<MatchingEngine> engine, size_t numThreads)
+    : matchingEngine(std::move(engine)), 
       threadPool(std::make_unique<SymbolThreadPool>(numThreads)),
-      running(false) {
+      running(false),
+      rejectedSubmissions(0),
+      backpressure(BackpressurePolicy::BLOCK) {
+    threadPool->setWorkerStartHook([](size_t threadIndex) {
+        Tracer::setThreadName("shard-" + std::to_string(threadIndex));
+    });
+    for (size_t i = 0; i < numThreads; ++i) {
+        shardCounters.push_back(std::make_unique<ShardCounters>());
+    }
+#ifdef ENABLE_LATENCY_TRACKING
+    for (size_t i = 0; i < numThreads; ++i) {
+        stageLatencies.push_back(std::make_unique<PipelineLatencyRecorder>());
+    }
+#endif
 }
 
 ContinuousMatchingEngine::~ContinuousMatchingEngine() {
     stop();
 }
 
+void ContinuousMatchingEngine::setPinShards(bool pin) {
+    threadPool->setPinWorkers(pin);
+}
+
+void ContinuousMatchingEngine::setQueueCapacity(size_t capacity, BackpressurePolicy policy) {
+    threadPool->setQueueCapacity(capacity);
+    backpressure = policy;
+}
+
+size_t ContinuousMatchingEngine::getQueueCapacity() const {
+    return threadPool->getQueueCapacity();
+}
+
+size_t ContinuousMatchingEngine::getQueueDepth(const std::string& symbol) const {
+    int shard = threadPool->getThreadForSymbol(symbol);
+    return shard < 0 ? 0 : threadPool->getQueueDepth(static_cast<size_t>(shard));
+}
+
+void ContinuousMatchingEngine::setCommandListener(CommandListener listener) {
+    commandListener = std::move(listener);
+}
+
 // start and stop methods for constructor & destructor
 
 void ContinuousMatchingEngine::start() {
@@ -84,46 +225,242 @@ bool ContinuousMatchingEngine::isRunning() const {
     return running.load();
 }
 
-void ContinuousMatchingEngine::submitOrder(std::shared_ptr<Order> order) {
+bool ContinuousMatchingEngine::submitOrder(std::shared_ptr<Order> order) {
+    return enqueueSubmit(std::move(order), nullptr);
+}
+
+bool ContinuousMatchingEngine::submitOrder(std::shared_ptr<Order> order, OrderCompletion& completion) {
+    return enqueueSubmit(std::move(order), &completion);
+}
+
+bool ContinuousMatchingEngine::enqueueSubmit(std::shared_ptr<Order> order, OrderCompletion* completion) {
+    const char* refusal = nullptr;
     if (!order) {
-        std::cerr << "Invalid order submitted" << std::endl;
-        return;
+        refusal = "Invalid order submitted";
+    } else if (!isRunning()) {
+        refusal = "Engine is not running";
     }
-    
-    if (!isRunning()) {
-        std::cerr << "Engine is not running" << std::endl;
-        return;
+
+    if (refusal) {
+        LOG_ERROR("{}", refusal);
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        if (completion) {
+            completion->complete(std::make_shared<OrderProcessingResult>(
+                OrderProcessingResult::Status::ERROR,
+                order ? order->getId() : "",
+                order ? order->getSymbol() : "",
+                std::vector<std::shared_ptr<Trade>>{},
+                refusal
+            ));
+        }
+        return false;
     }
     
     OrderRequest request;
     request.action = OrderAction::SUBMIT;
     request.order = order;
+    request.completion = completion;
+    request.enqueueTicks = TscClock::now();
     
-    // Submit the task to the thread pool for the specific symbol
-    threadPool->submitTask(order->getSymbol(), [this, request]() {
+    return enqueue(order->getSymbol(), request);
+}
+
+bool ContinuousMatchingEngine::enqueue(const std::string& symbol, const OrderRequest& request) {
+    QueueAdmission admission = QueueAdmission::WAIT;
+    bool perOrder = request.action == OrderAction::SUBMIT ||
+                    request.action == OrderAction::CANCEL ||
+                    request.action == OrderAction::MODIFY;
+    if (!perOrder) {
+        // Symbol-wide commands have no one order to reject, and mostly shed risk
+        admission = QueueAdmission::ALWAYS;
+    } else if (backpressure == BackpressurePolicy::REJECT) {
+        admission = QueueAdmission::REFUSE;
+    } else if (backpressure == BackpressurePolicy::SHED_NEW_ORDERS) {
+        admission = request.action == OrderAction::CANCEL ? QueueAdmission::ALWAYS : QueueAdmission::REFUSE;
+    }
+
+    // Cancels and modifies jump queued new orders, but never a queued
+    // command for the same order or a queued symbol-wide command
+    TaskLane lane = TaskLane::BARRIER;
+    uint64_t orderKey = 0;
+    if (request.action == OrderAction::SUBMIT) {
+        lane = TaskLane::NORMAL;
+        orderKey = orderKeyFor(request.order->getId());
+    } else if (perOrder) {
+        lane = TaskLane::PRIORITY;
+        orderKey = orderKeyFor(request.orderId);
+    }
+
+    // A submit is tagged with its order so a later cancel can find it
+    const void* tag = request.action == OrderAction::SUBMIT ? request.order.get() : nullptr;
+    bool queued = threadPool->submitTask(symbol, [this, request]() {
         processOrder(request);
-    });
+    }, admission, lane, orderKey, tag);
+    if (!queued && perOrder) {
+        refuseRequest(request, isRunning() ? "Shard queue full" : "Engine is not running");
+    }
+    return queued;
+}
+
+// Runs on the producer's thread, so the callbacks (which only ever run on
+// the owning shard) never hear about it; the caller gets false instead
+void ContinuousMatchingEngine::refuseRequest(const OrderRequest& request, const char* reason) {
+    rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+
+    if (request.completion) {
+        request.completion->complete(std::make_shared<OrderProcessingResult>(
+            OrderProcessingResult::Status::ERROR,
+            request.order->getId(),
+            request.order->getSymbol(),
+            std::vector<std::shared_ptr<Trade>>{},
+            reason
+        ));
+    }
 }
 
-void ContinuousMatchingEngine::cancelOrder(const std::string& orderId, const std::string& symbol) {
+bool ContinuousMatchingEngine::cancelOrder(const std::string& orderId, const std::string& symbol) {
     if (!isRunning()) {
-        std::cerr << "Engine is not running" << std::endl;
-        return;
+        LOG_ERROR("Engine is not running");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // The hash key only narrows the search; the tag confirms the order
+    int shard = threadPool->getThreadForSymbol(symbol);
+    if (shard >= 0 && threadPool->supersedeQueuedTask(shard, orderKeyFor(orderId), [&](const void* tag) {
+            auto order = static_cast<const Order*>(tag);
+            return order->getId() == orderId && order->getSymbol() == symbol;
+        })) {
+        return true;
     }
     
     OrderRequest request;
     request.action = OrderAction::CANCEL;
     request.orderId = orderId;
     request.symbol = symbol;
+    request.enqueueTicks = TscClock::now();
     
-    // Submit the task to the thread pool for the specific symbol
-    threadPool->submitTask(symbol, [this, request]() {
-        processOrder(request);
-    });
+    return enqueue(symbol, request);
+}
+
+bool ContinuousMatchingEngine::modifyOrder(const std::string& orderId, const std::string& symbol, double newPrice, int newQuantity) {
+    if (!isRunning()) {
+        LOG_ERROR("Engine is not running");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    OrderRequest request;
+    request.action = OrderAction::MODIFY;
+    request.orderId = orderId;
+    request.symbol = symbol;
+    request.price = newPrice;
+    request.quantity = newQuantity;
+    request.enqueueTicks = TscClock::now();
+    
+    return enqueue(symbol, request);
+}
+
+void ContinuousMatchingEngine::massCancel(const std::string& ownerId) {
+    if (!isRunning() || ownerId.empty()) {
+        LOG_ERROR("Cannot mass cancel: engine stopped or no owner given");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    // One task per shard covering every symbol it owns; symbols that never
+    // had a command have no shard yet and nothing to cancel
+    std::vector<std::vector<OrderRequest>> requestsByShard(threadPool->getNumThreads());
+    for (const auto& symbol : matchingEngine->getSymbols()) {
+        int shard = threadPool->getThreadForSymbol(symbol);
+        if (shard < 0) {
+            continue;
+        }
+        
+        OrderRequest request;
+        request.action = OrderAction::MASS_CANCEL;
+        request.symbol = symbol;
+        request.ownerId = ownerId;
+        request.enqueueTicks = TscClock::now();
+        requestsByShard[shard].push_back(std::move(request));
+    }
+    
+    for (size_t shard = 0; shard < requestsByShard.size(); ++shard) {
+        if (requestsByShard[shard].empty()) {
+            continue;
+        }
+        threadPool->submitShardTask(shard, [this, requests = std::move(requestsByShard[shard])]() {
+            for (const auto& request : requests) {
+                processOrder(request);
+            }
+        }, QueueAdmission::ALWAYS, TaskLane::BARRIER);
+    }
+}
+
+void ContinuousMatchingEngine::massCancel(const std::string& ownerId, const std::string& symbol) {
+    if (!isRunning() || ownerId.empty()) {
+        LOG_ERROR("Cannot mass cancel: engine stopped or no owner given");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    OrderRequest request;
+    request.action = OrderAction::MASS_CANCEL;
+    request.symbol = symbol;
+    request.ownerId = ownerId;
+    request.enqueueTicks = TscClock::now();
+    
+    enqueue(symbol, request);
+}
+
+void ContinuousMatchingEngine::massCancelSymbol(const std::string& symbol) {
+    if (!isRunning()) {
+        LOG_ERROR("Engine is not running");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    OrderRequest request;
+    request.action = OrderAction::MASS_CANCEL;
+    request.symbol = symbol;
+    request.enqueueTicks = TscClock::now();
+    
+    enqueue(symbol, request);
+}
+
+void ContinuousMatchingEngine::uncross(const std::string& symbol) {
+    if (!isRunning()) {
+        LOG_ERROR("Engine is not running");
+        rejectedSubmissions.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    OrderRequest request;
+    request.action = OrderAction::UNCROSS;
+    request.symbol = symbol;
+    request.enqueueTicks = TscClock::now();
+    
+    enqueue(symbol, request);
+}
+
+void ContinuousMatchingEngine::expireDayOrders() {
+    if (!isRunning()) {
+        LOG_ERROR("Engine is not running");
+        return;
+    }
+    
+    for (const auto& symbol : matchingEngine->getSymbols()) {
+        OrderRequest request;
+        request.action = OrderAction::EXPIRE_DAY;
+        request.symbol = symbol;
+        request.enqueueTicks = TscClock::now();
+        
+        enqueue(symbol, request);
+    }
 }
 
-bool ContinuousMatchingEngine::addSymbol(const std::string& symbol) {
-    return matchingEngine->addSymbol(symbol);
+bool ContinuousMatchingEngine::addSymbol(const std::string& symbol, MatchingMode mode, AllocationPolicy allocation) {
+    return matchingEngine->addSymbol(symbol, mode, allocation);
 }
 
 bool ContinuousMatchingEngine::removeSymbol(const std::string& symbol) {
@@ -161,39 +498,167 @@ int ContinuousMatchingEngine::getThreadForSymbol(const std::string& symbol) cons
     return threadPool->getThreadForSymbol(symbol);
 }
 
+size_t ContinuousMatchingEngine::getNumThreads() const {
+    return threadPool->getNumThreads();
+}
+
+EngineStats ContinuousMatchingEngine::getStats() const {
+    EngineStats stats;
+    stats.rejectedSubmissions = rejectedSubmissions.load(std::memory_order_relaxed);
+
+    for (size_t shard = 0; shard < threadPool->getNumThreads(); ++shard) {
+        stats.workers.push_back(threadPool->getWorkerStats(shard));
+
+        std::lock_guard<std::mutex> lock(shardCounters[shard]->mutex);
+        for (const auto& [symbol, counters] : shardCounters[shard]->symbols) {
+            stats.symbols.push_back({
+                symbol,
+                static_cast<int>(shard),
+                counters->orders.load(std::memory_order_relaxed),
+                counters->cancels.load(std::memory_order_relaxed),
+                counters->modifies.load(std::memory_order_relaxed),
+                counters->trades.load(std::memory_order_relaxed),
+                counters->rejects.load(std::memory_order_relaxed)
+            });
+        }
+    }
+
+    std::sort(stats.symbols.begin(), stats.symbols.end(), [](const SymbolStats& a, const SymbolStats& b) {
+        return a.symbol < b.symbol;
+    });
+    return stats;
+}
+
+ContinuousMatchingEngine::SymbolCounters* ContinuousMatchingEngine::countersFor(const std::string& symbol) {
+    int shard = SymbolThreadPool::getCurrentThreadIndex();
+    if (shard < 0 || static_cast<size_t>(shard) >= shardCounters.size()) {
+        return nullptr;
+    }
+
+    // Lookups need no lock: this worker is the only one that inserts
+    auto& counters = *shardCounters[shard];
+    auto it = counters.symbols.find(symbol);
+    if (it != counters.symbols.end()) {
+        return it->second.get();
+    }
+
+    auto symbolCounters = std::make_unique<SymbolCounters>();
+    symbolCounters->traceSymbolId = Tracer::internSymbol(symbol);
+
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    auto inserted = counters.symbols.emplace(symbol, std::move(symbolCounters));
+    return inserted.first->second.get();
+}
+
+std::vector<StageLatencySummary> ContinuousMatchingEngine::getStageLatencies(size_t shard) const {
+    if (shard >= stageLatencies.size()) {
+        return {};
+    }
+    return stageLatencies[shard]->summarize();
+}
+
+void ContinuousMatchingEngine::resetStageLatencies() {
+    for (auto& recorder : stageLatencies) {
+        recorder->reset();
+    }
+}
+
+bool ContinuousMatchingEngine::isLatencyTrackingEnabled() {
+#ifdef ENABLE_LATENCY_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ContinuousMatchingEngine::recordStageLatencies(const StageTimestamps& timestamps) {
+    int shard = SymbolThreadPool::getCurrentThreadIndex();
+    if (shard >= 0 && static_cast<size_t>(shard) < stageLatencies.size()) {
+        stageLatencies[shard]->record(timestamps);
+    }
+}
+
 void ContinuousMatchingEngine::processOrder(const OrderRequest& request) {
-    if (request.action == OrderAction::SUBMIT) {
-        auto trades = matchingEngine->processOrder(request.order);
+    // Stage timestamps feed both the trace ring and, when compiled in, the
+    // per-stage latency histograms
+    StageTimestamps timestamps;
+    timestamps.enqueue = request.enqueueTicks;
+    timestamps.dequeue = TscClock::now();
+
+    const std::string& symbol = request.action == OrderAction::SUBMIT ? request.order->getSymbol() : request.symbol;
+    SymbolCounters* counters = countersFor(symbol);
+
+    // A cancel caught this submit in the queue; the book never sees either
+    bool coalesced = request.action == OrderAction::SUBMIT && SymbolThreadPool::isCurrentTaskSuperseded();
+
+    if (commandListener && !coalesced) {
+        commandListener(request, matchingEngine->getOrderBook(symbol).get());
+    }
+
+    if (coalesced) {
+        timestamps.matchStart = TscClock::now();
+        timestamps.matchEnd = timestamps.matchStart;
+        processCoalescedCancel(request, counters);
+    } else if (request.action == OrderAction::SUBMIT) {
+        const auto& order = request.order;
+        bool isStop = order->isStop();
+        timestamps.matchStart = TscClock::now();
+        auto trades = matchingEngine->processOrder(order);
+        timestamps.matchEnd = TscClock::now();
         
-        OrderProcessingResult::Status status;
-        if (trades.empty()) {
-            if (request.order->getPrice() == 0.0) {
-                status = OrderProcessingResult::Status::NO_MATCH;
-            } else {
-                status = OrderProcessingResult::Status::SUCCESS;
-            }
-        } else if (request.order->getQuantity() > 0) {
-            status = OrderProcessingResult::Status::PARTIAL_FILL;
-        } else {
-            status = OrderProcessingResult::Status::SUCCESS;
+        if (counters) {
+            addTo(counters->orders, 1);
         }
+        publishOrderResult(order, trades, isStop, OrderProcessingResult::Action::SUBMIT, counters, request.completion);
+        processElectedOrders(symbol, counters);
+    } else if (request.action == OrderAction::MODIFY) {
+        std::vector<std::shared_ptr<Trade>> trades;
+        timestamps.matchStart = TscClock::now();
+        bool success = matchingEngine->modifyOrder(request.orderId, symbol, request.price, request.quantity, trades);
+        timestamps.matchEnd = TscClock::now();
         
-        auto result = std::shared_ptr<OrderProcessingResult>(
-            new OrderProcessingResult(
-                status,
-                request.order->getId(),
-                request.order->getSymbol(),
-                trades
-            )
-        );
+        auto orderBook = matchingEngine->getOrderBook(symbol);
+        auto order = success && orderBook ? orderBook->getOrderById(request.orderId) : nullptr;
+        OrderProcessingResult::Status status = OrderProcessingResult::Status::SUCCESS;
+        if (!success) {
+            status = OrderProcessingResult::Status::ERROR;
+        } else if (!trades.empty() && order) {
+            status = OrderProcessingResult::Status::PARTIAL_FILL;
+        }
         
-        notifyOrderProcessingCallbacks(result);
+        if (counters) {
+            addTo(counters->modifies, 1);
+            addTo(counters->trades, trades.size());
+            if (!success) {
+                addTo(counters->rejects, 1);
+            }
+        }
         
+        notifyOrderProcessingCallbacks(std::make_shared<OrderProcessingResult>(
+            status,
+            request.orderId,
+            symbol,
+            trades,
+            success ? "" : "Failed to modify order",
+            OrderProcessingResult::Action::MODIFY,
+            0,
+            success ? request.quantity : 0
+        ));
         for (const auto& trade : trades) {
             notifyTradeCallbacks(trade);
         }
+        processElectedOrders(symbol, counters);
     } else if (request.action == OrderAction::CANCEL) {
+        timestamps.matchStart = TscClock::now();
         bool success = matchingEngine->cancelOrder(request.orderId, request.symbol);
+        timestamps.matchEnd = TscClock::now();
+        
+        if (counters) {
+            addTo(counters->cancels, 1);
+            if (!success) {
+                addTo(counters->rejects, 1);
+            }
+        }
         
         auto result = std::shared_ptr<OrderProcessingResult>(
             new OrderProcessingResult(
@@ -201,11 +666,155 @@ void ContinuousMatchingEngine::processOrder(const OrderRequest& request) {
                 request.orderId,
                 request.symbol,
                 {},
-                success ? "" : "Failed to cancel order"
+                success ? "" : "Failed to cancel order",
+                OrderProcessingResult::Action::CANCEL
             )
         );
         
         notifyOrderProcessingCallbacks(result);
+    } else if (request.action == OrderAction::UNCROSS) {
+        timestamps.matchStart = TscClock::now();
+        auto trades = matchingEngine->uncross(symbol);
+        timestamps.matchEnd = TscClock::now();
+        
+        if (counters) {
+            addTo(counters->trades, trades.size());
+        }
+        for (const auto& trade : trades) {
+            notifyTradeCallbacks(trade);
+        }
+        processElectedOrders(symbol, counters);
+    } else if (request.action == OrderAction::MASS_CANCEL || request.action == OrderAction::EXPIRE_DAY) {
+        bool isExpiry = request.action == OrderAction::EXPIRE_DAY;
+        std::vector<std::shared_ptr<Order>> removed;
+        timestamps.matchStart = TscClock::now();
+        if (isExpiry) {
+            removed = matchingEngine->expireDayOrders(request.symbol);
+        } else if (request.ownerId.empty()) {
+            removed = matchingEngine->cancelAllOrders(request.symbol);
+        } else {
+            removed = matchingEngine->cancelOwnerOrders(request.ownerId, request.symbol);
+        }
+        timestamps.matchEnd = TscClock::now();
+        
+        if (counters && !isExpiry) {
+            addTo(counters->cancels, removed.size());
+        }
+        
+        for (const auto& order : removed) {
+            notifyOrderProcessingCallbacks(std::make_shared<OrderProcessingResult>(
+                OrderProcessingResult::Status::SUCCESS,
+                order->getId(),
+                request.symbol,
+                std::vector<std::shared_ptr<Trade>>{},
+                isExpiry ? "Day order expired" : "Mass cancel",
+                OrderProcessingResult::Action::CANCEL
+            ));
+        }
+    }
+
+    timestamps.publish = TscClock::now();
+
+    if (counters && Tracer::isEnabled()) {
+        uint32_t symbolId = counters->traceSymbolId;
+        Tracer::record(TraceEventType::QUEUE_WAIT, symbolId, timestamps.enqueue, timestamps.dequeue);
+        Tracer::record(TraceEventType::MATCH, symbolId, timestamps.matchStart, timestamps.matchEnd);
+        Tracer::record(TraceEventType::PUBLISH, symbolId, timestamps.matchEnd, timestamps.publish);
+        Tracer::record(TraceEventType::TASK, symbolId, timestamps.dequeue, timestamps.publish);
+    }
+
+#ifdef ENABLE_LATENCY_TRACKING
+    recordStageLatencies(timestamps);
+#endif
+}
+
+void ContinuousMatchingEngine::processElectedOrders(const std::string& symbol, SymbolCounters* counters) {
+    // Stops elected by the last command's trades (or a stop whose price had
+    // already traded) enter the book now, on this shard, in trigger order
+    while (auto elected = matchingEngine->popElectedOrder(symbol)) {
+        auto trades = matchingEngine->processOrder(elected);
+        publishOrderResult(elected, trades, false, OrderProcessingResult::Action::TRIGGER, counters);
+    }
+}
+
+void ContinuousMatchingEngine::processCoalescedCancel(const OrderRequest& request, SymbolCounters* counters) {
+    const auto& order = request.order;
+    if (counters) {
+        addTo(counters->orders, 1);
+        addTo(counters->cancels, 1);
+    }
+
+    auto submitResult = std::make_shared<OrderProcessingResult>(
+        OrderProcessingResult::Status::CANCELLED,
+        order->getId(),
+        order->getSymbol(),
+        std::vector<std::shared_ptr<Trade>>{},
+        "Cancelled before reaching the book",
+        OrderProcessingResult::Action::SUBMIT,
+        order->getTotalQuantity()
+    );
+    notifyOrderProcessingCallbacks(submitResult);
+    notifyOrderProcessingCallbacks(std::make_shared<OrderProcessingResult>(
+        OrderProcessingResult::Status::SUCCESS,
+        order->getId(),
+        order->getSymbol(),
+        std::vector<std::shared_ptr<Trade>>{},
+        "",
+        OrderProcessingResult::Action::CANCEL
+    ));
+
+    if (request.completion) {
+        request.completion->complete(std::move(submitResult));
+    }
+}
+
+void ContinuousMatchingEngine::publishOrderResult(const std::shared_ptr<Order>& order,
+                                                  const std::vector<std::shared_ptr<Trade>>& trades,
+                                                  bool parked,
+                                                  OrderProcessingResult::Action action,
+                                                  SymbolCounters* counters,
+                                                  OrderCompletion* completion) {
+    // Whatever an IOC, FOK or market order could not fill is dropped
+    int cancelledQuantity = parked || order->canRest() ? 0 : order->getTotalQuantity();
+    
+    OrderProcessingResult::Status status;
+    if (trades.empty()) {
+        if (cancelledQuantity > 0) {
+            status = OrderProcessingResult::Status::NO_MATCH;
+        } else {
+            status = OrderProcessingResult::Status::SUCCESS;
+        }
+    } else if (order->getTotalQuantity() > 0) {
+        status = OrderProcessingResult::Status::PARTIAL_FILL;
+    } else {
+        status = OrderProcessingResult::Status::SUCCESS;
+    }
+    
+    if (counters) {
+        addTo(counters->trades, trades.size());
+        if (status == OrderProcessingResult::Status::NO_MATCH) {
+            addTo(counters->rejects, 1);
+        }
+    }
+    
+    auto result = std::make_shared<OrderProcessingResult>(
+        status,
+        order->getId(),
+        order->getSymbol(),
+        trades,
+        "",
+        action,
+        cancelledQuantity
+    );
+    notifyOrderProcessingCallbacks(result);
+    
+    for (const auto& trade : trades) {
+        notifyTradeCallbacks(trade);
+    }
+
+    // Last, so an awaiting caller sees every notification for the order first
+    if (completion) {
+        completion->complete(std::move(result));
     }
 }
 
@@ -9,28 +9,215 @@
 #include "../order/Order.hpp"
 #include "Trade.hpp"
 #include "../threading/SymbolThreadPool.hpp"
+#include "../metrics/PipelineLatency.hpp"
 #include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
 #include <atomic>
+#include <coroutine>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
-class OrderProcessingResult;
+class OrderProcessingResult {
+public:
+    enum class Status {
+        SUCCESS,
+        PARTIAL_FILL,
+        NO_MATCH,
+        ERROR,
+        CANCELLED  // SUBMIT cancelled while still queued; it never reached the book
+    };
+
+    enum class Action {
+        SUBMIT,
+        CANCEL,
+        TRIGGER,  // a stop order entering the book after its stop price traded
+        MODIFY
+    };
+    
+    OrderProcessingResult(Status status, 
+                         const std::string& orderId, 
+                         const std::string& symbol, 
+                         const std::vector<std::shared_ptr<Trade>>& trades = {}, 
+                         const std::string& errorMessage = "",
+                         Action action = Action::SUBMIT,
+                         int cancelledQuantity = 0,
+                         int modifiedQuantity = 0);
+    
+    Status getStatus() const;
+    Action getAction() const;
+    const std::string& getOrderId() const;
+    const std::string& getSymbol() const;
+    const std::vector<std::shared_ptr<Trade>>& getTrades() const;
+    const std::string& getErrorMessage() const;
+
+    // Unfilled quantity of an IOC, FOK or market order that was dropped
+    // instead of resting
+    int getCancelledQuantity() const;
+
+    // Quantity a successful MODIFY set, before any fills it caused
+    int getModifiedQuantity() const;
+    
+private:
+    Status status;
+    std::string orderId;
+    std::string symbol;
+    std::vector<std::shared_ptr<Trade>> trades;
+    std::string errorMessage;
+    Action action;
+    int cancelledQuantity;
+    int modifiedQuantity;
+};
+
+// Completion token for one submitOrder() call, owned by the caller.
+//
+// The shard that applies the order stores its SUBMIT result in the token
+// directly, so there is no shared state to allocate and no orderId to look
+// up. Poll it with isReady(), block with get(), or co_await it from a
+// coroutine; an awaiting coroutine is resumed on the shard thread, so it
+// should hand off anything slow. The token must stay put until it is ready;
+// once get() returns, isReady() is true or the coroutine resumes, the shard
+// is done with it and it may be destroyed. reset() makes a completed token
+// reusable.
+class OrderCompletion {
+public:
+    OrderCompletion();
+    OrderCompletion(const OrderCompletion&) = delete;
+    OrderCompletion& operator=(const OrderCompletion&) = delete;
+
+    bool isReady() const;
+
+    // Block until the result is in
+    std::shared_ptr<OrderProcessingResult> get();
+
+    void reset();
+
+    struct Awaiter {
+        OrderCompletion& completion;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        std::shared_ptr<OrderProcessingResult> await_resume();
+    };
+
+    Awaiter operator co_await() noexcept;
+
+private:
+    friend class ContinuousMatchingEngine;
+
+    enum State : uint32_t {
+        PENDING,
+        BLOCKED,  // a thread is waiting in get()
+        AWAITED,  // a coroutine is suspended on the token
+        READY
+    };
+
+    std::atomic<uint32_t> state;
+    // Set by complete() once it has woken a BLOCKED waiter and will not
+    // touch the token again; get() holds off returning until then
+    std::atomic<bool> released;
+    std::coroutine_handle<> continuation;
+    std::shared_ptr<OrderProcessingResult> result;
+
+    void complete(std::shared_ptr<OrderProcessingResult> processingResult);
+};
+
+// What a shard queue at capacity does to new commands
+enum class BackpressurePolicy {
+    BLOCK,           // the submitting thread waits for room
+    REJECT,          // submits, cancels and modifies are refused at once
+    SHED_NEW_ORDERS  // submits and modifies are refused; cancels still queue
+};
+
+// Counters for one symbol, kept by the shard that owns it
+struct SymbolStats {
+    std::string symbol;
+    int shard;
+    uint64_t orders;
+    uint64_t cancels;
+    uint64_t modifies;
+    uint64_t trades;
+    uint64_t rejects;  // NO_MATCH / ERROR results
+};
+
+struct EngineStats {
+    std::vector<WorkerStats> workers;
+    std::vector<SymbolStats> symbols;
+    uint64_t rejectedSubmissions;  // refused before reaching a shard
+};
 
 class ContinuousMatchingEngine {
 public:
     ContinuousMatchingEngine(size_t numThreads = 4);
+
+    // Run on top of an engine that already holds symbols and books, such as
+    // a promoted standby's
+    ContinuousMatchingEngine(std::unique_ptr<MatchingEngine> engine, size_t numThreads);
     ~ContinuousMatchingEngine();
 
     void start();
     void stop();
     bool isRunning() const;
-    void submitOrder(std::shared_ptr<Order> order);
-    void cancelOrder(const std::string& orderId, const std::string& symbol);
-    bool addSymbol(const std::string& symbol);
+
+    // Pin each shard worker to a CPU, spread across NUMA nodes; see
+    // SymbolThreadPool::setPinWorkers. Must be called before start().
+    void setPinShards(bool pin);
+
+    // Bound each shard's queue at `capacity` commands (0, the default, is
+    // unbounded). Mass cancels, uncrosses and day expiry are always queued.
+    // Must be called before start().
+    void setQueueCapacity(size_t capacity, BackpressurePolicy policy = BackpressurePolicy::BLOCK);
+    size_t getQueueCapacity() const;
+
+    // Commands waiting on the shard that owns `symbol`, for throttling
+    // producers before the engine falls behind; 0 before its first command
+    size_t getQueueDepth(const std::string& symbol) const;
+
+    // Submit, cancel and modify return false if the command was refused
+    // before reaching a shard: engine stopped, or a full queue under
+    // REJECT or SHED_NEW_ORDERS. The callbacks only ever run on the owning
+    // shard, so they never see a refused command.
+    bool submitOrder(std::shared_ptr<Order> order);
+
+    // As above, and `completion` receives the order's SUBMIT result (not
+    // later fills or a stop's TRIGGER). An order refused before it reaches
+    // a shard completes at once with ERROR. A token whose order is still
+    // queued when the engine stops is never completed.
+    bool submitOrder(std::shared_ptr<Order> order, OrderCompletion& completion);
+
+    // A cancel whose order's submit is still the newest queued command for
+    // that order is coalesced with it: neither touches the book, and at the
+    // submit's turn the shard reports a CANCELLED SUBMIT result followed by
+    // a successful CANCEL result.
+    bool cancelOrder(const std::string& orderId, const std::string& symbol);
+
+    // Cancel/replace a resting order as one command with one result; see
+    // MatchingEngine::modifyOrder for the priority rules
+    bool modifyOrder(const std::string& orderId, const std::string& symbol, double newPrice, int newQuantity);
+
+    // Cancel every resting and parked order of `ownerId`, across all
+    // symbols or in one. The all-symbol form runs as a single command per
+    // shard. Each order is reported as a successful CANCEL result.
+    void massCancel(const std::string& ownerId);
+    void massCancel(const std::string& ownerId, const std::string& symbol);
+
+    // Cancel every resting and parked order in `symbol`
+    void massCancelSymbol(const std::string& symbol);
+
+    // Run the call auction for an AUCTION-mode symbol on its shard. Fills
+    // are reported through the trade callbacks.
+    void uncross(const std::string& symbol);
+
+    // End of the trading day: cancel every resting DAY order. Each one is
+    // reported as a successful CANCEL result.
+    void expireDayOrders();
+
+    bool addSymbol(const std::string& symbol,
+                   MatchingMode mode = MatchingMode::CONTINUOUS,
+                   AllocationPolicy allocation = AllocationPolicy::FIFO);
     bool removeSymbol(const std::string& symbol);
     bool hasSymbol(const std::string& symbol) const;
     std::vector<std::string> getSymbols() const;
@@ -39,59 +226,94 @@ public:
     void registerOrderProcessingCallback(std::function<void(std::shared_ptr<OrderProcessingResult>)> callback);
     std::string toString() const;
     int getThreadForSymbol(const std::string& symbol) const;
+    size_t getNumThreads() const;
+
+    // Relaxed snapshot of per-worker and per-symbol counters; safe to call
+    // from any thread while the engine runs
+    EngineStats getStats() const;
+
+    // Per-stage latency of commands handled by one shard. Empty unless the
+    // engine was built with ENABLE_LATENCY_TRACKING.
+    std::vector<StageLatencySummary> getStageLatencies(size_t shard) const;
+    void resetStageLatencies();
+    static bool isLatencyTrackingEnabled();
 
-private:
     enum class OrderAction {
         SUBMIT,
-        CANCEL
+        CANCEL,
+        MODIFY,
+        MASS_CANCEL,
+        UNCROSS,
+        EXPIRE_DAY
     };
     
+    // One command as a shard applies it
     struct OrderRequest {
         OrderAction action;
         std::shared_ptr<Order> order;
         std::string orderId;
         std::string symbol;
+        double price = 0.0;   // MODIFY
+        int quantity = 0;     // MODIFY
+        std::string ownerId;  // MASS_CANCEL; empty cancels the whole symbol
+        OrderCompletion* completion = nullptr;  // SUBMIT
+        uint64_t enqueueTicks = 0;
     };
-    
+
+    using CommandListener = std::function<void(const OrderRequest& request, const OrderBook* book)>;
+
+    // Called on the owning shard just before each command is applied, with
+    // the symbol's book as the earlier commands left it. Replaying each
+    // symbol's commands in this order through a MatchingEngine (with the
+    // same symbols added) rebuilds the same books. Coalesced submit/cancel
+    // pairs are not passed on. Must be set before start().
+    void setCommandListener(CommandListener listener);
+
+private:
+    struct alignas(64) SymbolCounters {
+        std::atomic<uint64_t> orders{0};
+        std::atomic<uint64_t> cancels{0};
+        std::atomic<uint64_t> modifies{0};
+        std::atomic<uint64_t> trades{0};
+        std::atomic<uint64_t> rejects{0};
+        uint32_t traceSymbolId = 0;
+    };
+
+    // Symbol counters owned by one shard. Only that shard's worker inserts
+    // or updates them; the mutex orders insertions against getStats().
+    struct ShardCounters {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<SymbolCounters>> symbols;
+    };
+
     std::unique_ptr<MatchingEngine> matchingEngine;
     std::unique_ptr<SymbolThreadPool> threadPool;
     std::atomic<bool> running;
     mutable std::mutex callbackMutex;
     std::vector<std::function<void(std::shared_ptr<Trade>)>> tradeCallbacks;
     std::vector<std::function<void(std::shared_ptr<OrderProcessingResult>)>> orderProcessingCallbacks;
+    std::vector<std::unique_ptr<PipelineLatencyRecorder>> stageLatencies;
+    std::vector<std::unique_ptr<ShardCounters>> shardCounters;
+    std::atomic<uint64_t> rejectedSubmissions;
+    CommandListener commandListener;
+    BackpressurePolicy backpressure;
     
+    bool enqueueSubmit(std::shared_ptr<Order> order, OrderCompletion* completion);
+    bool enqueue(const std::string& symbol, const OrderRequest& request);
+    void refuseRequest(const OrderRequest& request, const char* reason);
     void processOrder(const OrderRequest& request);
+    void processCoalescedCancel(const OrderRequest& request, SymbolCounters* counters);
+    void recordStageLatencies(const StageTimestamps& timestamps);
+    SymbolCounters* countersFor(const std::string& symbol);
+    void processElectedOrders(const std::string& symbol, SymbolCounters* counters);
+    void publishOrderResult(const std::shared_ptr<Order>& order,
+                            const std::vector<std::shared_ptr<Trade>>& trades,
+                            bool parked,
+                            OrderProcessingResult::Action action,
+                            SymbolCounters* counters,
+                            OrderCompletion* completion = nullptr);
     void notifyTradeCallbacks(std::shared_ptr<Trade> trade);
     void notifyOrderProcessingCallbacks(std::shared_ptr<OrderProcessingResult> result);
 };
 
-class OrderProcessingResult {
-public:
-    enum class Status {
-        SUCCESS,
-        PARTIAL_FILL,
-        NO_MATCH,
-        ERROR
-    };
-    
-    OrderProcessingResult(Status status, 
-                         const std::string& orderId, 
-                         const std::string& symbol, 
-                         const std::vector<std::shared_ptr<Trade>>& trades = {}, 
-                         const std::string& errorMessage = "");
-    
-    Status getStatus() const;
-    const std::string& getOrderId() const;
-    const std::string& getSymbol() const;
-    const std::vector<std::shared_ptr<Trade>>& getTrades() const;
-    const std::string& getErrorMessage() const;
-    
-private:
-    Status status;
-    std::string orderId;
-    std::string symbol;
-    std::vector<std::shared_ptr<Trade>> trades;
-    std::string errorMessage;
-};
-
 #endif // MATCHING_ENGINE_CONTINUOUSMATCHINGENGINE_HPP
@@ -0,0 +1,93 @@
+#include "EngineStatsReporter.hpp"
+#include <iostream>
+#include <sstream>
+
+EngineStatsReporter::EngineStatsReporter(const ContinuousMatchingEngine& engine,
+                                         const std::string& path,
+                                         std::chrono::milliseconds interval)
+    : engine(engine), path(path), interval(interval), stopRequested(false) {
+}
+
+EngineStatsReporter::~EngineStatsReporter() {
+    stop();
+}
+
+bool EngineStatsReporter::start() {
+    if (reporterThread.joinable()) {
+        return true;
+    }
+
+    file.open(path, std::ios::app);
+    if (!file) {
+        std::cerr << "Failed to open stats file: " << path << std::endl;
+        return false;
+    }
+
+    stopRequested = false;
+    reporterThread = std::thread(&EngineStatsReporter::run, this);
+    return true;
+}
+
+void EngineStatsReporter::stop() {
+    if (!reporterThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopRequested = true;
+    }
+    stopCondition.notify_one();
+    reporterThread.join();
+
+    writeSnapshot();
+    file.close();
+}
+
+void EngineStatsReporter::run() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopCondition.wait_for(lock, interval, [this] { return stopRequested; })) {
+        writeSnapshot();
+    }
+}
+
+void EngineStatsReporter::writeSnapshot() {
+    file << toJson(engine.getStats()) << '\n';
+    file.flush();
+}
+
+std::string EngineStatsReporter::toJson(const EngineStats& stats) {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::ostringstream out;
+    out << "{\"timestamp_ms\": " << now
+        << ", \"rejected_submissions\": " << stats.rejectedSubmissions
+        << ", \"workers\": [";
+    for (size_t i = 0; i < stats.workers.size(); ++i) {
+        const auto& worker = stats.workers[i];
+        out << (i == 0 ? "" : ", ")
+            << "{\"thread\": " << worker.threadIndex
+            << ", \"tasks\": " << worker.tasksProcessed
+            << ", \"busy_ns\": " << worker.busyNanos
+            << ", \"idle_ns\": " << worker.idleNanos
+            << ", \"queue_depth\": " << worker.queueDepth
+            << ", \"queue_depth_hwm\": " << worker.queueDepthHighWater
+            << ", \"cpu\": " << worker.cpu
+            << ", \"numa_node\": " << worker.numaNode << "}";
+    }
+    out << "], \"symbols\": [";
+    for (size_t i = 0; i < stats.symbols.size(); ++i) {
+        const auto& symbol = stats.symbols[i];
+        out << (i == 0 ? "" : ", ")
+            << "{\"symbol\": \"" << symbol.symbol << "\""
+            << ", \"shard\": " << symbol.shard
+            << ", \"orders\": " << symbol.orders
+            << ", \"cancels\": " << symbol.cancels
+            << ", \"modifies\": " << symbol.modifies
+            << ", \"trades\": " << symbol.trades
+            << ", \"rejects\": " << symbol.rejects << "}";
+    }
+    out << "]}";
+    return out.str();
+}
@@ -0,0 +1,40 @@
+#ifndef MATCHING_ENGINE_ENGINESTATSREPORTER_HPP
+#define MATCHING_ENGINE_ENGINESTATSREPORTER_HPP
+
+#include "ContinuousMatchingEngine.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Appends a ContinuousMatchingEngine::getStats() snapshot to a file every
+// interval, one JSON object per line, plus a final snapshot on stop().
+class EngineStatsReporter {
+public:
+    EngineStatsReporter(const ContinuousMatchingEngine& engine,
+                        const std::string& path,
+                        std::chrono::milliseconds interval = std::chrono::seconds(1));
+    ~EngineStatsReporter();
+
+    bool start();
+    void stop();
+
+    static std::string toJson(const EngineStats& stats);
+
+private:
+    const ContinuousMatchingEngine& engine;
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::ofstream file;
+    std::thread reporterThread;
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;
+    bool stopRequested;
+
+    void run();
+    void writeSnapshot();
+};
+
+#endif // MATCHING_ENGINE_ENGINESTATSREPORTER_HPP
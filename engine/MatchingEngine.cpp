@@ -4,58 +4,108 @@
 
 #include "MatchingEngine.hpp"
 #include "Trade.hpp"
+#include "CallAuction.hpp"
+#include "../logging/AsyncLogger.hpp"
 #include <sstream>
-#include <iostream>
 #include <algorithm>
 
 MatchingEngine::MatchingEngine() {
 }
 
 MatchingEngine::~MatchingEngine() {
-    orderBooks.clear();
+    symbols.clear();
 }
 
-bool MatchingEngine::addSymbol(const std::string& symbol) {
-    if (orderBooks.find(symbol) != orderBooks.end()) {
+bool MatchingEngine::addSymbol(const std::string& symbol, MatchingMode mode, AllocationPolicy allocation) {
+    if (symbols.find(symbol) != symbols.end()) {
         return false;
     }
     
-    orderBooks[symbol] = std::make_shared<OrderBook>(symbol);
+    symbols[symbol] = SymbolBooks{
+        std::make_shared<OrderBook>(symbol),
+        std::make_shared<StopBook>(symbol),
+        mode,
+        allocation
+    };
     return true;
 }
 
 bool MatchingEngine::removeSymbol(const std::string& symbol) {
-    auto it = orderBooks.find(symbol);
-    if (it == orderBooks.end()) {
-        return false;
-    }
-    
-    orderBooks.erase(it);
-    return true;
+    return symbols.erase(symbol) > 0;
 }
 
 bool MatchingEngine::hasSymbol(const std::string& symbol) const {
-    return orderBooks.find(symbol) != orderBooks.end();
+    return symbols.find(symbol) != symbols.end();
 }
 
 std::vector<std::string> MatchingEngine::getSymbols() const {
-    std::vector<std::string> symbols;
-    symbols.reserve(orderBooks.size());
+    std::vector<std::string> names;
+    names.reserve(symbols.size());
     
-    for (const auto& [symbol, _] : orderBooks) {
-        symbols.push_back(symbol);
+    for (const auto& [symbol, _] : symbols) {
+        names.push_back(symbol);
     }
     
-    return symbols;
+    return names;
+}
+
+MatchingEngine::SymbolBooks* MatchingEngine::findSymbol(const std::string& symbol) {
+    auto it = symbols.find(symbol);
+    return it == symbols.end() ? nullptr : &it->second;
+}
+
+const MatchingEngine::SymbolBooks* MatchingEngine::findSymbol(const std::string& symbol) const {
+    auto it = symbols.find(symbol);
+    return it == symbols.end() ? nullptr : &it->second;
 }
 
 std::shared_ptr<OrderBook> MatchingEngine::getOrderBook(const std::string& symbol) const {
-    auto it = orderBooks.find(symbol);
-    if (it == orderBooks.end()) {
-        return nullptr;
+    auto books = findSymbol(symbol);
+    return books ? books->orderBook : nullptr;
+}
+
+std::shared_ptr<StopBook> MatchingEngine::getStopBook(const std::string& symbol) const {
+    auto books = findSymbol(symbol);
+    return books ? books->stopBook : nullptr;
+}
+
+bool MatchingEngine::setMatchingMode(const std::string& symbol, MatchingMode mode) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return false;
+    }
+    
+    if (mode == MatchingMode::CONTINUOUS && CallAuction::computeClearing(*books->orderBook).volume > 0) {
+        LOG_ERROR("Cannot resume continuous matching on a crossed book: {}", symbol);
+        return false;
+    }
+    
+    books->mode = mode;
+    return true;
+}
+
+MatchingMode MatchingEngine::getMatchingMode(const std::string& symbol) const {
+    auto books = findSymbol(symbol);
+    return books ? books->mode : MatchingMode::CONTINUOUS;
+}
+
+AllocationPolicy MatchingEngine::getAllocationPolicy(const std::string& symbol) const {
+    auto books = findSymbol(symbol);
+    return books ? books->allocation : AllocationPolicy::FIFO;
+}
+
+std::vector<std::shared_ptr<Trade>> MatchingEngine::uncross(const std::string& symbol) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return {};
     }
     
-    return it->second;
+    auto& orderBook = *books->orderBook;
+    auto trades = CallAuction::execute(orderBook, CallAuction::computeClearing(orderBook));
+    if (!trades.empty()) {
+        books->stopBook->onTrade(trades.back()->getPrice());
+    }
+    return trades;
 }
 
 std::vector<std::shared_ptr<Trade>> MatchingEngine::processOrder(std::shared_ptr<Order> order) {
@@ -64,44 +114,147 @@ std::vector<std::shared_ptr<Trade>> MatchingEngine::processOrder(std::shared_ptr
     }
     
     const std::string& symbol = order->getSymbol();
-    auto orderBook = getOrderBook(symbol);
+    auto books = findSymbol(symbol);
     
-    if (!orderBook) {
+    if (!books) {
         if (!addSymbol(symbol)) {
             return {};
         }
-        orderBook = getOrderBook(symbol);
+        books = findSymbol(symbol);
     }
     
-    std::vector<std::shared_ptr<Trade>> trades;
+    auto& orderBook = *books->orderBook;
+    auto& stopBook = *books->stopBook;
+    if (order->isStop()) {
+        double lastTradePrice = stopBook.getLastTradePrice();
+        if (lastTradePrice > 0.0 && order->isTriggeredBy(lastTradePrice)) {
+            stopBook.electNow(order);
+        } else {
+            stopBook.addOrder(order);
+        }
+        return {};
+    }
     
-    if (order->getPrice() == 0.0) {
-        if (!canMatchMarketOrder(order, orderBook)) {
-            std::cerr << "Cannot match market order: " << order->toString() << std::endl;
-            return {};
+    if (books->mode == MatchingMode::AUCTION) {
+        if (order->canRest()) {
+            orderBook.addOrder(order);
         }
+        return {};
+    }
+    
+    if (order->getTimeInForce() == TimeInForce::FOK &&
+        orderBook.getMatchableQuantity(*order) < order->getTotalQuantity()) {
+        return {};
     }
     
-    if (order->isBuy()) {
-        trades = matchBuyOrder(order, orderBook);
-    } else {
-        trades = matchSellOrder(order, orderBook);
+    auto trades = matchOrder(order, *books);
+    if (!trades.empty()) {
+        stopBook.onTrade(trades.back()->getPrice());
     }
     
-    if (order->getQuantity() > 0) {
-        orderBook->addOrder(order);
+    if (order->getTotalQuantity() > 0) {
+        if (order->canRest()) {
+            orderBook.addOrder(order);
+        } else if (trades.empty() && order->isMarket()) {
+            LOG_WARN("Cannot match market order: {} {} {} {}", order->getId(), symbol,
+                     order->isBuy() ? "BUY" : "SELL", order->getTotalQuantity());
+        }
     }
     
     return trades;
 }
 
+std::shared_ptr<Order> MatchingEngine::popElectedOrder(const std::string& symbol) {
+    auto stopBook = getStopBook(symbol);
+    if (!stopBook) {
+        return nullptr;
+    }
+    
+    return stopBook->popElectedOrder();
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::expireDayOrders(const std::string& symbol) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return {};
+    }
+    
+    auto expired = books->orderBook->expireDayOrders();
+    auto expiredStops = books->stopBook->expireDayOrders();
+    expired.insert(expired.end(), expiredStops.begin(), expiredStops.end());
+    return expired;
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::cancelOwnerOrders(const std::string& ownerId, const std::string& symbol) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return {};
+    }
+    
+    auto cancelled = books->orderBook->cancelOwnerOrders(ownerId);
+    auto cancelledStops = books->stopBook->cancelOwnerOrders(ownerId);
+    cancelled.insert(cancelled.end(), cancelledStops.begin(), cancelledStops.end());
+    return cancelled;
+}
+
+std::vector<std::shared_ptr<Order>> MatchingEngine::cancelAllOrders(const std::string& symbol) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return {};
+    }
+    
+    auto cancelled = books->orderBook->cancelAllOrders();
+    auto cancelledStops = books->stopBook->cancelAllOrders();
+    cancelled.insert(cancelled.end(), cancelledStops.begin(), cancelledStops.end());
+    return cancelled;
+}
+
 bool MatchingEngine::cancelOrder(const std::string& orderId, const std::string& symbol) {
-    auto orderBook = getOrderBook(symbol);
-    if (!orderBook) {
+    auto books = findSymbol(symbol);
+    if (!books) {
+        return false;
+    }
+    
+    return books->orderBook->cancelOrder(orderId) || books->stopBook->cancelOrder(orderId);
+}
+
+bool MatchingEngine::modifyOrder(const std::string& orderId, const std::string& symbol, double newPrice, int newQuantity,
+                                 std::vector<std::shared_ptr<Trade>>& trades) {
+    auto books = findSymbol(symbol);
+    if (!books || newPrice <= 0.0 || newQuantity <= 0) {
         return false;
     }
     
-    return orderBook->cancelOrder(orderId);
+    auto& orderBook = *books->orderBook;
+    auto order = orderBook.getOrderById(orderId);
+    if (!order) {
+        return false;
+    }
+    
+    if (newPrice == order->getPrice()) {
+        return orderBook.resizeOrder(orderId, newQuantity);
+    }
+    
+    auto opposite = orderBook.getBestOrder(order->isBuy() ? OrderSide::SELL : OrderSide::BUY);
+    bool crosses = opposite && (order->isBuy() ? newPrice >= opposite->getPrice() : newPrice <= opposite->getPrice());
+    if (!crosses || books->mode == MatchingMode::AUCTION) {
+        return orderBook.repriceOrder(orderId, newPrice, newQuantity);
+    }
+    
+    // Aggressive replace: take it off the book and match it like a new order
+    orderBook.cancelOrder(orderId);
+    order->setPrice(newPrice);
+    order->setTotalQuantity(newQuantity);
+    
+    auto newTrades = matchOrder(order, *books);
+    if (!newTrades.empty()) {
+        books->stopBook->onTrade(newTrades.back()->getPrice());
+    }
+    if (order->getTotalQuantity() > 0) {
+        orderBook.addOrder(order);
+    }
+    trades.insert(trades.end(), newTrades.begin(), newTrades.end());
+    return true;
 }
 
 double MatchingEngine::getBestBidPrice(const std::string& symbol) const {
@@ -144,86 +297,55 @@ std::string MatchingEngine::toString() const {
     std::stringstream ss;
     ss << "MatchingEngine{" << std::endl;
     
-    for (const auto& [symbol, orderBook] : orderBooks) {
-        ss << "  " << orderBook->toString() << std::endl;
+    for (const auto& [symbol, books] : symbols) {
+        ss << "  " << books.orderBook->toString() << std::endl;
     }
     
     ss << "}";
     return ss.str();
 }
 
-std::vector<std::shared_ptr<Trade>> MatchingEngine::matchBuyOrder(std::shared_ptr<Order> buyOrder, std::shared_ptr<OrderBook> orderBook) {
-    std::vector<std::shared_ptr<Trade>> trades;
-    
-    auto sellOrders = orderBook->getAllSellOrders();
-    
-    for (auto& sellOrder : sellOrders) {
-        if (buyOrder->getQuantity() <= 0) {
-            break;
-        }
-        
-        if (buyOrder->getPrice() == 0.0 || buyOrder->getPrice() >= sellOrder->getPrice()) {
-            int matchQuantity = std::min(buyOrder->getQuantity(), sellOrder->getQuantity());
-            
-            double tradePrice = sellOrder->getPrice();
-            auto trade = Trade::createTrade(buyOrder, sellOrder, tradePrice, matchQuantity);
-            
-            if (trade) {
-                trades.push_back(trade);
-                
-                buyOrder->setQuantity(buyOrder->getQuantity() - matchQuantity);
-                sellOrder->setQuantity(sellOrder->getQuantity() - matchQuantity);
-                
-                if (sellOrder->getQuantity() <= 0) {
-                    orderBook->cancelOrder(sellOrder->getId());
-                }
-            }
-        } else {
-            break;
-        }
+std::vector<std::shared_ptr<Trade>> MatchingEngine::matchOrder(const std::shared_ptr<Order>& order, const SymbolBooks& books) {
+    switch (books.allocation) {
+        case AllocationPolicy::PRO_RATA:
+            return matchOrderWith<ProRataAllocation>(order, *books.orderBook);
+        case AllocationPolicy::TOP_PRO_RATA:
+            return matchOrderWith<TopProRataAllocation>(order, *books.orderBook);
+        default:
+            return matchOrderWith<FifoAllocation>(order, *books.orderBook);
     }
-    
-    return trades;
 }
 
-std::vector<std::shared_ptr<Trade>> MatchingEngine::matchSellOrder(std::shared_ptr<Order> sellOrder, std::shared_ptr<OrderBook> orderBook) {
+template <typename Policy>
+std::vector<std::shared_ptr<Trade>> MatchingEngine::matchOrderWith(const std::shared_ptr<Order>& order, OrderBook& orderBook) {
     std::vector<std::shared_ptr<Trade>> trades;
+    OrderSide restingSide = order->isBuy() ? OrderSide::SELL : OrderSide::BUY;
     
-    auto buyOrders = orderBook->getAllBuyOrders();
-    
-    for (auto& buyOrder : buyOrders) {
-        if (sellOrder->getQuantity() <= 0) {
+    while (order->getQuantity() > 0 || order->replenish()) {
+        const PriceLevel* level = orderBook.getBestLevel(restingSide);
+        if (!level || !OrderBook::crosses(*order, level->price)) {
             break;
         }
         
-        if (sellOrder->getPrice() == 0.0 || sellOrder->getPrice() <= buyOrder->getPrice()) {
-            int matchQuantity = std::min(sellOrder->getQuantity(), buyOrder->getQuantity());
-            
-            double tradePrice = buyOrder->getPrice();
-            auto trade = Trade::createTrade(buyOrder, sellOrder, tradePrice, matchQuantity);
-            
-            if (trade) {
-                trades.push_back(trade);
-                
-                sellOrder->setQuantity(sellOrder->getQuantity() - matchQuantity);
-                buyOrder->setQuantity(buyOrder->getQuantity() - matchQuantity);
-                
-                if (buyOrder->getQuantity() <= 0) {
-                    orderBook->cancelOrder(buyOrder->getId());
-                }
+        double tradePrice = level->price;
+        size_t tradeCount = trades.size();
+        Policy::allocate(*level, order->getQuantity(), [&](const std::shared_ptr<Order>& resting, int matchQuantity) {
+            auto trade = order->isBuy()
+                ? Trade::createTrade(order, resting, tradePrice, matchQuantity)
+                : Trade::createTrade(resting, order, tradePrice, matchQuantity);
+            if (!trade) {
+                return;
             }
-        } else {
+            
+            trades.push_back(trade);
+            order->setQuantity(order->getQuantity() - matchQuantity);
+            orderBook.fillOrder(resting, matchQuantity);
+        });
+        
+        if (trades.size() == tradeCount) {
             break;
         }
     }
     
     return trades;
 }
-
-bool MatchingEngine::canMatchMarketOrder(std::shared_ptr<Order> order, std::shared_ptr<OrderBook> orderBook) const {
-    if (order->isBuy()) {
-        return orderBook->getBestAskPrice() > 0.0;
-    } else {
-        return orderBook->getBestBidPrice() > 0.0;
-    }
-}
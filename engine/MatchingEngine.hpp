@@ -10,25 +10,81 @@
 #include <string>
 #include <vector>
 #include "../order/OrderBook.hpp"
+#include "../order/StopBook.hpp"
 #include "../order/Order.hpp"
+#include "AllocationPolicy.hpp"
 
 class Trade;
 
+enum class MatchingMode {
+    CONTINUOUS,  // incoming orders match as they arrive
+    AUCTION      // orders collect on the book until uncross()
+};
+
 class MatchingEngine {
 private:
-    std::unordered_map<std::string, std::shared_ptr<OrderBook>> orderBooks;
+    // Everything the engine keeps per symbol, found with one lookup
+    struct SymbolBooks {
+        std::shared_ptr<OrderBook> orderBook;
+        std::shared_ptr<StopBook> stopBook;
+        MatchingMode mode;
+        AllocationPolicy allocation;
+    };
+
+    std::unordered_map<std::string, SymbolBooks> symbols;
 
 public:
     MatchingEngine();
     ~MatchingEngine();
 
-    bool addSymbol(const std::string& symbol);
+    bool addSymbol(const std::string& symbol,
+                   MatchingMode mode = MatchingMode::CONTINUOUS,
+                   AllocationPolicy allocation = AllocationPolicy::FIFO);
     bool removeSymbol(const std::string& symbol);
     bool hasSymbol(const std::string& symbol) const;
     std::vector<std::string> getSymbols() const;
     std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const;
+    std::shared_ptr<StopBook> getStopBook(const std::string& symbol) const;
+
+    // Switch a symbol between continuous matching and call auction. Fails
+    // for an unknown symbol, or when leaving AUCTION with a crossed book
+    // (uncross it first).
+    bool setMatchingMode(const std::string& symbol, MatchingMode mode);
+    MatchingMode getMatchingMode(const std::string& symbol) const;
+    AllocationPolicy getAllocationPolicy(const std::string& symbol) const;
+
+    // Run a call auction on the symbol's book: trade everything that
+    // crosses at the single price maximizing volume (see CallAuction)
+    std::vector<std::shared_ptr<Trade>> uncross(const std::string& symbol);
+
+    // Match `order` under its symbol's allocation policy, or park it if it
+    // is an untriggered stop. In AUCTION mode limit orders rest without
+    // matching and anything that cannot rest is dropped. Stops elected by
+    // the resulting trades are queued, not processed; drain them with
+    // popElectedOrder() and feed each back through processOrder().
     std::vector<std::shared_ptr<Trade>> processOrder(std::shared_ptr<Order> order);
+
+    // Next triggered stop for the symbol, in trigger order, or nullptr
+    std::shared_ptr<Order> popElectedOrder(const std::string& symbol);
+
     bool cancelOrder(const std::string& orderId, const std::string& symbol);
+
+    // Cancel/replace a resting order in one step. `newQuantity` is the new
+    // quantity still to fill. A decrease at the same price keeps queue
+    // priority; anything else requeues at the back of the new level. In
+    // CONTINUOUS mode a new price that crosses the other side trades at
+    // once, and those trades are appended to `trades`. Returns false if
+    // the order is not resting.
+    bool modifyOrder(const std::string& orderId, const std::string& symbol, double newPrice, int newQuantity,
+                     std::vector<std::shared_ptr<Trade>>& trades);
+
+    // End of the trading day: remove and return the symbol's DAY orders
+    std::vector<std::shared_ptr<Order>> expireDayOrders(const std::string& symbol);
+
+    // Remove and return the symbol's resting and parked orders, all of them
+    // or only `ownerId`'s
+    std::vector<std::shared_ptr<Order>> cancelOwnerOrders(const std::string& ownerId, const std::string& symbol);
+    std::vector<std::shared_ptr<Order>> cancelAllOrders(const std::string& symbol);
     double getBestBidPrice(const std::string& symbol) const;
     double getBestAskPrice(const std::string& symbol) const;
     int getBidSize(const std::string& symbol, double price) const;
@@ -36,9 +92,15 @@ public:
     std::string toString() const;
 
 private:
-    std::vector<std::shared_ptr<Trade>> matchBuyOrder(std::shared_ptr<Order> order, std::shared_ptr<OrderBook> orderBook);
-    std::vector<std::shared_ptr<Trade>> matchSellOrder(std::shared_ptr<Order> order, std::shared_ptr<OrderBook> orderBook);
-    bool canMatchMarketOrder(std::shared_ptr<Order> order, std::shared_ptr<OrderBook> orderBook) const;
+    SymbolBooks* findSymbol(const std::string& symbol);
+    const SymbolBooks* findSymbol(const std::string& symbol) const;
+
+    // Trade `order` against the opposite side under the symbol's policy
+    std::vector<std::shared_ptr<Trade>> matchOrder(const std::shared_ptr<Order>& order, const SymbolBooks& books);
+
+    // Best price first; within a level `Policy` decides who fills
+    template <typename Policy>
+    std::vector<std::shared_ptr<Trade>> matchOrderWith(const std::shared_ptr<Order>& order, OrderBook& orderBook);
 };
 
 #endif // MATCHING_ENGINE_MATCHINGENGINE_HPP
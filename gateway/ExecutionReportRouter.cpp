@@ -0,0 +1,151 @@
+#include "ExecutionReportRouter.hpp"
+
+ExecutionReportRouter::ExecutionReportRouter(ReportSink sink) : sink(std::move(sink)) {
+}
+
+std::string ExecutionReportRouter::makeOrderId(uint64_t sessionId, uint64_t clientOrderId) {
+    return makeOwnerId(sessionId) + ":" + std::to_string(clientOrderId);
+}
+
+std::string ExecutionReportRouter::makeOwnerId(uint64_t sessionId) {
+    return std::to_string(sessionId);
+}
+
+bool ExecutionReportRouter::trackOrder(uint64_t sessionId, uint64_t clientOrderId, const std::shared_ptr<Order>& order) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return orders.emplace(order->getId(),
+                          TrackedOrder{sessionId, clientOrderId, order->getSymbol(), order->getTotalQuantity()}).second;
+}
+
+bool ExecutionReportRouter::isTracked(const std::string& orderId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return orders.find(orderId) != orders.end();
+}
+
+void ExecutionReportRouter::untrackOrder(const std::string& orderId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    orders.erase(orderId);
+}
+
+void ExecutionReportRouter::onOrderProcessed(const std::shared_ptr<OrderProcessingResult>& result) {
+    TrackedOrder tracked;
+    ExecutionReportType type;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = orders.find(result->getOrderId());
+        if (it == orders.end()) {
+            return;
+        }
+        tracked = it->second;
+
+        if (result->getAction() == OrderProcessingResult::Action::CANCEL) {
+            if (result->getStatus() == OrderProcessingResult::Status::SUCCESS) {
+                type = ExecutionReportType::CANCELLED;
+                tracked.leavesQuantity = 0;
+                orders.erase(it);
+            } else {
+                type = ExecutionReportType::CANCEL_REJECTED;
+            }
+        } else if (result->getAction() == OrderProcessingResult::Action::MODIFY) {
+            // Any fills the new price caused follow through the trade callback
+            if (result->getStatus() == OrderProcessingResult::Status::ERROR) {
+                type = ExecutionReportType::REPLACE_REJECTED;
+            } else {
+                type = ExecutionReportType::REPLACED;
+                it->second.leavesQuantity = result->getModifiedQuantity();
+                tracked = it->second;
+            }
+        } else {
+            switch (result->getStatus()) {
+                case OrderProcessingResult::Status::ERROR:
+                    type = ExecutionReportType::REJECTED;
+                    tracked.leavesQuantity = 0;
+                    orders.erase(it);
+                    break;
+                case OrderProcessingResult::Status::CANCELLED:
+                    // Coalesced with its cancel; the CANCEL result that
+                    // follows reports it
+                    return;
+                case OrderProcessingResult::Status::NO_MATCH:
+                    type = ExecutionReportType::CANCELLED;
+                    tracked.leavesQuantity = 0;
+                    orders.erase(it);
+                    break;
+                default:
+                    // Fills follow through the trade callback; an IOC or
+                    // market remainder will never fill, so stop waiting for it
+                    type = ExecutionReportType::NEW;
+                    it->second.leavesQuantity -= result->getCancelledQuantity();
+                    tracked = it->second;
+                    if (result->getAction() == OrderProcessingResult::Action::TRIGGER) {
+                        // The client already saw NEW when the stop was accepted
+                        return;
+                    }
+                    break;
+            }
+        }
+    }
+
+    deliver(tracked, type, 0, 0.0);
+}
+
+void ExecutionReportRouter::onTrade(const std::shared_ptr<Trade>& trade) {
+    applyFill(trade->getBuyOrderId(), trade->getQuantity(), trade->getPrice());
+    applyFill(trade->getSellOrderId(), trade->getQuantity(), trade->getPrice());
+}
+
+void ExecutionReportRouter::applyFill(const std::string& orderId, int quantity, double price) {
+    TrackedOrder tracked;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = orders.find(orderId);
+        if (it == orders.end()) {
+            return;
+        }
+
+        it->second.leavesQuantity -= quantity;
+        tracked = it->second;
+        if (tracked.leavesQuantity <= 0) {
+            orders.erase(it);
+        }
+    }
+
+    deliver(tracked,
+            tracked.leavesQuantity > 0 ? ExecutionReportType::PARTIAL_FILL : ExecutionReportType::FILL,
+            quantity,
+            price);
+}
+
+void ExecutionReportRouter::detach() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sink = nullptr;
+    orders.clear();
+}
+
+size_t ExecutionReportRouter::getTrackedOrderCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return orders.size();
+}
+
+void ExecutionReportRouter::deliver(const TrackedOrder& tracked, ExecutionReportType type, int lastQuantity, double lastPrice) {
+    auto report = makeMessage<ExecutionReportMessage>(MessageType::EXECUTION_REPORT);
+    report.clientOrderId = tracked.clientOrderId;
+    encodeSymbol(tracked.symbol, report.symbol);
+    report.reportType = type;
+    report.lastQuantity = lastQuantity;
+    report.leavesQuantity = tracked.leavesQuantity > 0 ? tracked.leavesQuantity : 0;
+    report.lastPrice = lastPrice;
+
+    ReportSink currentSink;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentSink = sink;
+        report.sequence = ++symbolSequences[tracked.symbol];
+    }
+
+    if (currentSink) {
+        currentSink(tracked.sessionId, report);
+    }
+}
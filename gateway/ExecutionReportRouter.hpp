@@ -0,0 +1,64 @@
+#ifndef MATCHING_ENGINE_EXECUTIONREPORTROUTER_HPP
+#define MATCHING_ENGINE_EXECUTIONREPORTROUTER_HPP
+
+#include "Protocol.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Translates engine callbacks into wire execution reports for the session
+// that owns each order. Transports track an order before submitting it and
+// receive the reports for it through their sink.
+class ExecutionReportRouter {
+public:
+    using ReportSink = std::function<void(uint64_t sessionId, const ExecutionReportMessage& report)>;
+
+    explicit ExecutionReportRouter(ReportSink sink);
+
+    // Builds the engine order id for a session's client order id
+    static std::string makeOrderId(uint64_t sessionId, uint64_t clientOrderId);
+
+    // Owner id stamped on every order a session submits
+    static std::string makeOwnerId(uint64_t sessionId);
+
+    // Remember who owns an order; returns false if the id is already live
+    bool trackOrder(uint64_t sessionId, uint64_t clientOrderId, const std::shared_ptr<Order>& order);
+
+    bool isTracked(const std::string& orderId) const;
+
+    // Forget an order the engine refused before it reached a shard; no
+    // result will ever arrive for it
+    void untrackOrder(const std::string& orderId);
+
+    void onOrderProcessed(const std::shared_ptr<OrderProcessingResult>& result);
+    void onTrade(const std::shared_ptr<Trade>& trade);
+
+    // Stop delivering reports (the sink may be destroyed afterwards)
+    void detach();
+
+    size_t getTrackedOrderCount() const;
+
+private:
+    struct TrackedOrder {
+        uint64_t sessionId;
+        uint64_t clientOrderId;
+        std::string symbol;
+        int leavesQuantity;
+    };
+
+    mutable std::mutex mutex;
+    ReportSink sink;
+    std::unordered_map<std::string, TrackedOrder> orders;
+
+    // Last report number per symbol. A symbol's reports all come from its
+    // shard thread, so numbering order is delivery order.
+    std::unordered_map<std::string, uint32_t> symbolSequences;
+
+    void deliver(const TrackedOrder& tracked, ExecutionReportType type, int lastQuantity, double lastPrice);
+    void applyFill(const std::string& orderId, int quantity, double price);
+};
+
+#endif // MATCHING_ENGINE_EXECUTIONREPORTROUTER_HPP
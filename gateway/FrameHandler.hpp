@@ -0,0 +1,20 @@
+#ifndef MATCHING_ENGINE_FRAMEHANDLER_HPP
+#define MATCHING_ENGINE_FRAMEHANDLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Receiver of the order entry frames a transport decodes. A transport owns
+// one handler and delivers the reports it produces to the right session.
+class FrameHandler {
+public:
+    virtual ~FrameHandler() = default;
+
+    // Apply one complete frame from a session; returns false on a protocol violation
+    virtual bool handleMessage(uint64_t sessionId, const char* data, size_t length) = 0;
+
+    // Called once when a session goes away
+    virtual void onSessionClosed(uint64_t sessionId) = 0;
+};
+
+#endif // MATCHING_ENGINE_FRAMEHANDLER_HPP
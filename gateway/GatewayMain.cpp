@@ -0,0 +1,143 @@
+#include "OrderGateway.hpp"
+#include "../engine/EngineStatsReporter.hpp"
+#include "../metrics/Tracer.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+// Standalone order gateway: a ContinuousMatchingEngine behind the TCP front end.
+//
+// Usage: order_gateway [--port N | --unix PATH] [--bind ADDR] [--threads N] [--io-threads N]
+//                      [--symbols AAPL,MSFT,...] [--stats-file PATH]
+//                      [--stats-interval-ms N] [--trace-file PATH]
+//                      [--trace-seconds N] [--pin-shards 0|1]
+//                      [--queue-capacity N] [--backpressure block|reject|shed]
+//
+// With --stats-file, engine statistics are appended as JSON lines every
+// --stats-interval-ms (default 1000).
+//
+// With --trace-file, SIGUSR1 writes the last --trace-seconds (default 10) of
+// worker activity there as Chrome trace JSON; the gateway keeps running.
+//
+// With --unix, order entry is served on a Unix domain socket instead of TCP,
+// which is how an order_router reaches the engine processes behind it.
+//
+// With --pin-shards 1, each engine worker is pinned to a CPU, spread across
+// NUMA nodes.
+//
+// With --queue-capacity, each engine shard queues at most N commands. When a
+// queue is full, --backpressure (default reject) decides what happens to new
+// commands. reject refuses them. shed refuses new orders and modifies but
+// still queues cancels. block makes the I/O thread wait.
+
+int main(int argc, char** argv) {
+    uint16_t port = 9000;
+    std::string bindAddress = "127.0.0.1";
+    std::string unixPath;
+    size_t numThreads = 4;
+    size_t numIoThreads = 1;
+    std::string symbolList = "AAPL,MSFT,GOOG,AMZN";
+    std::string statsFile;
+    int statsIntervalMs = 1000;
+    std::string traceFile;
+    double traceSeconds = 10.0;
+    bool pinShards = false;
+    size_t queueCapacity = 0;
+    BackpressurePolicy backpressure = BackpressurePolicy::REJECT;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--port") {
+            port = static_cast<uint16_t>(std::atoi(value.c_str()));
+        } else if (flag == "--bind") {
+            bindAddress = value;
+        } else if (flag == "--unix") {
+            unixPath = value;
+        } else if (flag == "--threads") {
+            numThreads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--io-threads") {
+            numIoThreads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--symbols") {
+            symbolList = value;
+        } else if (flag == "--stats-file") {
+            statsFile = value;
+        } else if (flag == "--stats-interval-ms") {
+            statsIntervalMs = std::max(1, std::atoi(value.c_str()));
+        } else if (flag == "--trace-file") {
+            traceFile = value;
+        } else if (flag == "--trace-seconds") {
+            traceSeconds = std::max(0.001, std::atof(value.c_str()));
+        } else if (flag == "--pin-shards") {
+            pinShards = std::atoi(value.c_str()) != 0;
+        } else if (flag == "--queue-capacity") {
+            queueCapacity = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--backpressure") {
+            if (value == "block") {
+                backpressure = BackpressurePolicy::BLOCK;
+            } else if (value == "reject") {
+                backpressure = BackpressurePolicy::REJECT;
+            } else if (value == "shed") {
+                backpressure = BackpressurePolicy::SHED_NEW_ORDERS;
+            } else {
+                std::cerr << "Unknown backpressure policy: " << value << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    // Block the shutdown and trace signals before any thread starts so only
+    // sigwait sees them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    if (!traceFile.empty()) {
+        sigaddset(&signals, SIGUSR1);
+    }
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    ContinuousMatchingEngine engine(numThreads);
+    engine.setPinShards(pinShards);
+    engine.setQueueCapacity(queueCapacity, backpressure);
+    std::stringstream symbols(symbolList);
+    std::string symbol;
+    while (std::getline(symbols, symbol, ',')) {
+        if (!symbol.empty()) {
+            engine.addSymbol(symbol);
+        }
+    }
+    engine.start();
+
+    EngineStatsReporter statsReporter(engine, statsFile, std::chrono::milliseconds(statsIntervalMs));
+    if (!statsFile.empty() && !statsReporter.start()) {
+        engine.stop();
+        return 1;
+    }
+
+    OrderGateway gateway(engine, numIoThreads);
+    bool listening = unixPath.empty() ? gateway.start(port, bindAddress) : gateway.startUnix(unixPath);
+    if (!listening) {
+        engine.stop();
+        return 1;
+    }
+
+    int received = 0;
+    while (sigwait(&signals, &received) == 0 && received == SIGUSR1) {
+        if (Tracer::dumpChromeTrace(traceFile, traceSeconds)) {
+            std::cout << "Wrote trace to " << traceFile << std::endl;
+        }
+    }
+    std::cout << "Received signal " << received << ", shutting down" << std::endl;
+
+    gateway.stop();
+    engine.stop();
+    statsReporter.stop();
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include "OrderGateway.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// Load generator for the order gateway.
+//
+// Opens many concurrent sessions, keeps one order in flight per session and
+// measures the round trip from writing a NewOrder until the first execution
+// report for it arrives. Orders alternate buy/sell at one price so the book
+// stays shallow while every other order trades.
+//
+// Usage: gateway_load_generator [--host ADDR] [--port N] [--sessions N]
+//                               [--orders N] [--symbols N]
+//                               [--self-host] [--threads N] [--io-threads N]
+//
+// With --self-host the generator starts its own engine and gateway on an
+// ephemeral loopback port.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ClientSession {
+    int fd = -1;
+    bool connected = false;
+    uint64_t nextClientOrderId = 1;
+    uint64_t outstandingId = 0;
+    int ordersSent = 0;
+    std::string symbol;
+    Clock::time_point sentAt;
+    std::vector<char> inBuffer;
+    size_t inBytes = 0;
+};
+
+struct Options {
+    std::string host = "127.0.0.1";
+    uint16_t port = 9000;
+    int sessions = 1000;
+    int ordersPerSession = 100;
+    int symbols = 4;
+    bool selfHost = false;
+    size_t threads = 4;
+    size_t ioThreads = 2;
+};
+
+std::string symbolName(int index) {
+    return "SYM" + std::to_string(index);
+}
+
+bool sendNextOrder(ClientSession& session) {
+    auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    message.clientOrderId = session.nextClientOrderId++;
+    encodeSymbol(session.symbol, message.symbol);
+    message.side = (message.clientOrderId % 2 == 0) ? WireSide::SELL : WireSide::BUY;
+    message.quantity = 1;
+    message.price = 100.0;
+
+    session.outstandingId = message.clientOrderId;
+    session.sentAt = Clock::now();
+    session.ordersSent++;
+
+    // A 36-byte frame always fits in an idle socket buffer
+    ssize_t sent = send(session.fd, &message, sizeof(message), MSG_NOSIGNAL);
+    return sent == static_cast<ssize_t>(sizeof(message));
+}
+
+double percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+int run(const Options& options) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "Invalid host: " << options.host << std::endl;
+        return 1;
+    }
+
+    int epollFd = epoll_create1(0);
+    std::vector<ClientSession> sessions(options.sessions);
+    std::vector<int64_t> latencies;
+    latencies.reserve(static_cast<size_t>(options.sessions) * options.ordersPerSession);
+
+    for (int i = 0; i < options.sessions; ++i) {
+        ClientSession& session = sessions[i];
+        session.symbol = symbolName(i % options.symbols);
+        session.inBuffer.resize(4096);
+        session.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (session.fd < 0) {
+            std::cerr << "Failed to create socket for session " << i << std::endl;
+            return 1;
+        }
+
+        int enable = 1;
+        setsockopt(session.fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        if (connect(session.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 && errno != EINPROGRESS) {
+            std::cerr << "Failed to connect session " << i << std::endl;
+            return 1;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.u32 = static_cast<uint32_t>(i);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, session.fd, &event);
+    }
+
+    int finishedSessions = 0;
+    auto start = Clock::now();
+    std::vector<epoll_event> events(1024);
+
+    while (finishedSessions < options.sessions) {
+        int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 5000);
+        if (count == 0) {
+            std::cerr << "Timed out waiting for execution reports" << std::endl;
+            break;
+        }
+
+        for (int e = 0; e < count; ++e) {
+            ClientSession& session = sessions[events[e].data.u32];
+            if (session.fd < 0) {
+                continue;
+            }
+
+            if (events[e].events & (EPOLLERR | EPOLLHUP)) {
+                std::cerr << "Session " << events[e].data.u32 << " disconnected" << std::endl;
+                close(session.fd);
+                session.fd = -1;
+                finishedSessions++;
+                continue;
+            }
+
+            if (!session.connected && (events[e].events & EPOLLOUT)) {
+                session.connected = true;
+                if (options.ordersPerSession > 0) {
+                    sendNextOrder(session);
+                }
+            }
+
+            if (!(events[e].events & EPOLLIN)) {
+                continue;
+            }
+
+            bool done = false;
+            while (!done) {
+                ssize_t received = recv(session.fd,
+                                        session.inBuffer.data() + session.inBytes,
+                                        session.inBuffer.size() - session.inBytes,
+                                        0);
+                if (received <= 0) {
+                    break;
+                }
+                session.inBytes += static_cast<size_t>(received);
+
+                size_t offset = 0;
+                while (session.inBytes - offset >= sizeof(ExecutionReportMessage)) {
+                    ExecutionReportMessage report;
+                    std::memcpy(&report, session.inBuffer.data() + offset, sizeof(report));
+                    offset += sizeof(report);
+
+                    if (report.clientOrderId != session.outstandingId) {
+                        continue; // later fills for earlier orders
+                    }
+
+                    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - session.sentAt).count());
+                    session.outstandingId = 0;
+
+                    if (session.ordersSent < options.ordersPerSession) {
+                        sendNextOrder(session);
+                    } else {
+                        finishedSessions++;
+                        done = true;
+                        break;
+                    }
+                }
+
+                std::memmove(session.inBuffer.data(), session.inBuffer.data() + offset, session.inBytes - offset);
+                session.inBytes -= offset;
+            }
+        }
+    }
+
+    double elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (auto& session : sessions) {
+        if (session.fd >= 0) {
+            close(session.fd);
+        }
+    }
+    close(epollFd);
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Sessions:        " << options.sessions << std::endl;
+    std::cout << "Orders:          " << latencies.size() << std::endl;
+    std::cout << "Elapsed:         " << elapsedSeconds << " s" << std::endl;
+    std::cout << "Throughput:      " << static_cast<double>(latencies.size()) / elapsedSeconds << " orders/s" << std::endl;
+    std::cout << "RTT p50:         " << percentile(latencies, 0.50) << " us" << std::endl;
+    std::cout << "RTT p90:         " << percentile(latencies, 0.90) << " us" << std::endl;
+    std::cout << "RTT p99:         " << percentile(latencies, 0.99) << " us" << std::endl;
+    std::cout << "RTT p99.9:       " << percentile(latencies, 0.999) << " us" << std::endl;
+    std::cout << "RTT max:         " << percentile(latencies, 1.0) << " us" << std::endl;
+
+    size_t expected = static_cast<size_t>(options.sessions) * options.ordersPerSession;
+    return latencies.size() == expected ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--self-host") {
+            options.selfHost = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--host") {
+            options.host = value;
+        } else if (flag == "--port") {
+            options.port = static_cast<uint16_t>(std::atoi(value.c_str()));
+        } else if (flag == "--sessions") {
+            options.sessions = std::atoi(value.c_str());
+        } else if (flag == "--orders") {
+            options.ordersPerSession = std::atoi(value.c_str());
+        } else if (flag == "--symbols") {
+            options.symbols = std::max(1, std::atoi(value.c_str()));
+        } else if (flag == "--threads") {
+            options.threads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--io-threads") {
+            options.ioThreads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    if (!options.selfHost) {
+        return run(options);
+    }
+
+    ContinuousMatchingEngine engine(options.threads);
+    for (int i = 0; i < options.symbols; ++i) {
+        engine.addSymbol(symbolName(i));
+    }
+    engine.start();
+
+    OrderGateway gateway(engine, options.ioThreads);
+    if (!gateway.start(0)) {
+        return 1;
+    }
+    options.host = "127.0.0.1";
+    options.port = gateway.getPort();
+
+    int status = run(options);
+
+    gateway.stop();
+    engine.stop();
+    return status;
+}
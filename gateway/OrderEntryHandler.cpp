@@ -0,0 +1,151 @@
+#include "OrderEntryHandler.hpp"
+#include <cmath>
+
+OrderEntryHandler::OrderEntryHandler(ContinuousMatchingEngine& engine, ExecutionReportRouter::ReportSink sink)
+    : engine(engine),
+      router(std::make_shared<ExecutionReportRouter>(sink)),
+      sink(std::move(sink)) {
+
+    // The engine keeps its callbacks for its whole lifetime, so they hold the
+    // router (not the handler) and go quiet once the router is detached
+    auto sharedRouter = router;
+    engine.registerOrderProcessingCallback([sharedRouter](std::shared_ptr<OrderProcessingResult> result) {
+        sharedRouter->onOrderProcessed(result);
+    });
+    engine.registerTradeCallback([sharedRouter](std::shared_ptr<Trade> trade) {
+        sharedRouter->onTrade(trade);
+    });
+}
+
+OrderEntryHandler::~OrderEntryHandler() {
+    router->detach();
+}
+
+bool OrderEntryHandler::handleMessage(uint64_t sessionId, const char* data, size_t length) {
+    if (length < sizeof(MessageHeader)) {
+        return false;
+    }
+
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    switch (header.type) {
+        case MessageType::NEW_ORDER: {
+            if (length != sizeof(NewOrderMessage)) {
+                return false;
+            }
+            NewOrderMessage message;
+            std::memcpy(&message, data, sizeof(message));
+            handleNewOrder(sessionId, message);
+            return true;
+        }
+        case MessageType::CANCEL_ORDER: {
+            if (length != sizeof(CancelOrderMessage)) {
+                return false;
+            }
+            CancelOrderMessage message;
+            std::memcpy(&message, data, sizeof(message));
+            handleCancelOrder(sessionId, message);
+            return true;
+        }
+        case MessageType::MODIFY_ORDER: {
+            if (length != sizeof(ModifyOrderMessage)) {
+                return false;
+            }
+            ModifyOrderMessage message;
+            std::memcpy(&message, data, sizeof(message));
+            handleModifyOrder(sessionId, message);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void OrderEntryHandler::onSessionClosed(uint64_t sessionId) {
+    if (engine.isRunning()) {
+        engine.massCancel(ExecutionReportRouter::makeOwnerId(sessionId));
+    }
+}
+
+size_t OrderEntryHandler::getTrackedOrderCount() const {
+    return router->getTrackedOrderCount();
+}
+
+void OrderEntryHandler::handleNewOrder(uint64_t sessionId, const NewOrderMessage& message) {
+    std::string symbol = decodeSymbol(message.symbol);
+
+    if (!engine.isRunning() || !engine.hasSymbol(symbol) ||
+        message.quantity <= 0 || !std::isfinite(message.price) || message.price < 0.0 ||
+        (message.side != WireSide::BUY && message.side != WireSide::SELL) ||
+        !isValidTimeInForce(message.timeInForce)) {
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::REJECTED);
+        return;
+    }
+
+    // A zero price is a market order, which is always immediate-only
+    bool isMarket = message.price == 0.0;
+    TimeInForce timeInForce = toTimeInForce(message.timeInForce);
+    if (isMarket && timeInForce != TimeInForce::FOK) {
+        timeInForce = TimeInForce::IOC;
+    }
+
+    auto order = std::make_shared<Order>(
+        ExecutionReportRouter::makeOrderId(sessionId, message.clientOrderId),
+        symbol,
+        toOrderSide(message.side),
+        message.price,
+        message.quantity,
+        isMarket ? OrderType::MARKET : OrderType::LIMIT,
+        timeInForce,
+        ExecutionReportRouter::makeOwnerId(sessionId)
+    );
+
+    if (!router->trackOrder(sessionId, message.clientOrderId, order)) {
+        // Client order id is still live on this session
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::REJECTED);
+        return;
+    }
+
+    if (!engine.submitOrder(order)) {
+        // Refused before reaching a shard (queue full), so no result follows
+        router->untrackOrder(order->getId());
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::REJECTED);
+    }
+}
+
+void OrderEntryHandler::handleCancelOrder(uint64_t sessionId, const CancelOrderMessage& message) {
+    std::string orderId = ExecutionReportRouter::makeOrderId(sessionId, message.clientOrderId);
+
+    if (!engine.isRunning() || !router->isTracked(orderId)) {
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::CANCEL_REJECTED);
+        return;
+    }
+
+    if (!engine.cancelOrder(orderId, decodeSymbol(message.symbol))) {
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::CANCEL_REJECTED);
+    }
+}
+
+void OrderEntryHandler::handleModifyOrder(uint64_t sessionId, const ModifyOrderMessage& message) {
+    std::string orderId = ExecutionReportRouter::makeOrderId(sessionId, message.clientOrderId);
+
+    if (!engine.isRunning() || !router->isTracked(orderId) ||
+        message.quantity <= 0 || !std::isfinite(message.price) || message.price <= 0.0) {
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::REPLACE_REJECTED);
+        return;
+    }
+
+    if (!engine.modifyOrder(orderId, decodeSymbol(message.symbol), message.price, message.quantity)) {
+        sendReject(sessionId, message.clientOrderId, message.symbol, ExecutionReportType::REPLACE_REJECTED);
+    }
+}
+
+void OrderEntryHandler::sendReject(uint64_t sessionId, uint64_t clientOrderId, const char (&symbol)[WIRE_SYMBOL_LENGTH], ExecutionReportType type) {
+    auto report = makeMessage<ExecutionReportMessage>(MessageType::EXECUTION_REPORT);
+    report.clientOrderId = clientOrderId;
+    std::memcpy(report.symbol, symbol, WIRE_SYMBOL_LENGTH);
+    report.reportType = type;
+
+    sink(sessionId, report);
+}
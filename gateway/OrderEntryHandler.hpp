@@ -0,0 +1,38 @@
+#ifndef MATCHING_ENGINE_ORDERENTRYHANDLER_HPP
+#define MATCHING_ENGINE_ORDERENTRYHANDLER_HPP
+
+#include "Protocol.hpp"
+#include "FrameHandler.hpp"
+#include "ExecutionReportRouter.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <memory>
+
+// Transport-independent half of order entry: decodes wire frames, applies
+// them to the engine and produces execution reports through the transport's
+// sink. Each transport (TCP, shared memory) owns one handler.
+class OrderEntryHandler : public FrameHandler {
+public:
+    OrderEntryHandler(ContinuousMatchingEngine& engine, ExecutionReportRouter::ReportSink sink);
+    ~OrderEntryHandler() override;
+
+    // Apply one complete frame from a session; returns false on a protocol violation
+    bool handleMessage(uint64_t sessionId, const char* data, size_t length) override;
+
+    // Cancel everything the session still has working; transports call
+    // this once when a session goes away
+    void onSessionClosed(uint64_t sessionId) override;
+
+    size_t getTrackedOrderCount() const;
+
+private:
+    ContinuousMatchingEngine& engine;
+    std::shared_ptr<ExecutionReportRouter> router;
+    ExecutionReportRouter::ReportSink sink;
+
+    void handleNewOrder(uint64_t sessionId, const NewOrderMessage& message);
+    void handleCancelOrder(uint64_t sessionId, const CancelOrderMessage& message);
+    void handleModifyOrder(uint64_t sessionId, const ModifyOrderMessage& message);
+    void sendReject(uint64_t sessionId, uint64_t clientOrderId, const char (&symbol)[WIRE_SYMBOL_LENGTH], ExecutionReportType type);
+};
+
+#endif // MATCHING_ENGINE_ORDERENTRYHANDLER_HPP
@@ -0,0 +1,446 @@
+#include "OrderGateway.hpp"
+#include "../logging/AsyncLogger.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int MAX_EVENTS = 256;
+constexpr size_t READ_CHUNK = 4096;
+
+constexpr size_t DEFAULT_MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+
+} // namespace
+
+OrderGateway::OrderGateway(ContinuousMatchingEngine& engine, size_t numIoThreads)
+    : OrderGateway([&engine](ExecutionReportRouter::ReportSink sink) -> std::unique_ptr<FrameHandler> {
+          return std::make_unique<OrderEntryHandler>(engine, std::move(sink));
+      }, numIoThreads) {
+}
+
+OrderGateway::OrderGateway(HandlerFactory makeHandler, size_t numIoThreads)
+    : numIoThreads(numIoThreads == 0 ? 1 : numIoThreads),
+      running(false),
+      listenFd(-1),
+      port(0),
+      nextSessionId(1),
+      nextIoThread(0),
+      maxPendingOutput(DEFAULT_MAX_PENDING_OUTPUT) {
+
+    entryHandler = makeHandler([this](uint64_t sessionId, const ExecutionReportMessage& report) {
+        sendReport(sessionId, report);
+    });
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+    entryHandler.reset();
+}
+
+bool OrderGateway::start(uint16_t requestedPort, const std::string& bindAddress) {
+    if (isRunning()) {
+        return false;
+    }
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listenFd < 0) {
+        std::cerr << "Gateway: failed to create socket" << std::endl;
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(requestedPort);
+    if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1 ||
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        std::cerr << "Gateway: failed to listen on " << bindAddress << ":" << requestedPort << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    socklen_t addressLength = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+    port = ntohs(address.sin_port);
+
+    return startIoThreads(bindAddress + ":" + std::to_string(port));
+}
+
+bool OrderGateway::startUnix(const std::string& path) {
+    if (isRunning()) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Gateway: socket path too long: " << path << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listenFd < 0) {
+        std::cerr << "Gateway: failed to create socket" << std::endl;
+        return false;
+    }
+
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        std::cerr << "Gateway: failed to listen on " << path << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    unixPath = path;
+    port = 0;
+    return startIoThreads(path);
+}
+
+bool OrderGateway::startIoThreads(const std::string& description) {
+    ioThreads.clear();
+    for (size_t i = 0; i < numIoThreads; ++i) {
+        auto ioThread = std::make_unique<IoThread>();
+        ioThread->epollFd = epoll_create1(0);
+        ioThread->wakeFd = eventfd(0, EFD_NONBLOCK);
+
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN | EPOLLET;
+        wakeEvent.data.ptr = ioThread.get();
+        epoll_ctl(ioThread->epollFd, EPOLL_CTL_ADD, ioThread->wakeFd, &wakeEvent);
+
+        ioThreads.push_back(std::move(ioThread));
+    }
+
+    // The first I/O thread also accepts connections
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN | EPOLLET;
+    listenEvent.data.ptr = nullptr;
+    epoll_ctl(ioThreads[0]->epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+
+    running.store(true);
+    for (size_t i = 0; i < numIoThreads; ++i) {
+        ioThreads[i]->thread = std::thread(&OrderGateway::ioLoop, this, i);
+    }
+
+    std::cout << "Order Gateway listening on " << description
+              << " with " << numIoThreads << " I/O threads" << std::endl;
+    return true;
+}
+
+void OrderGateway::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    running.store(false);
+
+    for (auto& ioThread : ioThreads) {
+        uint64_t one = 1;
+        ssize_t ignored = write(ioThread->wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    for (auto& ioThread : ioThreads) {
+        if (ioThread->thread.joinable()) {
+            ioThread->thread.join();
+        }
+    }
+
+    std::vector<std::shared_ptr<Session>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        for (auto& [id, session] : sessions) {
+            remaining.push_back(session);
+        }
+    }
+    for (auto& session : remaining) {
+        closeSession(*session);
+    }
+
+    for (auto& ioThread : ioThreads) {
+        close(ioThread->wakeFd);
+        close(ioThread->epollFd);
+    }
+    ioThreads.clear();
+
+    close(listenFd);
+    listenFd = -1;
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+        unixPath.clear();
+    }
+
+    std::cout << "Order Gateway stopped" << std::endl;
+}
+
+bool OrderGateway::isRunning() const {
+    return running.load();
+}
+
+uint16_t OrderGateway::getPort() const {
+    return port;
+}
+
+void OrderGateway::setMaxPendingOutput(size_t bytes) {
+    maxPendingOutput = bytes;
+}
+
+size_t OrderGateway::getSessionCount() const {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    return sessions.size();
+}
+
+void OrderGateway::ioLoop(size_t threadIndex) {
+    IoThread& ioThread = *ioThreads[threadIndex];
+    epoll_event events[MAX_EVENTS];
+
+    while (isRunning()) {
+        int count = epoll_wait(ioThread.epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Gateway: epoll_wait failed on I/O thread " << threadIndex << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            void* tag = events[i].data.ptr;
+
+            if (tag == nullptr) {
+                acceptConnections();
+                continue;
+            }
+
+            if (tag == &ioThread) {
+                uint64_t value;
+                while (read(ioThread.wakeFd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+
+            // Sessions stay in the session map until their own I/O thread
+            // closes them, so the pointer is valid for this event
+            auto* session = static_cast<Session*>(tag);
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeSession(*session);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                handleWritable(*session);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                handleReadable(*session);
+            }
+        }
+    }
+}
+
+void OrderGateway::acceptConnections() {
+    // Edge-triggered: drain the backlog until accept would block
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Gateway: accept failed" << std::endl;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        if (unixPath.empty()) {
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+
+        auto session = std::make_shared<Session>();
+        session->id = nextSessionId.fetch_add(1);
+        session->fd = fd;
+        session->ioThreadIndex = nextIoThread.fetch_add(1) % numIoThreads;
+        session->inBuffer.resize(READ_CHUNK);
+
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex);
+            sessions[session->id] = session;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = session.get();
+        if (epoll_ctl(ioThreads[session->ioThreadIndex]->epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            closeSession(*session);
+        }
+    }
+}
+
+void OrderGateway::handleReadable(Session& session) {
+    uint64_t sessionId = session.id;
+
+    while (true) {
+        if (session.inBuffer.size() - session.inBytes < MAX_MESSAGE_LENGTH) {
+            session.inBuffer.resize(session.inBuffer.size() * 2);
+        }
+
+        ssize_t received = recv(session.fd,
+                                session.inBuffer.data() + session.inBytes,
+                                session.inBuffer.size() - session.inBytes,
+                                0);
+        if (received == 0) {
+            closeSession(session);
+            return;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                closeSession(session);
+            }
+            return;
+        }
+
+        session.inBytes += static_cast<size_t>(received);
+
+        // Decode every complete frame in the buffer
+        size_t offset = 0;
+        while (session.inBytes - offset >= sizeof(MessageHeader)) {
+            MessageHeader header;
+            std::memcpy(&header, session.inBuffer.data() + offset, sizeof(header));
+            if (header.length < sizeof(MessageHeader) || header.length > MAX_MESSAGE_LENGTH) {
+                std::cerr << "Gateway: malformed frame from session " << sessionId << std::endl;
+                closeSession(session);
+                return;
+            }
+            if (session.inBytes - offset < header.length) {
+                break;
+            }
+            if (!entryHandler->handleMessage(sessionId, session.inBuffer.data() + offset, header.length)) {
+                std::cerr << "Gateway: protocol error from session " << sessionId << std::endl;
+                closeSession(session);
+                return;
+            }
+            offset += header.length;
+        }
+
+        if (offset > 0) {
+            std::memmove(session.inBuffer.data(), session.inBuffer.data() + offset, session.inBytes - offset);
+            session.inBytes -= offset;
+        }
+    }
+}
+
+void OrderGateway::handleWritable(Session& session) {
+    std::lock_guard<std::mutex> lock(session.outMutex);
+
+    while (session.fd >= 0 && session.outOffset < session.outBuffer.size()) {
+        ssize_t sent = send(session.fd,
+                            session.outBuffer.data() + session.outOffset,
+                            session.outBuffer.size() - session.outOffset,
+                            MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: the next EPOLLOUT edge resumes the flush
+            return;
+        }
+        session.outOffset += static_cast<size_t>(sent);
+    }
+
+    session.outBuffer.clear();
+    session.outOffset = 0;
+}
+
+void OrderGateway::closeSession(Session& session) {
+    uint64_t sessionId = session.id;
+
+    {
+        // Invalidate the fd under the output lock so shard threads never
+        // write into a descriptor number the kernel has already reused
+        std::lock_guard<std::mutex> lock(session.outMutex);
+        if (session.fd < 0) {
+            return;
+        }
+        if (!ioThreads.empty()) {
+            epoll_ctl(ioThreads[session.ioThreadIndex]->epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+        }
+        close(session.fd);
+        session.fd = -1;
+    }
+
+    if (entryHandler) {
+        entryHandler->onSessionClosed(sessionId);
+    }
+
+    // May destroy the session; nothing below touches it
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    sessions.erase(sessionId);
+}
+
+void OrderGateway::sendReport(uint64_t sessionId, const ExecutionReportMessage& report) {
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        auto it = sessions.find(sessionId);
+        if (it == sessions.end()) {
+            return;
+        }
+        session = it->second;
+    }
+
+    sendBytes(*session, reinterpret_cast<const char*>(&report), sizeof(report));
+}
+
+void OrderGateway::sendBytes(Session& session, const char* data, size_t length) {
+    std::lock_guard<std::mutex> lock(session.outMutex);
+    if (session.fd < 0 || session.overflowed) {
+        return;
+    }
+
+    // Write straight to the socket unless earlier bytes are still queued
+    size_t written = 0;
+    if (session.outOffset == session.outBuffer.size()) {
+        while (written < length) {
+            ssize_t sent = send(session.fd, data + written, length - written, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            written += static_cast<size_t>(sent);
+        }
+    }
+
+    if (written < length) {
+        if (session.outBuffer.size() - session.outOffset + length - written > maxPendingOutput) {
+            // Only the session's I/O thread may close it; the shutdown wakes
+            // that thread with a hangup
+            LOG_ERROR("Gateway: session {} stopped reading; closing it", session.id);
+            session.overflowed = true;
+            session.outBuffer.clear();
+            session.outOffset = 0;
+            shutdown(session.fd, SHUT_RDWR);
+            return;
+        }
+        // The I/O thread flushes the rest on the next EPOLLOUT edge
+        session.outBuffer.insert(session.outBuffer.end(), data + written, data + length);
+    }
+}
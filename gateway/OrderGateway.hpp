@@ -0,0 +1,97 @@
+#ifndef MATCHING_ENGINE_ORDERGATEWAY_HPP
+#define MATCHING_ENGINE_ORDERGATEWAY_HPP
+
+#include "Protocol.hpp"
+#include "OrderEntryHandler.hpp"
+#include "FrameHandler.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// TCP front end for a ContinuousMatchingEngine.
+//
+// Sessions are spread round-robin over a fixed set of I/O threads, each
+// running a non-blocking, edge-triggered epoll loop. Decoded orders are
+// handed straight to the engine (which routes them to the symbol's shard
+// queue) and execution reports are written back to the owning session from
+// the shard thread, falling back to the I/O thread when the socket is full.
+//
+// The same front end serves any FrameHandler, such as a PartitionRouter.
+class OrderGateway {
+public:
+    // Builds the handler given the sink that writes reports to sessions
+    using HandlerFactory = std::function<std::unique_ptr<FrameHandler>(ExecutionReportRouter::ReportSink)>;
+
+    OrderGateway(ContinuousMatchingEngine& engine, size_t numIoThreads = 1);
+    OrderGateway(HandlerFactory makeHandler, size_t numIoThreads = 1);
+    ~OrderGateway();
+
+    // Listen on the given address; port 0 picks an ephemeral port
+    bool start(uint16_t port = 0, const std::string& bindAddress = "127.0.0.1");
+
+    // Listen on a Unix domain socket, replacing any stale socket file
+    bool startUnix(const std::string& path);
+    void stop();
+    bool isRunning() const;
+
+    uint16_t getPort() const;
+    size_t getSessionCount() const;
+
+    // Most report bytes queued for a session that is not reading; past it
+    // the session is closed. Defaults to 4 MB. Must be set before start().
+    void setMaxPendingOutput(size_t bytes);
+
+private:
+    struct Session {
+        uint64_t id;
+        int fd;
+        size_t ioThreadIndex;
+        std::vector<char> inBuffer;
+        size_t inBytes = 0;
+
+        // Guarded by outMutex; shard threads write reports concurrently
+        std::mutex outMutex;
+        std::vector<char> outBuffer;
+        size_t outOffset = 0;
+        bool overflowed = false;  // output cap hit; reports are dropped until close
+    };
+
+    struct IoThread {
+        int epollFd = -1;
+        int wakeFd = -1;
+        std::thread thread;
+    };
+
+    size_t numIoThreads;
+    std::vector<std::unique_ptr<IoThread>> ioThreads;
+    std::atomic<bool> running;
+    int listenFd;
+    uint16_t port;
+    std::string unixPath;  // empty when listening on TCP
+    std::atomic<uint64_t> nextSessionId;
+    std::atomic<size_t> nextIoThread;
+    size_t maxPendingOutput;
+
+    mutable std::mutex sessionsMutex;
+    std::unordered_map<uint64_t, std::shared_ptr<Session>> sessions;
+
+    std::unique_ptr<FrameHandler> entryHandler;
+
+    bool startIoThreads(const std::string& description);
+    void ioLoop(size_t threadIndex);
+    void acceptConnections();
+    void handleReadable(Session& session);
+    void handleWritable(Session& session);
+    void closeSession(Session& session);
+
+    void sendReport(uint64_t sessionId, const ExecutionReportMessage& report);
+    void sendBytes(Session& session, const char* data, size_t length);
+};
+
+#endif // MATCHING_ENGINE_ORDERGATEWAY_HPP
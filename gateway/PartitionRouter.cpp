@@ -0,0 +1,466 @@
+#include "PartitionRouter.hpp"
+#include "../logging/AsyncLogger.hpp"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int MAX_EVENTS = 64;
+constexpr size_t READ_CHUNK = 4096;
+
+// Most bytes buffered for one engine session before frames are rejected
+constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+
+constexpr uint32_t UPSTREAM_EVENTS = EPOLLIN | EPOLLRDHUP;
+
+// Tag of the wake eventfd; upstream ids start at 1
+constexpr uint64_t WAKE_TAG = 0;
+
+int connectUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // A Unix socket connects at once or fails with EAGAIN when the engine's
+    // backlog is full, so this never blocks the caller
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+size_t expectedLength(MessageType type) {
+    switch (type) {
+        case MessageType::NEW_ORDER:
+            return sizeof(NewOrderMessage);
+        case MessageType::CANCEL_ORDER:
+            return sizeof(CancelOrderMessage);
+        case MessageType::MODIFY_ORDER:
+            return sizeof(ModifyOrderMessage);
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+PartitionRouter::PartitionRouter(std::vector<std::string> enginePaths, ExecutionReportRouter::ReportSink sink)
+    : enginePaths(std::move(enginePaths)),
+      sink(std::move(sink)),
+      nextUpstreamId(1),
+      epollFd(epoll_create1(0)),
+      wakeFd(eventfd(0, EFD_NONBLOCK)),
+      running(true) {
+
+    epoll_event wakeEvent{};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.u64 = WAKE_TAG;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent);
+
+    reader = std::thread(&PartitionRouter::readLoop, this);
+}
+
+PartitionRouter::~PartitionRouter() {
+    running.store(false);
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+    if (reader.joinable()) {
+        reader.join();
+    }
+
+    std::vector<std::shared_ptr<Upstream>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [key, upstream] : upstreams) {
+            remaining.push_back(upstream);
+        }
+    }
+    for (auto& upstream : remaining) {
+        closeUpstream(upstream);
+    }
+
+    close(wakeFd);
+    close(epollFd);
+}
+
+bool PartitionRouter::assignSymbol(const std::string& symbol, size_t engineIndex) {
+    if (engineIndex >= enginePaths.size()) {
+        LOG_ERROR("Router: no engine {} for {}", engineIndex, symbol);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    partition[symbol] = engineIndex;
+    return true;
+}
+
+size_t PartitionRouter::getEngineForSymbol(const std::string& symbol) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = partition.find(symbol);
+        if (it != partition.end()) {
+            return it->second;
+        }
+    }
+
+    // Same hash as shard assignment, so the static split is stable across builds
+    size_t hashValue = 0;
+    for (char c : symbol) {
+        hashValue = hashValue * 31 + c;
+    }
+    return hashValue % enginePaths.size();
+}
+
+size_t PartitionRouter::getEngineCount() const {
+    return enginePaths.size();
+}
+
+size_t PartitionRouter::getUpstreamCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return upstreams.size();
+}
+
+bool PartitionRouter::handleMessage(uint64_t sessionId, const char* data, size_t length) {
+    if (length < sizeof(MessageHeader) || enginePaths.empty()) {
+        return false;
+    }
+
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (length != expectedLength(header.type)) {
+        return false;
+    }
+
+    char symbol[WIRE_SYMBOL_LENGTH];
+    std::memcpy(symbol, data + ENTRY_SYMBOL_OFFSET, WIRE_SYMBOL_LENGTH);
+    auto upstream = getUpstream(sessionId, getEngineForSymbol(decodeSymbol(symbol)));
+
+    if (!upstream || !forward(*upstream, data, length, header.type)) {
+        sendReject(sessionId, data, header.type);
+    }
+    return true;
+}
+
+void PartitionRouter::onSessionClosed(uint64_t sessionId) {
+    std::vector<std::shared_ptr<Upstream>> closing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = upstreams.lower_bound({sessionId, 0}); it != upstreams.end() && it->first.first == sessionId; ++it) {
+            closing.push_back(it->second);
+        }
+    }
+
+    // The engines see their sessions close and cancel what was left working
+    for (auto& upstream : closing) {
+        closeUpstream(upstream);
+    }
+}
+
+std::shared_ptr<PartitionRouter::Upstream> PartitionRouter::getUpstream(uint64_t sessionId, size_t engineIndex) {
+    auto key = std::make_pair(sessionId, engineIndex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = upstreams.find(key);
+        if (it != upstreams.end()) {
+            return it->second;
+        }
+    }
+
+    // Connect outside the lock so other sessions are never held up by it
+    int fd = connectUnix(enginePaths[engineIndex]);
+    if (fd < 0) {
+        LOG_ERROR("Router: cannot reach engine {} at {}", engineIndex, enginePaths[engineIndex]);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = upstreams.find(key);
+    if (it != upstreams.end()) {
+        close(fd);
+        return it->second;
+    }
+
+    auto upstream = std::make_shared<Upstream>();
+    upstream->id = nextUpstreamId++;
+    upstream->sessionId = sessionId;
+    upstream->engineIndex = engineIndex;
+    upstream->fd = fd;
+    upstream->inBuffer.resize(READ_CHUNK);
+
+    epoll_event event{};
+    event.events = UPSTREAM_EVENTS;
+    event.data.u64 = upstream->id;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    upstreams[key] = upstream;
+    upstreamsById[upstream->id] = upstream;
+    return upstream;
+}
+
+bool PartitionRouter::forward(Upstream& upstream, const char* data, size_t length, MessageType type) {
+    std::lock_guard<std::mutex> lock(upstream.fdMutex);
+    if (upstream.fd < 0) {
+        return false;
+    }
+
+    // Write straight to the socket unless earlier bytes are still queued
+    size_t written = 0;
+    bool queued = upstream.outOffset < upstream.outBuffer.size();
+    if (!queued) {
+        while (written < length) {
+            ssize_t sent = send(upstream.fd, data + written, length - written, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    return false;
+                }
+                break;
+            }
+            written += static_cast<size_t>(sent);
+        }
+    }
+
+    if (written < length) {
+        // Only whole frames are refused, so the stream stays in frame order
+        if (written == 0 && upstream.outBuffer.size() - upstream.outOffset + length > MAX_PENDING_OUTPUT) {
+            LOG_ERROR("Router: engine {} is not reading session {}", upstream.engineIndex, upstream.sessionId);
+            return false;
+        }
+        upstream.outBuffer.insert(upstream.outBuffer.end(), data + written, data + length);
+        if (!queued) {
+            // The reader thread flushes the rest once the socket has room
+            epoll_event event{};
+            event.events = UPSTREAM_EVENTS | EPOLLOUT;
+            event.data.u64 = upstream.id;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, upstream.fd, &event);
+        }
+    }
+
+    if (type == MessageType::NEW_ORDER) {
+        uint64_t clientOrderId;
+        std::memcpy(&clientOrderId, data + sizeof(MessageHeader), sizeof(clientOrderId));
+        WorkingOrder& working = upstream.workingOrders[clientOrderId];
+        std::memcpy(working.symbol, data + ENTRY_SYMBOL_OFFSET, WIRE_SYMBOL_LENGTH);
+        ++working.pendingFrames;
+    }
+    return true;
+}
+
+void PartitionRouter::flushOutput(Upstream& upstream) {
+    std::lock_guard<std::mutex> lock(upstream.fdMutex);
+    if (upstream.fd < 0) {
+        return;
+    }
+
+    while (upstream.outOffset < upstream.outBuffer.size()) {
+        ssize_t sent = send(upstream.fd,
+                            upstream.outBuffer.data() + upstream.outOffset,
+                            upstream.outBuffer.size() - upstream.outOffset,
+                            MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            // The read side sees the error and drops the session
+            break;
+        }
+        upstream.outOffset += static_cast<size_t>(sent);
+    }
+
+    upstream.outBuffer.clear();
+    upstream.outOffset = 0;
+    epoll_event event{};
+    event.events = UPSTREAM_EVENTS;
+    event.data.u64 = upstream.id;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, upstream.fd, &event);
+}
+
+void PartitionRouter::closeUpstream(const std::shared_ptr<Upstream>& upstream) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        upstreams.erase({upstream->sessionId, upstream->engineIndex});
+        upstreamsById.erase(upstream->id);
+    }
+
+    std::lock_guard<std::mutex> lock(upstream->fdMutex);
+    if (upstream->fd >= 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, upstream->fd, nullptr);
+        close(upstream->fd);
+        upstream->fd = -1;
+    }
+}
+
+void PartitionRouter::dropUpstream(const std::shared_ptr<Upstream>& upstream) {
+    closeUpstream(upstream);
+
+    // The engine session is gone and its orders with it; tell the client
+    std::unordered_map<uint64_t, WorkingOrder> orphaned;
+    {
+        std::lock_guard<std::mutex> lock(upstream->fdMutex);
+        orphaned.swap(upstream->workingOrders);
+    }
+    for (const auto& [clientOrderId, working] : orphaned) {
+        auto report = makeMessage<ExecutionReportMessage>(MessageType::EXECUTION_REPORT);
+        report.clientOrderId = clientOrderId;
+        std::memcpy(report.symbol, working.symbol, WIRE_SYMBOL_LENGTH);
+        report.reportType = ExecutionReportType::CANCELLED;
+        sink(upstream->sessionId, report);
+    }
+}
+
+void PartitionRouter::readLoop() {
+    epoll_event events[MAX_EVENTS];
+
+    while (running.load()) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("Router: epoll_wait failed");
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            uint64_t tag = events[i].data.u64;
+            if (tag == WAKE_TAG) {
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+
+            std::shared_ptr<Upstream> upstream;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = upstreamsById.find(tag);
+                if (it == upstreamsById.end()) {
+                    continue;
+                }
+                upstream = it->second;
+            }
+            if (events[i].events & EPOLLOUT) {
+                flushOutput(*upstream);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                readReports(upstream);
+            }
+        }
+    }
+}
+
+void PartitionRouter::readReports(const std::shared_ptr<Upstream>& upstream) {
+    while (true) {
+        if (upstream->inBuffer.size() - upstream->inBytes < MAX_MESSAGE_LENGTH) {
+            upstream->inBuffer.resize(upstream->inBuffer.size() * 2);
+        }
+
+        ssize_t received;
+        {
+            std::lock_guard<std::mutex> lock(upstream->fdMutex);
+            if (upstream->fd < 0) {
+                return;
+            }
+            received = recv(upstream->fd,
+                            upstream->inBuffer.data() + upstream->inBytes,
+                            upstream->inBuffer.size() - upstream->inBytes,
+                            MSG_DONTWAIT);
+        }
+
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (received <= 0) {
+            // The engine went away; the client's next order on it reconnects
+            LOG_ERROR("Router: engine {} closed session {}", upstream->engineIndex, upstream->sessionId);
+            dropUpstream(upstream);
+            return;
+        }
+
+        upstream->inBytes += static_cast<size_t>(received);
+
+        size_t offset = 0;
+        while (upstream->inBytes - offset >= sizeof(MessageHeader)) {
+            MessageHeader header;
+            std::memcpy(&header, upstream->inBuffer.data() + offset, sizeof(header));
+            if (header.type != MessageType::EXECUTION_REPORT || header.length != sizeof(ExecutionReportMessage)) {
+                LOG_ERROR("Router: malformed report from engine {}", upstream->engineIndex);
+                dropUpstream(upstream);
+                return;
+            }
+            if (upstream->inBytes - offset < header.length) {
+                break;
+            }
+
+            ExecutionReportMessage report;
+            std::memcpy(&report, upstream->inBuffer.data() + offset, sizeof(report));
+            trackReport(*upstream, report);
+            sink(upstream->sessionId, report);
+            offset += header.length;
+        }
+
+        if (offset > 0) {
+            std::memmove(upstream->inBuffer.data(), upstream->inBuffer.data() + offset, upstream->inBytes - offset);
+            upstream->inBytes -= offset;
+        }
+    }
+}
+
+void PartitionRouter::trackReport(Upstream& upstream, const ExecutionReportMessage& report) {
+    if (report.reportType != ExecutionReportType::FILL &&
+        report.reportType != ExecutionReportType::CANCELLED &&
+        report.reportType != ExecutionReportType::REJECTED) {
+        return;
+    }
+
+    // Copied out: the packed field may not be aligned for a reference
+    uint64_t clientOrderId = report.clientOrderId;
+    std::lock_guard<std::mutex> lock(upstream.fdMutex);
+    auto it = upstream.workingOrders.find(clientOrderId);
+    if (it != upstream.workingOrders.end() && --it->second.pendingFrames == 0) {
+        upstream.workingOrders.erase(it);
+    }
+}
+
+void PartitionRouter::sendReject(uint64_t sessionId, const char* data, MessageType type) {
+    auto report = makeMessage<ExecutionReportMessage>(MessageType::EXECUTION_REPORT);
+    std::memcpy(&report.clientOrderId, data + sizeof(MessageHeader), sizeof(report.clientOrderId));
+    std::memcpy(report.symbol, data + ENTRY_SYMBOL_OFFSET, WIRE_SYMBOL_LENGTH);
+    switch (type) {
+        case MessageType::CANCEL_ORDER:
+            report.reportType = ExecutionReportType::CANCEL_REJECTED;
+            break;
+        case MessageType::MODIFY_ORDER:
+            report.reportType = ExecutionReportType::REPLACE_REJECTED;
+            break;
+        default:
+            report.reportType = ExecutionReportType::REJECTED;
+            break;
+    }
+
+    sink(sessionId, report);
+}
@@ -0,0 +1,98 @@
+#ifndef MATCHING_ENGINE_PARTITIONROUTER_HPP
+#define MATCHING_ENGINE_PARTITIONROUTER_HPP
+
+#include "FrameHandler.hpp"
+#include "ExecutionReportRouter.hpp"
+#include "Protocol.hpp"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Splits the symbol universe across several engine processes, each serving
+// order entry on a Unix domain socket (order_gateway --unix PATH).
+//
+// Every client session gets its own session on each engine it trades on,
+// opened on first use. A symbol lives on exactly one engine and each of
+// those connections is a FIFO stream, so the reports merged back onto the
+// client's stream keep each symbol's sequence order. Closing the client
+// session closes its engine sessions, which cancels its orders there.
+//
+// Engine sockets are non-blocking: frames an engine has no room for are
+// buffered and flushed by the reader thread. If an engine drops a session,
+// the client gets a CANCELLED report for each order still working there.
+class PartitionRouter : public FrameHandler {
+public:
+    PartitionRouter(std::vector<std::string> enginePaths, ExecutionReportRouter::ReportSink sink);
+    ~PartitionRouter() override;
+
+    // Route `symbol` to one engine; symbols without an assignment are hashed
+    bool assignSymbol(const std::string& symbol, size_t engineIndex);
+    size_t getEngineForSymbol(const std::string& symbol) const;
+
+    bool handleMessage(uint64_t sessionId, const char* data, size_t length) override;
+    void onSessionClosed(uint64_t sessionId) override;
+
+    size_t getEngineCount() const;
+
+    // Open engine sessions across all client sessions
+    size_t getUpstreamCount() const;
+
+private:
+    struct WorkingOrder {
+        char symbol[WIRE_SYMBOL_LENGTH];
+        uint32_t pendingFrames;  // NEW_ORDER frames still awaiting a final report
+    };
+
+    struct Upstream {
+        uint64_t id;
+        uint64_t sessionId;
+        size_t engineIndex;
+
+        // Guarded by fdMutex; closing invalidates it for senders and the reader
+        std::mutex fdMutex;
+        int fd = -1;
+
+        // Guarded by fdMutex; bytes the socket had no room for
+        std::vector<char> outBuffer;
+        size_t outOffset = 0;
+
+        // Guarded by fdMutex; client orders working on this engine
+        std::unordered_map<uint64_t, WorkingOrder> workingOrders;
+
+        // Touched only by the reader thread
+        std::vector<char> inBuffer;
+        size_t inBytes = 0;
+    };
+
+    std::vector<std::string> enginePaths;
+    ExecutionReportRouter::ReportSink sink;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, size_t> partition;
+    std::map<std::pair<uint64_t, size_t>, std::shared_ptr<Upstream>> upstreams;
+    std::unordered_map<uint64_t, std::shared_ptr<Upstream>> upstreamsById;
+    uint64_t nextUpstreamId;
+
+    int epollFd;
+    int wakeFd;
+    std::atomic<bool> running;
+    std::thread reader;
+
+    std::shared_ptr<Upstream> getUpstream(uint64_t sessionId, size_t engineIndex);
+    bool forward(Upstream& upstream, const char* data, size_t length, MessageType type);
+    void flushOutput(Upstream& upstream);
+    void closeUpstream(const std::shared_ptr<Upstream>& upstream);
+    void dropUpstream(const std::shared_ptr<Upstream>& upstream);
+    void readLoop();
+    void readReports(const std::shared_ptr<Upstream>& upstream);
+    static void trackReport(Upstream& upstream, const ExecutionReportMessage& report);
+    void sendReject(uint64_t sessionId, const char* data, MessageType type);
+};
+
+#endif // MATCHING_ENGINE_PARTITIONROUTER_HPP
@@ -0,0 +1,159 @@
+#ifndef MATCHING_ENGINE_PROTOCOL_HPP
+#define MATCHING_ENGINE_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "../order/Order.hpp"
+
+// Binary wire protocol shared by the order entry transports.
+//
+// Every message starts with a MessageHeader whose length covers the whole
+// frame (header included). Fields are packed and sent in host byte order;
+// the gateway only ever talks to clients on the same architecture.
+
+enum class MessageType : uint8_t {
+    NEW_ORDER = 1,
+    CANCEL_ORDER = 2,
+    EXECUTION_REPORT = 3,
+    MODIFY_ORDER = 4
+};
+
+enum class WireSide : uint8_t {
+    BUY = 1,
+    SELL = 2
+};
+
+// Zero is GTC so clients that leave the field cleared keep the old behaviour
+enum class WireTimeInForce : uint8_t {
+    GTC = 0,
+    DAY = 1,
+    IOC = 2,
+    FOK = 3
+};
+
+enum class ExecutionReportType : uint8_t {
+    NEW = 1,
+    PARTIAL_FILL = 2,
+    FILL = 3,
+    CANCELLED = 4,
+    REJECTED = 5,
+    CANCEL_REJECTED = 6,
+    REPLACED = 7,
+    REPLACE_REJECTED = 8
+};
+
+constexpr size_t WIRE_SYMBOL_LENGTH = 8;
+
+#pragma pack(push, 1)
+
+struct MessageHeader {
+    uint16_t length;
+    MessageType type;
+    uint8_t reserved;
+};
+
+struct NewOrderMessage {
+    MessageHeader header;
+    uint64_t clientOrderId;
+    char symbol[WIRE_SYMBOL_LENGTH];
+    WireSide side;
+    WireTimeInForce timeInForce;
+    uint8_t reserved[2];
+    int32_t quantity;
+    double price; // 0.0 for market orders
+};
+
+struct CancelOrderMessage {
+    MessageHeader header;
+    uint64_t clientOrderId;
+    char symbol[WIRE_SYMBOL_LENGTH];
+};
+
+// Cancel/replace a resting order; quantity is the new total, fills so far
+// not included
+struct ModifyOrderMessage {
+    MessageHeader header;
+    uint64_t clientOrderId;
+    char symbol[WIRE_SYMBOL_LENGTH];
+    int32_t quantity;
+    int32_t reserved;
+    double price;
+};
+
+struct ExecutionReportMessage {
+    MessageHeader header;
+    uint64_t clientOrderId;
+    char symbol[WIRE_SYMBOL_LENGTH];
+    ExecutionReportType reportType;
+    uint8_t reserved[3];
+    int32_t lastQuantity;
+    int32_t leavesQuantity;
+    uint32_t sequence;  // per-symbol report number, 0 if the order never reached the engine
+    double lastPrice;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(MessageHeader) == 4, "MessageHeader must be 4 bytes");
+static_assert(sizeof(NewOrderMessage) == 36, "NewOrderMessage layout changed");
+static_assert(sizeof(CancelOrderMessage) == 20, "CancelOrderMessage layout changed");
+static_assert(sizeof(ModifyOrderMessage) == 36, "ModifyOrderMessage layout changed");
+static_assert(sizeof(ExecutionReportMessage) == 44, "ExecutionReportMessage layout changed");
+
+// Every order entry message carries its symbol at the same offset, so a
+// router can pick the destination without decoding the whole frame
+constexpr size_t ENTRY_SYMBOL_OFFSET = sizeof(MessageHeader) + sizeof(uint64_t);
+static_assert(offsetof(NewOrderMessage, symbol) == ENTRY_SYMBOL_OFFSET, "NewOrderMessage symbol moved");
+static_assert(offsetof(CancelOrderMessage, symbol) == ENTRY_SYMBOL_OFFSET, "CancelOrderMessage symbol moved");
+static_assert(offsetof(ModifyOrderMessage, symbol) == ENTRY_SYMBOL_OFFSET, "ModifyOrderMessage symbol moved");
+
+// Largest frame any transport has to buffer
+constexpr size_t MAX_MESSAGE_LENGTH = sizeof(ExecutionReportMessage);
+
+inline void encodeSymbol(const std::string& symbol, char (&out)[WIRE_SYMBOL_LENGTH]) {
+    std::memset(out, 0, WIRE_SYMBOL_LENGTH);
+    std::memcpy(out, symbol.data(), std::min(symbol.size(), WIRE_SYMBOL_LENGTH));
+}
+
+inline std::string decodeSymbol(const char (&symbol)[WIRE_SYMBOL_LENGTH]) {
+    return std::string(symbol, strnlen(symbol, WIRE_SYMBOL_LENGTH));
+}
+
+inline OrderSide toOrderSide(WireSide side) {
+    return side == WireSide::BUY ? OrderSide::BUY : OrderSide::SELL;
+}
+
+inline WireSide toWireSide(OrderSide side) {
+    return side == OrderSide::BUY ? WireSide::BUY : WireSide::SELL;
+}
+
+inline bool isValidTimeInForce(WireTimeInForce timeInForce) {
+    return static_cast<uint8_t>(timeInForce) <= static_cast<uint8_t>(WireTimeInForce::FOK);
+}
+
+inline TimeInForce toTimeInForce(WireTimeInForce timeInForce) {
+    switch (timeInForce) {
+        case WireTimeInForce::DAY:
+            return TimeInForce::DAY;
+        case WireTimeInForce::IOC:
+            return TimeInForce::IOC;
+        case WireTimeInForce::FOK:
+            return TimeInForce::FOK;
+        default:
+            return TimeInForce::GTC;
+    }
+}
+
+template <typename Message>
+Message makeMessage(MessageType type) {
+    Message message;
+    std::memset(&message, 0, sizeof(message));
+    message.header.length = static_cast<uint16_t>(sizeof(Message));
+    message.header.type = type;
+    return message;
+}
+
+#endif // MATCHING_ENGINE_PROTOCOL_HPP
@@ -0,0 +1,88 @@
+#include "OrderGateway.hpp"
+#include "PartitionRouter.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+// Order router: a TCP front end that splits symbols across several engine
+// processes, each started as `order_gateway --unix PATH --symbols ...`.
+//
+// Usage: order_router --engines PATH,PATH,... [--port N] [--bind ADDR]
+//                     [--io-threads N] [--partition SYM:ENGINE,...]
+//
+// Symbols named in --partition go to the given engine (an index into
+// --engines); every other symbol is hashed across the engines.
+
+int main(int argc, char** argv) {
+    uint16_t port = 9000;
+    std::string bindAddress = "127.0.0.1";
+    size_t numIoThreads = 1;
+    std::string engineList;
+    std::string partitionList;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--port") {
+            port = static_cast<uint16_t>(std::atoi(value.c_str()));
+        } else if (flag == "--bind") {
+            bindAddress = value;
+        } else if (flag == "--io-threads") {
+            numIoThreads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--engines") {
+            engineList = value;
+        } else if (flag == "--partition") {
+            partitionList = value;
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::string> enginePaths;
+    std::stringstream engines(engineList);
+    std::string path;
+    while (std::getline(engines, path, ',')) {
+        if (!path.empty()) {
+            enginePaths.push_back(path);
+        }
+    }
+    if (enginePaths.empty()) {
+        std::cerr << "order_router needs --engines PATH[,PATH...]" << std::endl;
+        return 1;
+    }
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    bool partitionValid = true;
+    OrderGateway gateway([&](ExecutionReportRouter::ReportSink sink) -> std::unique_ptr<FrameHandler> {
+        auto router = std::make_unique<PartitionRouter>(enginePaths, std::move(sink));
+        std::stringstream assignments(partitionList);
+        std::string assignment;
+        while (std::getline(assignments, assignment, ',')) {
+            auto colon = assignment.find(':');
+            if (colon == std::string::npos ||
+                !router->assignSymbol(assignment.substr(0, colon), std::strtoul(assignment.c_str() + colon + 1, nullptr, 10))) {
+                std::cerr << "Invalid partition entry: " << assignment << std::endl;
+                partitionValid = false;
+            }
+        }
+        return router;
+    }, numIoThreads);
+
+    if (!partitionValid || !gateway.start(port, bindAddress)) {
+        return 1;
+    }
+
+    int received = 0;
+    sigwait(&signals, &received);
+    std::cout << "Received signal " << received << ", shutting down" << std::endl;
+
+    gateway.stop();
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "SharedMemoryClient.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+SharedMemoryClient::SharedMemoryClient()
+    : region(nullptr), regionSize(0), slotIndex(0), sessionId(0), connected(false) {
+}
+
+SharedMemoryClient::~SharedMemoryClient() {
+    disconnect();
+}
+
+bool SharedMemoryClient::connect(const std::string& name, std::chrono::milliseconds timeout) {
+    if (connected) {
+        return false;
+    }
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedRegionHeader)) {
+        close(fd);
+        return false;
+    }
+
+    regionSize = static_cast<size_t>(info.st_size);
+    region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        region = nullptr;
+        return false;
+    }
+
+    auto* header = static_cast<SharedRegionHeader*>(region);
+    if (header->magic != SHARED_REGION_MAGIC ||
+        header->version != SHARED_REGION_VERSION ||
+        header->serverAlive.load(std::memory_order_acquire) == 0 ||
+        regionSize < SharedMemoryLayout::regionSize(header->maxClients, header->ringCapacity)) {
+        unmap();
+        return false;
+    }
+
+    // Claim the first free slot
+    ClientSlotHeader* slot = nullptr;
+    for (uint32_t i = 0; i < header->maxClients; ++i) {
+        ClientSlotHeader* candidate = SharedMemoryLayout::slotHeader(region, i);
+        SlotState expected = SlotState::FREE;
+        if (candidate->state.compare_exchange_strong(expected, SlotState::CLAIMING, std::memory_order_acq_rel)) {
+            slot = candidate;
+            slotIndex = i;
+            break;
+        }
+    }
+    if (slot == nullptr) {
+        unmap();
+        return false;
+    }
+    // The server only looks at the slot once it is CLAIMED, so the reaper
+    // never sees the previous occupant's pid
+    slot->clientPid.store(getpid(), std::memory_order_relaxed);
+    slot->state.store(SlotState::CLAIMED, std::memory_order_release);
+
+    // Wait for the engine to reset the rings and hand out a session id
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (slot->state.load(std::memory_order_acquire) != SlotState::CONNECTED) {
+        if (std::chrono::steady_clock::now() > deadline || header->serverAlive.load(std::memory_order_acquire) == 0) {
+            // Back to CLAIMING first so the reaper never reads the cleared pid
+            SlotState expected = SlotState::CLAIMED;
+            if (slot->state.compare_exchange_strong(expected, SlotState::CLAIMING, std::memory_order_acq_rel)) {
+                slot->clientPid.store(0, std::memory_order_relaxed);
+                slot->state.store(SlotState::FREE, std::memory_order_release);
+            } else {
+                // The server accepted us just now; hand the slot back
+                slot->state.store(SlotState::CLOSING, std::memory_order_release);
+            }
+            unmap();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    sessionId = slot->sessionId;
+    requests = SharedMemoryLayout::requestRing(region, slotIndex);
+    reports = SharedMemoryLayout::reportRing(region, slotIndex);
+    connected = true;
+    return true;
+}
+
+void SharedMemoryClient::disconnect() {
+    if (connected) {
+        SharedMemoryLayout::slotHeader(region, slotIndex)->state.store(SlotState::CLOSING, std::memory_order_release);
+        connected = false;
+    }
+    unmap();
+}
+
+bool SharedMemoryClient::isConnected() const {
+    return connected &&
+           SharedMemoryLayout::slotHeader(region, slotIndex)->state.load(std::memory_order_acquire) == SlotState::CONNECTED;
+}
+
+uint64_t SharedMemoryClient::getSessionId() const {
+    return sessionId;
+}
+
+bool SharedMemoryClient::sendNewOrder(const NewOrderMessage& message) {
+    return connected && requests.tryPush(&message, sizeof(message));
+}
+
+bool SharedMemoryClient::sendCancel(const CancelOrderMessage& message) {
+    return connected && requests.tryPush(&message, sizeof(message));
+}
+
+bool SharedMemoryClient::pollReport(ExecutionReportMessage& report) {
+    if (!connected) {
+        return false;
+    }
+
+    const char* frame = reports.front();
+    if (frame == nullptr) {
+        return false;
+    }
+
+    std::memcpy(&report, frame, sizeof(report));
+    reports.pop();
+    return true;
+}
+
+void SharedMemoryClient::unmap() {
+    if (region != nullptr) {
+        munmap(region, regionSize);
+        region = nullptr;
+        regionSize = 0;
+    }
+}
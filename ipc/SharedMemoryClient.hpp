@@ -0,0 +1,44 @@
+#ifndef MATCHING_ENGINE_SHAREDMEMORYCLIENT_HPP
+#define MATCHING_ENGINE_SHAREDMEMORYCLIENT_HPP
+
+#include "SharedMemoryLayout.hpp"
+#include "../gateway/Protocol.hpp"
+#include <chrono>
+#include <string>
+
+// Client side of shared-memory order entry. Not thread-safe: one thread
+// sends requests and (possibly another single thread) polls reports.
+class SharedMemoryClient {
+public:
+    SharedMemoryClient();
+    ~SharedMemoryClient();
+
+    SharedMemoryClient(const SharedMemoryClient&) = delete;
+    SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+
+    // Claim a slot in the named region and wait for the engine to accept it
+    bool connect(const std::string& name, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    void disconnect();
+    bool isConnected() const;
+    uint64_t getSessionId() const;
+
+    // Return false when the request ring is full; the caller may retry
+    bool sendNewOrder(const NewOrderMessage& message);
+    bool sendCancel(const CancelOrderMessage& message);
+
+    // Non-blocking; returns true and fills report if one was waiting
+    bool pollReport(ExecutionReportMessage& report);
+
+private:
+    void* region;
+    size_t regionSize;
+    uint32_t slotIndex;
+    uint64_t sessionId;
+    bool connected;
+    SpscRing requests;
+    SpscRing reports;
+
+    void unmap();
+};
+
+#endif // MATCHING_ENGINE_SHAREDMEMORYCLIENT_HPP
@@ -0,0 +1,134 @@
+#include "SharedMemoryClient.hpp"
+#include "SharedMemoryServer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Cross-process round-trip latency for shared-memory order entry.
+//
+// Forks a client process that keeps one order in flight and times the gap
+// between pushing a NewOrder and reading the first execution report for it.
+// Orders alternate buy/sell at one price so the book stays shallow.
+//
+// Usage: shm_latency [--orders N] [--threads N]
+
+namespace {
+
+const char* REGION_NAME = "/matching_engine_latency";
+
+// Spin briefly, then give the CPU away so the engine can run on small hosts
+void backOff(int& spins) {
+    if (++spins < 1000) {
+        cpuRelax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+double percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    return static_cast<double>(sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))]);
+}
+
+int runClient(int orders) {
+    SharedMemoryClient client;
+
+    // The parent creates the region after forking; keep trying until it exists
+    for (int attempt = 0; !client.connect(REGION_NAME); ++attempt) {
+        if (attempt > 5000) {
+            std::cerr << "Client could not connect to " << REGION_NAME << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(orders);
+    ExecutionReportMessage report;
+
+    for (int i = 1; i <= orders; ++i) {
+        auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+        message.clientOrderId = static_cast<uint64_t>(i);
+        encodeSymbol("AAPL", message.symbol);
+        message.side = (i % 2 == 0) ? WireSide::SELL : WireSide::BUY;
+        message.price = 100.0;
+        message.quantity = 1;
+
+        int spins = 0;
+        auto sentAt = std::chrono::steady_clock::now();
+        while (!client.sendNewOrder(message)) {
+            backOff(spins);
+        }
+
+        bool acknowledged = false;
+        while (!acknowledged) {
+            if (client.pollReport(report)) {
+                acknowledged = report.clientOrderId == message.clientOrderId;
+            } else {
+                backOff(spins);
+            }
+        }
+
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - sentAt).count());
+    }
+
+    client.disconnect();
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Orders:    " << latencies.size() << std::endl;
+    std::cout << "RTT p50:   " << percentile(latencies, 0.50) << " ns" << std::endl;
+    std::cout << "RTT p90:   " << percentile(latencies, 0.90) << " ns" << std::endl;
+    std::cout << "RTT p99:   " << percentile(latencies, 0.99) << " ns" << std::endl;
+    std::cout << "RTT p99.9: " << percentile(latencies, 0.999) << " ns" << std::endl;
+    std::cout << "RTT max:   " << percentile(latencies, 1.0) << " ns" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int orders = 100000;
+    size_t threads = 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--orders") {
+            orders = std::atoi(argv[i + 1]);
+        } else if (flag == "--threads") {
+            threads = static_cast<size_t>(std::atoi(argv[i + 1]));
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    // Fork before any engine thread exists
+    pid_t child = fork();
+    if (child == 0) {
+        _exit(runClient(orders));
+    }
+
+    ContinuousMatchingEngine engine(threads);
+    engine.addSymbol("AAPL");
+    engine.start();
+
+    SharedMemoryServer server(engine, REGION_NAME, 4);
+    if (!server.start()) {
+        kill(child, SIGKILL);
+        return 1;
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+
+    server.stop();
+    engine.stop();
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -0,0 +1,82 @@
+#ifndef MATCHING_ENGINE_SHAREDMEMORYLAYOUT_HPP
+#define MATCHING_ENGINE_SHAREDMEMORYLAYOUT_HPP
+
+#include "SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of the order entry region shared between the engine and co-located
+// clients:
+//
+//   [SharedRegionHeader][slot 0][slot 1]...[slot maxClients-1]
+//   slot = [ClientSlotHeader][request ring][report ring]
+//
+// Handshake: a client claims a FREE slot (FREE -> CLAIMING), publishes its
+// pid, marks the slot CLAIMED and waits; the server resets both rings,
+// assigns a session id and publishes CONNECTED.
+// Either side moves the slot to CLOSING to disconnect and the server
+// returns it to FREE once it has released the session.
+
+constexpr uint64_t SHARED_REGION_MAGIC = 0x4d455348524e4731ULL; // "MESHRNG1"
+constexpr uint32_t SHARED_REGION_VERSION = 2;
+
+enum class SlotState : uint32_t {
+    FREE = 0,
+    CLAIMED = 1,
+    CONNECTED = 2,
+    CLOSING = 3,
+    CLAIMING = 4   // claimed, pid not yet published
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Slot state must be address-free");
+static_assert(std::atomic<int32_t>::is_always_lock_free, "Client pid must be address-free");
+
+struct alignas(CACHE_LINE_SIZE) SharedRegionHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t maxClients;
+    uint64_t ringCapacity;
+    std::atomic<uint32_t> serverAlive;
+};
+
+struct alignas(CACHE_LINE_SIZE) ClientSlotHeader {
+    std::atomic<SlotState> state;
+    std::atomic<int32_t> clientPid;  // 0 while the slot is free
+    uint64_t sessionId;
+};
+
+class SharedMemoryLayout {
+public:
+    static size_t slotSize(uint64_t ringCapacity) {
+        return sizeof(ClientSlotHeader) + 2 * SpscRing::bytesRequired(ringCapacity);
+    }
+
+    static size_t regionSize(uint32_t maxClients, uint64_t ringCapacity) {
+        return sizeof(SharedRegionHeader) + maxClients * slotSize(ringCapacity);
+    }
+
+    static char* slotBase(void* region, uint32_t slot) {
+        auto* header = static_cast<SharedRegionHeader*>(region);
+        return static_cast<char*>(region) + sizeof(SharedRegionHeader) + slot * slotSize(header->ringCapacity);
+    }
+
+    static ClientSlotHeader* slotHeader(void* region, uint32_t slot) {
+        return reinterpret_cast<ClientSlotHeader*>(slotBase(region, slot));
+    }
+
+    // Client -> engine
+    static SpscRing requestRing(void* region, uint32_t slot) {
+        auto* header = static_cast<SharedRegionHeader*>(region);
+        return SpscRing(slotBase(region, slot) + sizeof(ClientSlotHeader), header->ringCapacity);
+    }
+
+    // Engine -> client
+    static SpscRing reportRing(void* region, uint32_t slot) {
+        auto* header = static_cast<SharedRegionHeader*>(region);
+        return SpscRing(slotBase(region, slot) + sizeof(ClientSlotHeader) + SpscRing::bytesRequired(header->ringCapacity),
+                        header->ringCapacity);
+    }
+};
+
+#endif // MATCHING_ENGINE_SHAREDMEMORYLAYOUT_HPP
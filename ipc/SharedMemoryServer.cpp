@@ -0,0 +1,300 @@
+#include "SharedMemoryServer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+// Poller back-off: spin, then yield, then nap once the rings have been idle a while
+constexpr int IDLE_SPINS = 2000;
+constexpr int IDLE_YIELDS = 200;
+constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
+constexpr auto REAP_INTERVAL = std::chrono::milliseconds(100);
+
+// Requests drained from one client before moving on, so a busy client
+// cannot starve the others
+constexpr int MAX_REQUESTS_PER_SLOT = 64;
+
+bool isPowerOfTwo(uint64_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace
+
+SharedMemoryServer::SharedMemoryServer(ContinuousMatchingEngine& engine,
+                                       const std::string& name,
+                                       uint32_t maxClients,
+                                       uint64_t ringCapacity)
+    : engine(engine),
+      name(name),
+      maxClients(std::min<uint32_t>(maxClients, 0xFFFF)),
+      ringCapacity(isPowerOfTwo(ringCapacity) ? ringCapacity : 4096),
+      region(nullptr),
+      regionSize(0),
+      running(false),
+      sessionCount(0) {
+
+    for (uint32_t i = 0; i < this->maxClients; ++i) {
+        slots.push_back(std::make_unique<ServerSlot>());
+    }
+
+    entryHandler = std::make_unique<OrderEntryHandler>(engine, [this](uint64_t sessionId, const ExecutionReportMessage& report) {
+        sendReport(sessionId, report);
+    });
+}
+
+SharedMemoryServer::~SharedMemoryServer() {
+    stop();
+    entryHandler.reset();
+}
+
+bool SharedMemoryServer::start() {
+    if (isRunning()) {
+        return false;
+    }
+
+    // A stale region from a crashed engine would confuse new clients
+    shm_unlink(name.c_str());
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "Shared memory: failed to create region " << name << std::endl;
+        return false;
+    }
+
+    regionSize = SharedMemoryLayout::regionSize(maxClients, ringCapacity);
+    if (ftruncate(fd, static_cast<off_t>(regionSize)) != 0) {
+        std::cerr << "Shared memory: failed to size region " << name << std::endl;
+        close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        std::cerr << "Shared memory: failed to map region " << name << std::endl;
+        region = nullptr;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills, so every slot starts FREE
+    auto* header = static_cast<SharedRegionHeader*>(region);
+    header->magic = SHARED_REGION_MAGIC;
+    header->version = SHARED_REGION_VERSION;
+    header->maxClients = maxClients;
+    header->ringCapacity = ringCapacity;
+
+    for (uint32_t i = 0; i < maxClients; ++i) {
+        slots[i]->requests = SharedMemoryLayout::requestRing(region, i);
+        slots[i]->reports = SharedMemoryLayout::reportRing(region, i);
+    }
+
+    header->serverAlive.store(1, std::memory_order_release);
+
+    running.store(true);
+    poller = std::thread(&SharedMemoryServer::pollLoop, this);
+
+    std::cout << "Shared memory order entry listening on " << name
+              << " for " << maxClients << " clients" << std::endl;
+    return true;
+}
+
+void SharedMemoryServer::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    running.store(false);
+    if (poller.joinable()) {
+        poller.join();
+    }
+
+    for (uint32_t i = 0; i < maxClients; ++i) {
+        closeSession(i);
+    }
+
+    auto* header = static_cast<SharedRegionHeader*>(region);
+    header->serverAlive.store(0, std::memory_order_release);
+
+    munmap(region, regionSize);
+    region = nullptr;
+    shm_unlink(name.c_str());
+
+    std::cout << "Shared memory order entry stopped" << std::endl;
+}
+
+bool SharedMemoryServer::isRunning() const {
+    return running.load();
+}
+
+const std::string& SharedMemoryServer::getName() const {
+    return name;
+}
+
+size_t SharedMemoryServer::getSessionCount() const {
+    return sessionCount.load();
+}
+
+void SharedMemoryServer::pollLoop() {
+    int idleRounds = 0;
+    auto lastReap = std::chrono::steady_clock::now();
+
+    while (isRunning()) {
+        bool didWork = false;
+        for (uint32_t i = 0; i < maxClients; ++i) {
+            didWork |= pollSlot(i);
+        }
+
+        if (didWork) {
+            idleRounds = 0;
+            continue;
+        }
+
+        ++idleRounds;
+        if (idleRounds < IDLE_SPINS) {
+            cpuRelax();
+        } else if (idleRounds < IDLE_SPINS + IDLE_YIELDS) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReap >= REAP_INTERVAL) {
+            reapDeadClients();
+            lastReap = now;
+        }
+    }
+}
+
+bool SharedMemoryServer::pollSlot(uint32_t index) {
+    ClientSlotHeader* header = SharedMemoryLayout::slotHeader(region, index);
+    ServerSlot& slot = *slots[index];
+
+    switch (header->state.load(std::memory_order_acquire)) {
+        case SlotState::CLAIMED:
+            openSession(index);
+            return true;
+        case SlotState::CLOSING:
+            closeSession(index);
+            return true;
+        case SlotState::CONNECTED:
+            break;
+        default:
+            return false;
+    }
+
+    bool didWork = false;
+
+    for (int i = 0; i < MAX_REQUESTS_PER_SLOT; ++i) {
+        const char* frame = slot.requests.front();
+        if (frame == nullptr) {
+            break;
+        }
+
+        MessageHeader messageHeader;
+        std::memcpy(&messageHeader, frame, sizeof(messageHeader));
+        bool valid = messageHeader.length >= sizeof(MessageHeader) &&
+                     messageHeader.length <= SPSC_SLOT_SIZE &&
+                     entryHandler->handleMessage(slot.sessionId, frame, messageHeader.length);
+        slot.requests.pop();
+        didWork = true;
+
+        if (!valid) {
+            std::cerr << "Shared memory: protocol error from session " << slot.sessionId << std::endl;
+            header->state.store(SlotState::CLOSING, std::memory_order_release);
+            break;
+        }
+    }
+
+    // Move spilled reports into the ring as the client frees space
+    std::lock_guard<std::mutex> lock(slot.reportMutex);
+    while (!slot.overflow.empty() && slot.reports.tryPush(&slot.overflow.front(), sizeof(ExecutionReportMessage))) {
+        slot.overflow.pop_front();
+        didWork = true;
+    }
+
+    return didWork;
+}
+
+void SharedMemoryServer::openSession(uint32_t index) {
+    ClientSlotHeader* header = SharedMemoryLayout::slotHeader(region, index);
+    ServerSlot& slot = *slots[index];
+
+    std::lock_guard<std::mutex> lock(slot.reportMutex);
+    slot.requests.reset(ringCapacity);
+    slot.reports.reset(ringCapacity);
+    slot.overflow.clear();
+    slot.generation++;
+    slot.sessionId = SESSION_ID_BIT | (static_cast<uint64_t>(slot.generation) << 16) | index;
+
+    // Published for the client to read; dispatch uses the server's copy
+    header->sessionId = slot.sessionId;
+    sessionCount.fetch_add(1);
+
+    // Publishes the reset rings and session id to the waiting client
+    header->state.store(SlotState::CONNECTED, std::memory_order_release);
+}
+
+void SharedMemoryServer::closeSession(uint32_t index) {
+    ClientSlotHeader* header = SharedMemoryLayout::slotHeader(region, index);
+    ServerSlot& slot = *slots[index];
+    uint64_t closedSessionId = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(slot.reportMutex);
+        if (slot.sessionId != 0) {
+            closedSessionId = slot.sessionId;
+            slot.sessionId = 0;
+            slot.overflow.clear();
+            sessionCount.fetch_sub(1);
+        }
+    }
+
+    header->clientPid.store(0, std::memory_order_relaxed);
+    header->state.store(SlotState::FREE, std::memory_order_release);
+
+    if (closedSessionId != 0 && entryHandler) {
+        entryHandler->onSessionClosed(closedSessionId);
+    }
+}
+
+void SharedMemoryServer::reapDeadClients() {
+    for (uint32_t i = 0; i < maxClients; ++i) {
+        ClientSlotHeader* header = SharedMemoryLayout::slotHeader(region, i);
+        SlotState state = header->state.load(std::memory_order_acquire);
+        if (state != SlotState::CONNECTED && state != SlotState::CLAIMED) {
+            continue;
+        }
+        // A CLAIMED slot always carries its client's pid (acquired with the state)
+        pid_t pid = header->clientPid.load(std::memory_order_relaxed);
+        if (pid > 0 && kill(pid, 0) != 0 && errno == ESRCH) {
+            std::cerr << "Shared memory: client " << pid << " exited without disconnecting" << std::endl;
+            closeSession(i);
+        }
+    }
+}
+
+void SharedMemoryServer::sendReport(uint64_t sessionId, const ExecutionReportMessage& report) {
+    uint32_t index = static_cast<uint32_t>(sessionId & 0xFFFF);
+    if ((sessionId & SESSION_ID_BIT) == 0 || index >= maxClients) {
+        return;
+    }
+
+    ServerSlot& slot = *slots[index];
+    std::lock_guard<std::mutex> lock(slot.reportMutex);
+    if (slot.sessionId != sessionId) {
+        return; // session is gone; drop its reports
+    }
+
+    if (!slot.overflow.empty() || !slot.reports.tryPush(&report, sizeof(report))) {
+        slot.overflow.push_back(report);
+    }
+}
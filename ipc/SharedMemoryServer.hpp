@@ -0,0 +1,73 @@
+#ifndef MATCHING_ENGINE_SHAREDMEMORYSERVER_HPP
+#define MATCHING_ENGINE_SHAREDMEMORYSERVER_HPP
+
+#include "SharedMemoryLayout.hpp"
+#include "../gateway/OrderEntryHandler.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shared-memory order entry for clients on the same host.
+//
+// Creates a POSIX shared memory region holding one request ring and one
+// report ring per client slot. A single poller thread busy-polls the
+// request rings and feeds decoded orders to the engine, skipping the kernel
+// network stack entirely. Reports are pushed into the report ring from the
+// shard thread; if the client falls behind they spill into a private
+// overflow queue that the poller drains.
+class SharedMemoryServer {
+public:
+    SharedMemoryServer(ContinuousMatchingEngine& engine,
+                       const std::string& name,
+                       uint32_t maxClients = 64,
+                       uint64_t ringCapacity = 4096);
+    ~SharedMemoryServer();
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    const std::string& getName() const;
+    size_t getSessionCount() const;
+
+    // Session ids handed out here never collide with TCP gateway sessions
+    static constexpr uint64_t SESSION_ID_BIT = 1ULL << 63;
+
+private:
+    struct ServerSlot {
+        SpscRing requests;
+        SpscRing reports;
+
+        // Guards the report ring producer side, the overflow queue and sessionId
+        std::mutex reportMutex;
+        std::deque<ExecutionReportMessage> overflow;
+        uint64_t sessionId = 0;
+        uint32_t generation = 0;
+    };
+
+    ContinuousMatchingEngine& engine;
+    std::string name;
+    uint32_t maxClients;
+    uint64_t ringCapacity;
+    void* region;
+    size_t regionSize;
+    std::vector<std::unique_ptr<ServerSlot>> slots;
+    std::atomic<bool> running;
+    std::atomic<size_t> sessionCount;
+    std::thread poller;
+    std::unique_ptr<OrderEntryHandler> entryHandler;
+
+    void pollLoop();
+    bool pollSlot(uint32_t index);
+    void openSession(uint32_t index);
+    void closeSession(uint32_t index);
+    void reapDeadClients();
+    void sendReport(uint64_t sessionId, const ExecutionReportMessage& report);
+};
+
+#endif // MATCHING_ENGINE_SHAREDMEMORYSERVER_HPP
@@ -0,0 +1,112 @@
+#ifndef MATCHING_ENGINE_SPSCRING_HPP
+#define MATCHING_ENGINE_SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Single-producer/single-consumer ring of fixed-size slots that can live in
+// memory shared between processes. The control block holds only lock-free
+// atomics and plain integers (no pointers), so every process can map it at
+// a different address; SpscRing is a per-process view over it.
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t SPSC_SLOT_SIZE = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared rings need address-free atomics");
+
+// Back-off hint for busy-polling loops
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+struct SpscRingControl {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head; // next slot to read
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail; // next slot to write
+    alignas(CACHE_LINE_SIZE) uint64_t capacity;          // power of two
+};
+
+class SpscRing {
+public:
+    SpscRing() = default;
+
+    SpscRing(void* memory, uint64_t capacity)
+        : control(static_cast<SpscRingControl*>(memory)),
+          slots(static_cast<char*>(memory) + sizeof(SpscRingControl)),
+          mask(capacity - 1),
+          cachedHead(0),
+          cachedTail(0) {
+    }
+
+    // Bytes needed for a ring with the given (power of two) capacity
+    static size_t bytesRequired(uint64_t capacity) {
+        return sizeof(SpscRingControl) + capacity * SPSC_SLOT_SIZE;
+    }
+
+    // Only call while neither side is using the ring
+    void reset(uint64_t capacity) {
+        control->head.store(0, std::memory_order_relaxed);
+        control->tail.store(0, std::memory_order_relaxed);
+        control->capacity = capacity;
+        mask = capacity - 1;
+        cachedHead = 0;
+        cachedTail = 0;
+    }
+
+    // Producer side
+    bool tryPush(const void* data, size_t length) {
+        if (length > SPSC_SLOT_SIZE) {
+            return false;
+        }
+
+        uint64_t tail = control->tail.load(std::memory_order_relaxed);
+        if (tail - cachedHead > mask) {
+            // Only touch the consumer's cache line when the ring looks full
+            cachedHead = control->head.load(std::memory_order_acquire);
+            if (tail - cachedHead > mask) {
+                return false;
+            }
+        }
+
+        std::memcpy(slots + (tail & mask) * SPSC_SLOT_SIZE, data, length);
+        control->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: returns a pointer to the front slot, or nullptr if empty
+    const char* front() {
+        uint64_t head = control->head.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = control->tail.load(std::memory_order_acquire);
+            if (head == cachedTail) {
+                return nullptr;
+            }
+        }
+        return slots + (head & mask) * SPSC_SLOT_SIZE;
+    }
+
+    void pop() {
+        uint64_t head = control->head.load(std::memory_order_relaxed);
+        control->head.store(head + 1, std::memory_order_release);
+    }
+
+    bool isAttached() const {
+        return control != nullptr;
+    }
+
+private:
+    SpscRingControl* control = nullptr;
+    char* slots = nullptr;
+    uint64_t mask = 0;
+
+    // Per-process copies of the other side's index, refreshed only when needed
+    uint64_t cachedHead = 0;
+    uint64_t cachedTail = 0;
+};
+
+#endif // MATCHING_ENGINE_SPSCRING_HPP
@@ -0,0 +1,338 @@
+#include "AsyncLogger.hpp"
+#include "../metrics/TscClock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+std::string toString(LogLevel level) {
+    switch (level) {
+        case LogLevel::INFO:
+            return "INFO";
+        case LogLevel::WARN:
+            return "WARN";
+        case LogLevel::ERROR:
+            return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+namespace {
+
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(1);
+
+// Drained rings of exited threads kept for reuse by new threads
+constexpr size_t MAX_FREE_RINGS = 8;
+
+struct LogFormat {
+    LogLevel level;
+    std::string text;
+};
+
+struct LogRing {
+    explicit LogRing(size_t capacity)
+        : records(new LogRecord[capacity]), mask(capacity - 1) {
+    }
+
+    std::unique_ptr<LogRecord[]> records;
+    size_t mask;
+
+    // Producer side
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t cachedTail = 0;
+    std::atomic<uint64_t> dropped{0};
+
+    // Consumer side
+    alignas(64) std::atomic<uint64_t> tail{0};
+    uint64_t droppedReported = 0;
+};
+
+class LogRegistry {
+public:
+    LogRegistry()
+        : sink(&std::cerr),
+          startWallClock(std::chrono::system_clock::now()),
+          startTicks(TscClock::now()),
+          stopRequested(false) {
+        consumer = std::thread(&LogRegistry::run, this);
+    }
+
+    ~LogRegistry() {
+        {
+            std::lock_guard<std::mutex> lock(stopMutex);
+            stopRequested = true;
+        }
+        stopCondition.notify_one();
+        consumer.join();
+        drain();
+    }
+
+    std::mutex mutex;
+    std::deque<LogFormat> formats;
+    std::vector<std::shared_ptr<LogRing>> rings;        // live threads
+    std::vector<std::shared_ptr<LogRing>> exitedRings;  // awaiting a last drain
+    std::vector<std::shared_ptr<LogRing>> freeRings;
+    uint64_t retiredDropped = 0;                        // from discarded rings
+    std::atomic<size_t> ringCapacity{1024};
+
+    // Serialises consumers (the background thread and flush())
+    std::mutex drainMutex;
+    std::ostream* sink;
+
+    void drain() {
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        std::vector<std::shared_ptr<LogRing>> currentRings;
+        std::vector<std::shared_ptr<LogRing>> exited;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            currentRings = rings;
+            exited = exitedRings;
+        }
+        currentRings.insert(currentRings.end(), exited.begin(), exited.end());
+
+        for (auto& ring : currentRings) {
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail < head; ++tail) {
+                writeRecord(ring->records[tail & ring->mask]);
+            }
+            ring->tail.store(tail, std::memory_order_release);
+
+            uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+            if (dropped > ring->droppedReported) {
+                *sink << "[WARN] " << dropped - ring->droppedReported << " log messages dropped\n";
+                ring->droppedReported = dropped;
+            }
+        }
+        sink->flush();
+
+        if (!exited.empty()) {
+            recycle(exited);
+        }
+    }
+
+private:
+    std::chrono::system_clock::time_point startWallClock;
+    uint64_t startTicks;
+    std::vector<const LogFormat*> formatCache;  // consumer's view of formats
+
+    std::thread consumer;
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;
+    bool stopRequested;
+
+    // Exited threads log nothing more, so once drained their rings can go
+    // to new threads or be freed
+    void recycle(const std::vector<std::shared_ptr<LogRing>>& drained) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& ring : drained) {
+            exitedRings.erase(std::find(exitedRings.begin(), exitedRings.end(), ring));
+            if (freeRings.size() < MAX_FREE_RINGS) {
+                freeRings.push_back(ring);
+            } else {
+                retiredDropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        while (!stopCondition.wait_for(lock, DRAIN_INTERVAL, [this] { return stopRequested; })) {
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    const LogFormat* lookupFormat(uint16_t formatId) {
+        if (formatId >= formatCache.size()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = formatCache.size(); i < formats.size(); ++i) {
+                formatCache.push_back(&formats[i]);
+            }
+        }
+        return formatId < formatCache.size() ? formatCache[formatId] : nullptr;
+    }
+
+    void writeRecord(const LogRecord& record) {
+        const LogFormat* format = lookupFormat(record.formatId);
+        if (!format) {
+            return;
+        }
+
+        auto elapsed = std::chrono::nanoseconds(TscClock::toNanos(record.ticks - startTicks));
+        auto wallClock = startWallClock + std::chrono::duration_cast<std::chrono::system_clock::duration>(elapsed);
+        std::time_t seconds = std::chrono::system_clock::to_time_t(wallClock);
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            wallClock.time_since_epoch()).count() % 1000000;
+        std::tm utc{};
+        gmtime_r(&seconds, &utc);
+
+        *sink << std::put_time(&utc, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(6) << std::setfill('0') << micros
+              << std::setfill(' ') << " [" << toString(format->level) << "] "
+              << AsyncLogger::format(format->text, record) << '\n';
+    }
+};
+
+LogRegistry& registry() {
+    static LogRegistry instance;
+    return instance;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+// Hands the ring back when its thread ends. The registry drains it one
+// last time, so messages logged just before a thread exits are still
+// written, and then recycles it.
+struct ThreadRingOwner {
+    std::shared_ptr<LogRing> ring;
+    bool exited = false;
+
+    ~ThreadRingOwner();
+};
+
+// The raw pointer keeps the hot path off the thread_local init guard that
+// the owner's destructor brings
+thread_local LogRing* threadRing = nullptr;
+thread_local ThreadRingOwner threadRingOwner;
+
+ThreadRingOwner::~ThreadRingOwner() {
+    threadRing = nullptr;
+    exited = true;
+    if (!ring) {
+        return;
+    }
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.rings.erase(std::find(reg.rings.begin(), reg.rings.end(), ring));
+    reg.exitedRings.push_back(std::move(ring));
+}
+
+// nullptr once the thread's ring has been handed back
+LogRing* currentRing() {
+    if (!threadRing && !threadRingOwner.exited) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        size_t capacity = reg.ringCapacity.load();
+        std::shared_ptr<LogRing> ring;
+        while (!ring && !reg.freeRings.empty()) {
+            if (reg.freeRings.back()->mask + 1 == capacity) {
+                ring = std::move(reg.freeRings.back());
+            } else {
+                reg.retiredDropped += reg.freeRings.back()->dropped.load(std::memory_order_relaxed);
+            }
+            reg.freeRings.pop_back();
+        }
+        if (!ring) {
+            ring = std::make_shared<LogRing>(capacity);
+        }
+        reg.rings.push_back(ring);
+        threadRing = ring.get();
+        threadRingOwner.ring = std::move(ring);
+    }
+    return threadRing;
+}
+
+} // namespace
+
+uint16_t AsyncLogger::registerFormat(LogLevel level, const char* format) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.formats.push_back({level, format});
+    return static_cast<uint16_t>(reg.formats.size() - 1);
+}
+
+LogRecord* AsyncLogger::claim() {
+    LogRing* current = currentRing();
+    if (!current) {
+        return nullptr;
+    }
+    LogRing& ring = *current;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.cachedTail > ring.mask) {
+        ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+        if (head - ring.cachedTail > ring.mask) {
+            ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    LogRecord* record = &ring.records[head & ring.mask];
+    record->ticks = TscClock::now();
+    return record;
+}
+
+void AsyncLogger::publish() {
+    LogRing& ring = *threadRing;
+    ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void AsyncLogger::flush() {
+    registry().drain();
+}
+
+void AsyncLogger::setSink(std::ostream& sink) {
+    auto& reg = registry();
+    reg.drain();
+    std::lock_guard<std::mutex> lock(reg.drainMutex);
+    reg.sink = &sink;
+}
+
+void AsyncLogger::setRingCapacity(size_t records) {
+    registry().ringCapacity.store(roundUpToPowerOfTwo(std::max<size_t>(records, 2)));
+}
+
+uint64_t AsyncLogger::getDroppedCount() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t dropped = reg.retiredDropped;
+    for (const auto* list : {&reg.rings, &reg.exitedRings, &reg.freeRings}) {
+        for (const auto& ring : *list) {
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+std::string AsyncLogger::format(const std::string& format, const LogRecord& record) {
+    std::ostringstream out;
+    size_t nextArg = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '{' && i + 1 < format.size() && format[i + 1] == '}' && nextArg < record.argCount) {
+            const LogArg& arg = record.args[nextArg++];
+            switch (arg.type) {
+                case LogArgType::INT:
+                    out << arg.intValue;
+                    break;
+                case LogArgType::UINT:
+                    out << arg.uintValue;
+                    break;
+                case LogArgType::DOUBLE:
+                    out << arg.doubleValue;
+                    break;
+                case LogArgType::TEXT:
+                    out.write(arg.text, arg.length);
+                    break;
+            }
+            ++i;
+        } else {
+            out << format[i];
+        }
+    }
+    return out.str();
+}
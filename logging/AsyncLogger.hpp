@@ -0,0 +1,130 @@
+#ifndef MATCHING_ENGINE_ASYNCLOGGER_HPP
+#define MATCHING_ENGINE_ASYNCLOGGER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+enum class LogLevel : uint8_t {
+    INFO,
+    WARN,
+    ERROR
+};
+
+std::string toString(LogLevel level);
+
+enum class LogArgType : uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    TEXT
+};
+
+// One captured argument. Strings are copied inline and cut to
+// LOG_MAX_TEXT_LENGTH bytes so a record never points at caller memory.
+constexpr size_t LOG_MAX_TEXT_LENGTH = 24;
+
+struct LogArg {
+    union {
+        int64_t intValue;
+        uint64_t uintValue;
+        double doubleValue;
+        char text[LOG_MAX_TEXT_LENGTH];
+    };
+    LogArgType type;
+    uint8_t length;
+};
+
+constexpr size_t LOG_MAX_ARGS = 4;
+
+struct LogRecord {
+    uint64_t ticks;
+    uint16_t formatId;
+    uint8_t argCount;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+// Low-latency logger for hot paths.
+//
+// Each logging thread owns a single-producer ring of fixed-size records. A
+// log call stores a registered format id, a TscClock timestamp and the raw
+// arguments, with no allocation, formatting or I/O; if the ring is full the
+// message is dropped and counted rather than blocking. A background thread
+// drains every ring, substitutes the arguments into the "{}" placeholders
+// of the format and writes one line per message to the sink (std::cerr by
+// default). A thread's ring is drained one last time after the thread
+// exits and then reused by a later thread. Use the LOG_INFO / LOG_WARN /
+// LOG_ERROR macros, which register their format once per call site.
+class AsyncLogger {
+public:
+    static uint16_t registerFormat(LogLevel level, const char* format);
+
+    template <typename... Args>
+    static void log(uint16_t formatId, const Args&... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        LogRecord* record = claim();
+        if (!record) {
+            return;
+        }
+        record->formatId = formatId;
+        record->argCount = static_cast<uint8_t>(sizeof...(Args));
+        LogArg* arg = record->args;
+        (capture(*arg++, args), ...);
+        publish();
+    }
+
+    // Write everything logged so far and flush the sink
+    static void flush();
+
+    // Replace the output stream; flushes pending messages to the old one first
+    static void setSink(std::ostream& sink);
+
+    // Records per thread ring; applies to threads that have not logged yet
+    static void setRingCapacity(size_t records);
+
+    // Messages lost to full rings since startup
+    static uint64_t getDroppedCount();
+
+    static std::string format(const std::string& format, const LogRecord& record);
+
+private:
+    static LogRecord* claim();
+    static void publish();
+
+    template <typename T>
+    static void capture(LogArg& arg, const T& value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            arg.type = LogArgType::DOUBLE;
+            arg.doubleValue = static_cast<double>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.type = LogArgType::INT;
+            arg.intValue = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<T>) {
+            arg.type = LogArgType::UINT;
+            arg.uintValue = static_cast<uint64_t>(value);
+        } else {
+            captureText(arg, std::string_view(value));
+        }
+    }
+
+    static void captureText(LogArg& arg, std::string_view text) {
+        arg.type = LogArgType::TEXT;
+        arg.length = static_cast<uint8_t>(text.size() < LOG_MAX_TEXT_LENGTH ? text.size() : LOG_MAX_TEXT_LENGTH);
+        std::memcpy(arg.text, text.data(), arg.length);
+    }
+};
+
+#define MATCHING_ENGINE_LOG(level, format, ...)                                        \
+    do {                                                                               \
+        static const uint16_t logFormatId = AsyncLogger::registerFormat(level, format); \
+        AsyncLogger::log(logFormatId __VA_OPT__(, ) __VA_ARGS__);                       \
+    } while (0)
+
+#define LOG_INFO(format, ...) MATCHING_ENGINE_LOG(LogLevel::INFO, format __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_WARN(format, ...) MATCHING_ENGINE_LOG(LogLevel::WARN, format __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_ERROR(format, ...) MATCHING_ENGINE_LOG(LogLevel::ERROR, format __VA_OPT__(, ) __VA_ARGS__)
+
+#endif // MATCHING_ENGINE_ASYNCLOGGER_HPP
@@ -32,6 +32,9 @@ void onOrderProcessed(std::shared_ptr<OrderProcessingResult> result) {
         case OrderProcessingResult::Status::NO_MATCH:
             std::cout << "  Status: NO_MATCH" << std::endl;
             break;
+        case OrderProcessingResult::Status::CANCELLED:
+            std::cout << "  Status: CANCELLED" << std::endl;
+            break;
         case OrderProcessingResult::Status::ERROR:
             std::cout << "  Status: ERROR - " << result->getErrorMessage() << std::endl;
             break;
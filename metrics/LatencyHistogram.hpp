@@ -0,0 +1,49 @@
+#ifndef MATCHING_ENGINE_LATENCYHISTOGRAM_HPP
+#define MATCHING_ENGINE_LATENCYHISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free log-linear histogram in the style of HdrHistogram.
+//
+// Values are bucketed by power of two and then split into 32 linear
+// sub-buckets, so any reported percentile is within ~3% of the recorded
+// value over the full uint64_t range with a fixed 16KB footprint. record()
+// is a relaxed atomic increment and may be called from any thread; readers
+// see a consistent-enough snapshot without stopping writers.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value);
+
+    // As record(), for a histogram only one thread writes: relaxed loads
+    // and stores instead of locked read-modify-writes. Must not be mixed
+    // with concurrent record() calls.
+    void recordSingleWriter(uint64_t value);
+
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+
+    // Value at `percentile` in [0, 1], reported as the upper edge of its
+    // bucket (capped at the maximum recorded value)
+    uint64_t getPercentile(double percentile) const;
+
+    // Values recorded concurrently with a reset may or may not survive it
+    void reset();
+
+private:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ULL << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = 64 * SUB_BUCKET_COUNT;
+
+    static size_t bucketFor(uint64_t value);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> max;
+};
+
+#endif // MATCHING_ENGINE_LATENCYHISTOGRAM_HPP
@@ -0,0 +1,63 @@
+#include "PipelineLatency.hpp"
+#include "TscClock.hpp"
+
+std::string toString(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::QUEUE_WAIT:
+            return "QUEUE_WAIT";
+        case PipelineStage::DISPATCH:
+            return "DISPATCH";
+        case PipelineStage::MATCH:
+            return "MATCH";
+        case PipelineStage::PUBLISH:
+            return "PUBLISH";
+        case PipelineStage::END_TO_END:
+            return "END_TO_END";
+    }
+    return "UNKNOWN";
+}
+
+namespace {
+
+// Timestamps from different cores can be marginally out of order
+uint64_t elapsedTicks(uint64_t from, uint64_t to) {
+    return to > from ? to - from : 0;
+}
+
+} // namespace
+
+void PipelineLatencyRecorder::record(const StageTimestamps& timestamps) {
+    histograms[static_cast<size_t>(PipelineStage::QUEUE_WAIT)].recordSingleWriter(
+        elapsedTicks(timestamps.enqueue, timestamps.dequeue));
+    histograms[static_cast<size_t>(PipelineStage::DISPATCH)].recordSingleWriter(
+        elapsedTicks(timestamps.dequeue, timestamps.matchStart));
+    histograms[static_cast<size_t>(PipelineStage::MATCH)].recordSingleWriter(
+        elapsedTicks(timestamps.matchStart, timestamps.matchEnd));
+    histograms[static_cast<size_t>(PipelineStage::PUBLISH)].recordSingleWriter(
+        elapsedTicks(timestamps.matchEnd, timestamps.publish));
+    histograms[static_cast<size_t>(PipelineStage::END_TO_END)].recordSingleWriter(
+        elapsedTicks(timestamps.enqueue, timestamps.publish));
+}
+
+std::vector<StageLatencySummary> PipelineLatencyRecorder::summarize() const {
+    std::vector<StageLatencySummary> summaries;
+    summaries.reserve(PIPELINE_STAGE_COUNT);
+    for (size_t i = 0; i < PIPELINE_STAGE_COUNT; ++i) {
+        const auto& histogram = histograms[i];
+        summaries.push_back({
+            static_cast<PipelineStage>(i),
+            histogram.getCount(),
+            TscClock::toNanos(histogram.getPercentile(0.50)),
+            TscClock::toNanos(histogram.getPercentile(0.99)),
+            TscClock::toNanos(histogram.getPercentile(0.999)),
+            TscClock::toNanos(histogram.getMax())
+        });
+    }
+    return summaries;
+}
+
+void PipelineLatencyRecorder::reset() {
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef MATCHING_ENGINE_PIPELINELATENCY_HPP
+#define MATCHING_ENGINE_PIPELINELATENCY_HPP
+
+#include "LatencyHistogram.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Stages a command passes through between submitOrder()/cancelOrder() and
+// the last callback for it returning.
+enum class PipelineStage {
+    QUEUE_WAIT,  // enqueue -> dequeued by the shard worker
+    DISPATCH,    // dequeue -> matching starts
+    MATCH,       // matching starts -> matching ends
+    PUBLISH,     // matching ends -> callbacks have returned
+    END_TO_END   // enqueue -> callbacks have returned
+};
+
+constexpr size_t PIPELINE_STAGE_COUNT = 5;
+
+std::string toString(PipelineStage stage);
+
+// TscClock readings taken as one command moves through a shard
+struct StageTimestamps {
+    uint64_t enqueue = 0;
+    uint64_t dequeue = 0;
+    uint64_t matchStart = 0;
+    uint64_t matchEnd = 0;
+    uint64_t publish = 0;
+};
+
+struct StageLatencySummary {
+    PipelineStage stage;
+    uint64_t count;
+    uint64_t p50Nanos;
+    uint64_t p99Nanos;
+    uint64_t p999Nanos;
+    uint64_t maxNanos;
+};
+
+// One histogram per stage, owned by a single shard. Padded to its own
+// cache lines so shards never share a counter line. Histograms hold raw
+// TscClock ticks and summarize() converts them, so the shard never runs
+// the clock's calibration.
+class alignas(64) PipelineLatencyRecorder {
+public:
+    void record(const StageTimestamps& timestamps);
+    std::vector<StageLatencySummary> summarize() const;
+    void reset();
+
+private:
+    std::array<LatencyHistogram, PIPELINE_STAGE_COUNT> histograms;
+};
+
+#endif // MATCHING_ENGINE_PIPELINELATENCY_HPP
@@ -0,0 +1,338 @@
+#include "Tracer.hpp"
+#include "TscClock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+std::string toString(TraceEventType type) {
+    switch (type) {
+        case TraceEventType::QUEUE_WAIT:
+            return "QUEUE_WAIT";
+        case TraceEventType::TASK:
+            return "TASK";
+        case TraceEventType::MATCH:
+            return "MATCH";
+        case TraceEventType::PUBLISH:
+            return "PUBLISH";
+    }
+    return "UNKNOWN";
+}
+
+namespace {
+
+// Slots are atomics so a concurrent dump never reads a torn field; the
+// relaxed stores compile to plain moves
+struct TraceSlot {
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+    std::atomic<uint64_t> meta{0};  // symbolId << 8 | type
+};
+
+struct TraceRing {
+    explicit TraceRing(size_t capacity, uint32_t threadId)
+        : slots(new TraceSlot[capacity]), mask(capacity - 1), threadId(threadId) {
+    }
+
+    std::unique_ptr<TraceSlot[]> slots;
+    size_t mask;
+    uint32_t threadId;  // guarded by the registry mutex
+    std::string name;   // guarded by the registry mutex
+    alignas(64) std::atomic<uint64_t> head{0};
+    // Events before this belong to an earlier owner or were reset away
+    std::atomic<uint64_t> floor{0};
+};
+
+struct TraceEvent {
+    uint64_t begin;
+    uint64_t end;
+    uint64_t meta;
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;          // live threads
+    std::deque<std::shared_ptr<TraceRing>> exitedRings;     // oldest first
+    std::vector<std::shared_ptr<TraceRing>> freeRings;
+    size_t retainedExited = 8;
+    uint32_t nextThreadId = 1;
+    std::unordered_map<std::string, uint32_t> symbolIds;
+    std::vector<std::string> symbols;
+    std::atomic<bool> enabled{true};
+    std::atomic<size_t> ringCapacity{16384};
+};
+
+TraceRegistry& registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+// Trim exited rings to the retained count, keeping the trimmed ones (up to
+// the same count) for reuse. Caller holds the registry mutex.
+void trimExitedRings(TraceRegistry& reg) {
+    while (reg.exitedRings.size() > reg.retainedExited) {
+        if (reg.freeRings.size() < reg.retainedExited) {
+            reg.freeRings.push_back(std::move(reg.exitedRings.front()));
+        }
+        reg.exitedRings.pop_front();
+    }
+}
+
+// Moves the ring to the exited list when its thread ends, so a dump still
+// shows what an exited worker was doing
+struct ThreadRingOwner {
+    std::shared_ptr<TraceRing> ring;
+
+    ~ThreadRingOwner() {
+        if (!ring) {
+            return;
+        }
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto it = std::find(reg.rings.begin(), reg.rings.end(), ring);
+        if (it != reg.rings.end()) {
+            reg.rings.erase(it);
+        }
+        reg.exitedRings.push_back(std::move(ring));
+        trimExitedRings(reg);
+    }
+};
+
+// The raw pointer keeps record() off the thread_local init guard that the
+// owner's destructor brings
+thread_local TraceRing* threadRing = nullptr;
+thread_local ThreadRingOwner threadRingOwner;
+
+TraceRing& currentRing() {
+    if (!threadRing) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        uint32_t threadId = reg.nextThreadId++;
+        size_t capacity = reg.ringCapacity.load();
+        std::shared_ptr<TraceRing> ring;
+        while (!ring && !reg.freeRings.empty()) {
+            if (reg.freeRings.back()->mask + 1 == capacity) {
+                ring = std::move(reg.freeRings.back());
+            }
+            reg.freeRings.pop_back();
+        }
+        if (ring) {
+            ring->threadId = threadId;
+            ring->floor.store(ring->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        } else {
+            ring = std::make_shared<TraceRing>(capacity, threadId);
+        }
+        ring->name = "thread-" + std::to_string(threadId);
+        reg.rings.push_back(ring);
+        threadRing = ring.get();
+        threadRingOwner.ring = std::move(ring);
+    }
+    return *threadRing;
+}
+
+// Copy out the events still intact in `ring`, oldest first
+void snapshot(const TraceRing& ring, std::vector<TraceEvent>& events) {
+    size_t capacity = ring.mask + 1;
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t first = std::max(head > capacity ? head - capacity : 0,
+                              ring.floor.load(std::memory_order_relaxed));
+    first = std::min(first, head);
+
+    std::vector<TraceEvent> copied;
+    copied.reserve(static_cast<size_t>(head - first));
+    for (uint64_t i = first; i < head; ++i) {
+        const TraceSlot& slot = ring.slots[i & ring.mask];
+        copied.push_back({
+            slot.begin.load(std::memory_order_relaxed),
+            slot.end.load(std::memory_order_relaxed),
+            slot.meta.load(std::memory_order_relaxed)
+        });
+    }
+
+    // Drop anything the writer may have lapped while we were copying,
+    // including the slot it may be filling right now
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t headAfter = ring.head.load(std::memory_order_relaxed);
+    uint64_t safeFrom = headAfter >= capacity ? headAfter - capacity + 1 : 0;
+    for (uint64_t i = std::max(first, safeFrom); i < head; ++i) {
+        events.push_back(copied[static_cast<size_t>(i - first)]);
+    }
+}
+
+// Write `text` as a quoted JSON string. Symbols come off the wire as
+// arbitrary bytes, so anything outside printable ASCII is written as \u00XX.
+void writeJsonString(std::ostream& out, const std::string& text) {
+    static const char hexDigits[] = "0123456789abcdef";
+    out << '"';
+    for (char c : text) {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (byte < 0x20 || byte >= 0x7f) {
+            out << "\\u00" << hexDigits[byte >> 4] << hexDigits[byte & 0xF];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Tracer::record(TraceEventType type, uint32_t symbolId, uint64_t beginTicks, uint64_t endTicks) {
+    if (!registry().enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    TraceRing& ring = currentRing();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    TraceSlot& slot = ring.slots[head & ring.mask];
+
+    // Orders the previous head bump before these stores, so a reader that
+    // sees this slot's new contents also sees that the slot was lapped
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.begin.store(beginTicks, std::memory_order_relaxed);
+    slot.end.store(endTicks, std::memory_order_relaxed);
+    slot.meta.store(static_cast<uint64_t>(symbolId) << 8 | static_cast<uint8_t>(type), std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+bool Tracer::isEnabled() {
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setEnabled(bool enabled) {
+    registry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setRingCapacity(size_t events) {
+    registry().ringCapacity.store(roundUpToPowerOfTwo(std::max<size_t>(events, 2)));
+}
+
+void Tracer::setRetainedExitedRings(size_t rings) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.retainedExited = rings;
+    trimExitedRings(reg);
+}
+
+void Tracer::reset() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& ring : reg.rings) {
+        ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    size_t retained = reg.retainedExited;
+    reg.retainedExited = 0;
+    trimExitedRings(reg);
+    reg.retainedExited = retained;
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    TraceRing& ring = currentRing();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    ring.name = name;
+}
+
+uint32_t Tracer::internSymbol(const std::string& symbol) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.symbolIds.find(symbol);
+    if (it != reg.symbolIds.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(reg.symbols.size());
+    reg.symbols.push_back(symbol);
+    reg.symbolIds.emplace(symbol, id);
+    return id;
+}
+
+void Tracer::dumpChromeTrace(std::ostream& out, double lastSeconds) {
+    auto& reg = registry();
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    std::vector<uint32_t> threadIds;
+    std::vector<std::string> names;
+    std::vector<std::string> symbols;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        rings = reg.rings;
+        rings.insert(rings.end(), reg.exitedRings.begin(), reg.exitedRings.end());
+        for (const auto& ring : rings) {
+            threadIds.push_back(ring->threadId);
+            names.push_back(ring->name);
+        }
+        symbols = reg.symbols;
+    }
+
+    uint64_t now = TscClock::now();
+    double nanosPerTick = TscClock::nanosPerTick();
+    uint64_t windowTicks = static_cast<uint64_t>(lastSeconds * 1e9 / nanosPerTick);
+    uint64_t cutoff = now > windowTicks ? now - windowTicks : 0;
+
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (size_t r = 0; r < rings.size(); ++r) {
+        out << (first ? "\n" : ",\n")
+            << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << threadIds[r]
+            << ", \"args\": {\"name\": ";
+        writeJsonString(out, names[r]);
+        out << "}}";
+        first = false;
+
+        std::vector<TraceEvent> events;
+        snapshot(*rings[r], events);
+        for (const auto& event : events) {
+            if (event.end < cutoff) {
+                continue;
+            }
+            uint32_t symbolId = static_cast<uint32_t>(event.meta >> 8);
+            auto type = static_cast<TraceEventType>(event.meta & 0xFF);
+            uint64_t begin = std::max(event.begin, cutoff);
+            double startMicros = static_cast<double>(begin - cutoff) * nanosPerTick / 1000.0;
+            double durationMicros = event.end > begin
+                ? static_cast<double>(event.end - begin) * nanosPerTick / 1000.0
+                : 0.0;
+
+            out << ",\n{\"name\": ";
+            writeJsonString(out, toString(type));
+            out << ", \"cat\": \"engine\", \"ph\": \"X\""
+                << ", \"pid\": 1, \"tid\": " << threadIds[r]
+                << ", \"ts\": " << startMicros << ", \"dur\": " << durationMicros
+                << ", \"args\": {\"symbol\": ";
+            writeJsonString(out, symbolId < symbols.size() ? symbols[symbolId] : std::to_string(symbolId));
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Tracer::dumpChromeTrace(const std::string& path, double lastSeconds) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+    dumpChromeTrace(file, lastSeconds);
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,54 @@
+#ifndef MATCHING_ENGINE_TRACER_HPP
+#define MATCHING_ENGINE_TRACER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+enum class TraceEventType : uint8_t {
+    QUEUE_WAIT,  // enqueue -> dequeued by a worker
+    TASK,        // one command from dequeue to its last callback
+    MATCH,       // book update and matching
+    PUBLISH      // result and trade callbacks
+};
+
+std::string toString(TraceEventType type);
+
+// Always-on flight recorder for worker threads.
+//
+// Every thread that records gets its own fixed-size ring of 24-byte span
+// events (type, symbol id, begin and end TscClock ticks). Recording is three
+// relaxed stores and a head bump on memory no other thread writes, so it
+// can stay enabled in production; old events are overwritten once the ring
+// wraps. dumpChromeTrace() copies the recent part of every ring and writes
+// it as Chrome / Perfetto trace JSON (load it in ui.perfetto.dev or
+// chrome://tracing). When a thread exits its ring is kept for post-mortem
+// dumps; past the most recent few, exited rings are handed to new threads.
+class Tracer {
+public:
+    static void record(TraceEventType type, uint32_t symbolId, uint64_t beginTicks, uint64_t endTicks);
+
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+
+    // Events per thread ring; applies to threads that have not recorded yet
+    static void setRingCapacity(size_t events);
+
+    // How many exited threads' rings stay in dumps (default 8)
+    static void setRetainedExitedRings(size_t rings);
+
+    // Forget every event recorded so far and every exited thread's ring
+    static void reset();
+
+    // Label for the calling thread's track in the trace
+    static void setThreadName(const std::string& name);
+
+    // Stable small id for a symbol; takes a lock, so resolve once and cache
+    static uint32_t internSymbol(const std::string& symbol);
+
+    // Spans that ended within the last `lastSeconds`
+    static void dumpChromeTrace(std::ostream& out, double lastSeconds);
+    static bool dumpChromeTrace(const std::string& path, double lastSeconds);
+};
+
+#endif // MATCHING_ENGINE_TRACER_HPP
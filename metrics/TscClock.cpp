@@ -0,0 +1,31 @@
+#include "TscClock.hpp"
+#include <chrono>
+
+namespace {
+
+double calibrate() {
+#ifdef MATCHING_ENGINE_HAS_RDTSC
+    using Clock = std::chrono::steady_clock;
+    auto wallStart = Clock::now();
+    uint64_t tscStart = TscClock::now();
+
+    while (Clock::now() - wallStart < std::chrono::milliseconds(10)) {
+    }
+
+    uint64_t tscEnd = TscClock::now();
+    auto wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - wallStart).count();
+    if (tscEnd <= tscStart) {
+        return 1.0;
+    }
+    return static_cast<double>(wallNanos) / static_cast<double>(tscEnd - tscStart);
+#else
+    return 1.0;
+#endif
+}
+
+} // namespace
+
+double TscClock::nanosPerTick() {
+    static const double value = calibrate();
+    return value;
+}
@@ -0,0 +1,36 @@
+#ifndef MATCHING_ENGINE_TSCCLOCK_HPP
+#define MATCHING_ENGINE_TSCCLOCK_HPP
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MATCHING_ENGINE_HAS_RDTSC 1
+#else
+#include <chrono>
+#endif
+
+// Cheap timestamp source for latency instrumentation. On x86 this reads the
+// time-stamp counter (~20 cycles, no syscall); elsewhere it falls back to
+// steady_clock nanoseconds. Ticks are only meaningful as differences and
+// are converted with toNanos(), which is calibrated once per process.
+class TscClock {
+public:
+    static uint64_t now() {
+#ifdef MATCHING_ENGINE_HAS_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static uint64_t toNanos(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * nanosPerTick());
+    }
+
+    // Measured against steady_clock on first use (takes ~10ms)
+    static double nanosPerTick();
+};
+
+#endif // MATCHING_ENGINE_TSCCLOCK_HPP
@@ -3,10 +3,13 @@
 //
 
 #include "Order.hpp"
+#include <algorithm>
 #include <sstream>
 
-Order::Order(const std::string& id, const std::string& symbol, OrderSide side, double price, int quantity)
-    : id(id), symbol(symbol), side(side), price(price), quantity(quantity), timestamp(std::chrono::system_clock::now()) {
+Order::Order(const std::string& id, const std::string& symbol, OrderSide side, double price, int quantity,
+             OrderType type, TimeInForce timeInForce, const std::string& ownerId)
+    : price(price), stopPrice(0.0), quantity(quantity), displayQuantity(0), hiddenQuantity(0), side(side), type(type),
+      timeInForce(timeInForce), id(id), symbol(symbol), ownerId(ownerId), timestamp(std::chrono::system_clock::now()) {
 }
 
 const std::string& Order::getId() const {
@@ -17,6 +20,10 @@ const std::string& Order::getSymbol() const {
     return symbol;
 }
 
+const std::string& Order::getOwnerId() const {
+    return ownerId;
+}
+
 OrderSide Order::getSide() const {
     return side;
 }
@@ -29,6 +36,30 @@ int Order::getQuantity() const {
     return quantity;
 }
 
+OrderType Order::getType() const {
+    return type;
+}
+
+TimeInForce Order::getTimeInForce() const {
+    return timeInForce;
+}
+
+double Order::getStopPrice() const {
+    return stopPrice;
+}
+
+int Order::getDisplayQuantity() const {
+    return displayQuantity;
+}
+
+int Order::getHiddenQuantity() const {
+    return hiddenQuantity;
+}
+
+int Order::getTotalQuantity() const {
+    return quantity + hiddenQuantity;
+}
+
 const std::chrono::time_point<std::chrono::system_clock>& Order::getTimestamp() const {
     return timestamp;
 }
@@ -37,6 +68,19 @@ void Order::setQuantity(int newQuantity) {
     quantity = newQuantity;
 }
 
+void Order::setPrice(double newPrice) {
+    price = newPrice;
+}
+
+void Order::setTotalQuantity(int newTotalQuantity) {
+    if (isIceberg() && newTotalQuantity >= quantity) {
+        hiddenQuantity = newTotalQuantity - quantity;
+    } else {
+        quantity = newTotalQuantity;
+        hiddenQuantity = 0;
+    }
+}
+
 bool Order::isBuy() const {
     return side == OrderSide::BUY;
 }
@@ -45,6 +89,54 @@ bool Order::isSell() const {
     return side == OrderSide::SELL;
 }
 
+bool Order::isMarket() const {
+    return type == OrderType::MARKET;
+}
+
+bool Order::isStop() const {
+    return type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+}
+
+void Order::elect() {
+    if (type == OrderType::STOP) {
+        type = OrderType::MARKET;
+    } else if (type == OrderType::STOP_LIMIT) {
+        type = OrderType::LIMIT;
+    }
+}
+
+bool Order::isTriggeredBy(double lastTradePrice) const {
+    return isBuy() ? lastTradePrice >= stopPrice : lastTradePrice <= stopPrice;
+}
+
+void Order::setStopPrice(double newStopPrice) {
+    stopPrice = newStopPrice;
+}
+
+void Order::setDisplayQuantity(int newDisplayQuantity) {
+    int total = getTotalQuantity();
+    displayQuantity = newDisplayQuantity;
+    quantity = std::min(displayQuantity, total);
+    hiddenQuantity = total - quantity;
+}
+
+bool Order::isIceberg() const {
+    return displayQuantity > 0;
+}
+
+bool Order::replenish() {
+    if (quantity > 0 || hiddenQuantity <= 0) {
+        return false;
+    }
+    quantity = std::min(displayQuantity, hiddenQuantity);
+    hiddenQuantity -= quantity;
+    return true;
+}
+
+bool Order::canRest() const {
+    return type == OrderType::LIMIT && (timeInForce == TimeInForce::GTC || timeInForce == TimeInForce::DAY);
+}
+
 std::string Order::toString() const {
     std::stringstream ss;
     ss << "Order{id='" << id << "', symbol='" << symbol << "', side=";
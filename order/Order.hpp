@@ -13,28 +13,92 @@ enum class OrderSide {
     SELL
 };
 
+enum class OrderType {
+    LIMIT,
+    MARKET,     // takes any price; never rests
+    STOP,       // becomes a MARKET order once the stop price trades
+    STOP_LIMIT  // becomes a LIMIT order once the stop price trades
+};
+
+enum class TimeInForce {
+    GTC,  // rests until filled or cancelled
+    DAY,  // rests until filled, cancelled or the end of the trading day
+    IOC,  // fills what it can immediately, the rest is cancelled
+    FOK   // fills completely and immediately or not at all
+};
+
 class Order {
 private:
-    std::string id;
-    std::string symbol;
-    OrderSide side;
+    // Fields the match loop reads come first so they share a cache line with
+    // the shared_ptr control block; ids and the timestamp follow
     double price;
+    double stopPrice;
     int quantity;
+    int displayQuantity;  // iceberg peak size, 0 for a fully visible order
+    int hiddenQuantity;   // iceberg reserve not yet shown
+    OrderSide side;
+    OrderType type;
+    TimeInForce timeInForce;
+
+    std::string id;
+    std::string symbol;
+    std::string ownerId;  // submitting participant or session, "" if unowned
     std::chrono::time_point<std::chrono::system_clock> timestamp;
 
 public:
-    Order(const std::string& id, const std::string& symbol, OrderSide side, double price, int quantity);
+    Order(const std::string& id, const std::string& symbol, OrderSide side, double price, int quantity,
+          OrderType type = OrderType::LIMIT, TimeInForce timeInForce = TimeInForce::GTC,
+          const std::string& ownerId = "");
 
     const std::string& getId() const;
     const std::string& getSymbol() const;
+    const std::string& getOwnerId() const;
     OrderSide getSide() const;
     double getPrice() const;
     int getQuantity() const;
+    OrderType getType() const;
+    TimeInForce getTimeInForce() const;
+    double getStopPrice() const;
+    int getDisplayQuantity() const;
+    int getHiddenQuantity() const;
+
+    // Visible plus hidden quantity still to fill
+    int getTotalQuantity() const;
     const std::chrono::time_point<std::chrono::system_clock>& getTimestamp() const;
 
     void setQuantity(int newQuantity);
+    void setPrice(double newPrice);
+
+    // Set the quantity still to fill. An iceberg keeps its displayed slice
+    // and absorbs the change in its reserve until the reserve runs out.
+    void setTotalQuantity(int newTotalQuantity);
     bool isBuy() const;
     bool isSell() const;
+    bool isMarket() const;
+
+    // A STOP / STOP_LIMIT order that has not been triggered yet
+    bool isStop() const;
+
+    // Trigger a stop: STOP becomes MARKET and STOP_LIMIT becomes LIMIT
+    void elect();
+
+    // Whether `lastTradePrice` triggers this stop. Buy stops trigger at or
+    // above the stop price, sell stops at or below it.
+    bool isTriggeredBy(double lastTradePrice) const;
+
+    void setStopPrice(double newStopPrice);
+
+    // Make this an iceberg showing at most `newDisplayQuantity` at a time;
+    // the rest of the current quantity becomes hidden reserve
+    void setDisplayQuantity(int newDisplayQuantity);
+    bool isIceberg() const;
+
+    // Refill an exhausted visible slice from the reserve. Returns false if
+    // there is nothing to refill or the slice is not empty yet.
+    bool replenish();
+
+    // Whether an unfilled remainder goes on the book (GTC / DAY limits)
+    bool canRest() const;
     std::string toString() const;
 };
 
@@ -3,9 +3,41 @@
 //
 
 #include "OrderBook.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
+namespace {
+
+template <typename Levels>
+::std::vector<::std::shared_ptr<Order>> flattenLevels(const Levels& levels) {
+    ::std::vector<::std::shared_ptr<Order>> orders;
+    for (const auto& [price, level] : levels) {
+        orders.insert(orders.end(), level.orders.begin(), level.orders.end());
+    }
+    return orders;
+}
+
+template <typename Levels>
+int levelSize(const Levels& levels, double price) {
+    auto it = levels.find(price);
+    return it == levels.end() ? 0 : it->second.totalQuantity;
+}
+
+template <typename Levels>
+int matchableQuantity(const Levels& levels, const Order& incoming) {
+    int available = 0;
+    for (const auto& [price, level] : levels) {
+        if (available >= incoming.getTotalQuantity() || !OrderBook::crosses(incoming, price)) {
+            break;
+        }
+        available += level.totalQuantity + level.hiddenQuantity;
+    }
+    return available;
+}
+
+} // namespace
+
 OrderBook::OrderBook(const ::std::string& symbol) : symbol(symbol) {
 }
 
@@ -18,106 +50,280 @@ bool OrderBook::addOrder(::std::shared_ptr<Order> order) {
         return false;
     }
 
-    if (ordersSortedById.find(order->getId()) != ordersSortedById.end()) {
+    if (ordersById.find(order->getId()) != ordersById.end()) {
         return false;
     }
 
-    ordersSortedById[order->getId()] = order;
-
+    PriceLevel* level;
     if (order->isBuy()) {
-        buyOrders.insert(order);
+        level = &bidLevels[order->getPrice()];
     } else {
-        sellOrders.insert(order);
+        level = &askLevels[order->getPrice()];
+    }
+    level->price = order->getPrice();
+    level->totalQuantity += order->getQuantity();
+    level->hiddenQuantity += order->getHiddenQuantity();
+    OrderEntry entry{order, level->orders.insert(level->orders.end(), order), {}};
+    if (!order->getOwnerId().empty()) {
+        OrderList& owned = ordersByOwner[order->getOwnerId()];
+        entry.ownerPosition = owned.insert(owned.end(), order);
     }
 
+    ordersById.emplace(order->getId(), entry);
     return true;
 }
 
-bool OrderBook::cancelOrder(const ::std::string& orderId) {
-    auto it = ordersSortedById.find(orderId);
-    if (it == ordersSortedById.end()) {
+template <typename Levels>
+void OrderBook::removeFromLevels(Levels& levels, const OrderEntry& entry) {
+    auto levelIt = levels.find(entry.order->getPrice());
+    if (levelIt == levels.end()) {
+        return;
+    }
+
+    PriceLevel& level = levelIt->second;
+    level.totalQuantity -= entry.order->getQuantity();
+    level.hiddenQuantity -= entry.order->getHiddenQuantity();
+    level.orders.erase(entry.position);
+    if (level.orders.empty()) {
+        levels.erase(levelIt);
+    }
+}
+
+template <typename Levels>
+void OrderBook::relinkOrder(Levels& levels, OrderEntry& entry, double newPrice, int newQuantity) {
+    auto oldLevelIt = levels.find(entry.order->getPrice());
+    if (oldLevelIt == levels.end()) {
+        return;
+    }
+
+    PriceLevel& oldLevel = oldLevelIt->second;
+    oldLevel.totalQuantity -= entry.order->getQuantity();
+    oldLevel.hiddenQuantity -= entry.order->getHiddenQuantity();
+
+    entry.order->setPrice(newPrice);
+    entry.order->setTotalQuantity(newQuantity);
+
+    PriceLevel& newLevel = levels[newPrice];
+    newLevel.price = newPrice;
+    newLevel.totalQuantity += entry.order->getQuantity();
+    newLevel.hiddenQuantity += entry.order->getHiddenQuantity();
+    newLevel.orders.splice(newLevel.orders.end(), oldLevel.orders, entry.position);
+
+    if (oldLevel.orders.empty()) {
+        levels.erase(oldLevelIt);
+    }
+}
+
+bool OrderBook::resizeOrder(const ::std::string& orderId, int newQuantity) {
+    auto it = ordersById.find(orderId);
+    if (it == ordersById.end() || newQuantity <= 0) {
         return false;
     }
 
-    auto order = it->second;
-    ordersSortedById.erase(it);
+    auto& order = it->second.order;
+    if (newQuantity < order->getTotalQuantity()) {
+        PriceLevel& level = order->isBuy() ? bidLevels[order->getPrice()] : askLevels[order->getPrice()];
+        level.totalQuantity -= order->getQuantity();
+        level.hiddenQuantity -= order->getHiddenQuantity();
+        order->setTotalQuantity(newQuantity);
+        level.totalQuantity += order->getQuantity();
+        level.hiddenQuantity += order->getHiddenQuantity();
+        return true;
+    }
 
-    if (order->isBuy()) {
-        buyOrders.erase(order);
+    return repriceOrder(orderId, order->getPrice(), newQuantity);
+}
+
+bool OrderBook::repriceOrder(const ::std::string& orderId, double newPrice, int newQuantity) {
+    auto it = ordersById.find(orderId);
+    if (it == ordersById.end() || newQuantity <= 0) {
+        return false;
+    }
+
+    if (it->second.order->isBuy()) {
+        relinkOrder(bidLevels, it->second, newPrice, newQuantity);
+    } else {
+        relinkOrder(askLevels, it->second, newPrice, newQuantity);
+    }
+    return true;
+}
+
+bool OrderBook::cancelOrder(const ::std::string& orderId) {
+    auto it = ordersById.find(orderId);
+    if (it == ordersById.end()) {
+        return false;
+    }
+
+    if (it->second.order->isBuy()) {
+        removeFromLevels(bidLevels, it->second);
     } else {
-        sellOrders.erase(order);
+        removeFromLevels(askLevels, it->second);
+    }
+
+    const ::std::string& ownerId = it->second.order->getOwnerId();
+    if (!ownerId.empty()) {
+        auto ownerIt = ordersByOwner.find(ownerId);
+        ownerIt->second.erase(it->second.ownerPosition);
+        if (ownerIt->second.empty()) {
+            ordersByOwner.erase(ownerIt);
+        }
     }
+    ordersById.erase(it);
 
     return true;
 }
 
 ::std::shared_ptr<Order> OrderBook::getOrderById(const ::std::string& orderId) const {
-    auto it = ordersSortedById.find(orderId);
-    if (it == ordersSortedById.end()) {
+    auto it = ordersById.find(orderId);
+    if (it == ordersById.end()) {
         return nullptr;
     }
-    return it->second;
+    return it->second.order;
 }
 
 double OrderBook::getBestBidPrice() const {
-    if (buyOrders.empty()) {
+    if (bidLevels.empty()) {
         return 0.0;
     }
-    return (*buyOrders.begin())->getPrice();
+    return bidLevels.begin()->first;
 }
 
 double OrderBook::getBestAskPrice() const {
-    if (sellOrders.empty()) {
+    if (askLevels.empty()) {
         return 0.0;
     }
-    return (*sellOrders.begin())->getPrice();
+    return askLevels.begin()->first;
 }
 
 int OrderBook::getBidSize(double price) const {
-    int size = 0;
-    for (const auto& order : buyOrders) {
-        if (order->getPrice() == price) {
-            size += order->getQuantity();
-        } else if (order->getPrice() < price) {
-            break;
-        }
-    }
-    return size;
+    return levelSize(bidLevels, price);
 }
 
 int OrderBook::getAskSize(double price) const {
-    int size = 0;
-    for (const auto& order : sellOrders) {
-        if (order->getPrice() == price) {
-            size += order->getQuantity();
-        } else if (order->getPrice() > price) {
-            break;
+    return levelSize(askLevels, price);
+}
+
+::std::shared_ptr<Order> OrderBook::getBestOrder(OrderSide side) const {
+    if (side == OrderSide::BUY) {
+        return bidLevels.empty() ? nullptr : bidLevels.begin()->second.orders.front();
+    }
+    return askLevels.empty() ? nullptr : askLevels.begin()->second.orders.front();
+}
+
+const PriceLevel* OrderBook::getBestLevel(OrderSide side) const {
+    if (side == OrderSide::BUY) {
+        return bidLevels.empty() ? nullptr : &bidLevels.begin()->second;
+    }
+    return askLevels.empty() ? nullptr : &askLevels.begin()->second;
+}
+
+void OrderBook::fillOrder(const ::std::shared_ptr<Order>& order, int quantity) {
+    auto it = ordersById.find(order->getId());
+    if (it == ordersById.end()) {
+        return;
+    }
+
+    if (quantity >= order->getQuantity() && order->getHiddenQuantity() == 0) {
+        cancelOrder(order->getId());
+        order->setQuantity(0);
+        return;
+    }
+
+    PriceLevel& level = order->isBuy() ? bidLevels[order->getPrice()] : askLevels[order->getPrice()];
+    quantity = ::std::min(quantity, order->getQuantity());
+    level.totalQuantity -= quantity;
+    order->setQuantity(order->getQuantity() - quantity);
+
+    if (order->replenish()) {
+        // New slice, new time priority: relink the node at the back
+        level.totalQuantity += order->getQuantity();
+        level.hiddenQuantity -= order->getQuantity();
+        level.orders.splice(level.orders.end(), level.orders, it->second.position);
+    }
+}
+
+int OrderBook::getMatchableQuantity(const Order& incoming) const {
+    if (incoming.isBuy()) {
+        return matchableQuantity(askLevels, incoming);
+    }
+    return matchableQuantity(bidLevels, incoming);
+}
+
+::std::vector<::std::shared_ptr<Order>> OrderBook::expireDayOrders() {
+    ::std::vector<::std::shared_ptr<Order>> expired;
+    for (const auto& [id, entry] : ordersById) {
+        if (entry.order->getTimeInForce() == TimeInForce::DAY) {
+            expired.push_back(entry.order);
         }
     }
-    return size;
+    for (const auto& order : expired) {
+        cancelOrder(order->getId());
+    }
+    return expired;
+}
+
+::std::vector<::std::shared_ptr<Order>> OrderBook::cancelOwnerOrders(const ::std::string& ownerId) {
+    auto ownerIt = ordersByOwner.find(ownerId);
+    if (ownerId.empty() || ownerIt == ordersByOwner.end()) {
+        return {};
+    }
+
+    ::std::vector<::std::shared_ptr<Order>> cancelled(ownerIt->second.begin(), ownerIt->second.end());
+    for (const auto& order : cancelled) {
+        cancelOrder(order->getId());
+    }
+    return cancelled;
+}
+
+::std::vector<::std::shared_ptr<Order>> OrderBook::cancelAllOrders() {
+    ::std::vector<::std::shared_ptr<Order>> cancelled;
+    cancelled.reserve(ordersById.size());
+    for (const auto& [id, entry] : ordersById) {
+        cancelled.push_back(entry.order);
+    }
+    bidLevels.clear();
+    askLevels.clear();
+    ordersById.clear();
+    ordersByOwner.clear();
+    return cancelled;
+}
+
+bool OrderBook::crosses(const Order& incoming, double restingPrice) {
+    if (incoming.isMarket()) {
+        return true;
+    }
+    return incoming.isBuy() ? incoming.getPrice() >= restingPrice : incoming.getPrice() <= restingPrice;
 }
 
 ::std::string OrderBook::getSymbol() const {
     return symbol;
 }
 
+const OrderBook::BidLevels& OrderBook::getBidLevels() const {
+    return bidLevels;
+}
+
+const OrderBook::AskLevels& OrderBook::getAskLevels() const {
+    return askLevels;
+}
+
 ::std::vector<::std::shared_ptr<Order>> OrderBook::getAllBuyOrders() const {
-    return ::std::vector<::std::shared_ptr<Order>>(buyOrders.begin(), buyOrders.end());
+    return flattenLevels(bidLevels);
 }
 
 ::std::vector<::std::shared_ptr<Order>> OrderBook::getAllSellOrders() const {
-    return ::std::vector<::std::shared_ptr<Order>>(sellOrders.begin(), sellOrders.end());
+    return flattenLevels(askLevels);
 }
 
 ::std::string OrderBook::toString() const {
     ::std::stringstream ss;
     ss << "OrderBook for " << symbol << ":" << ::std::endl;
     ss << "Buy Orders:" << ::std::endl;
-    for (const auto& order : buyOrders) {
+    for (const auto& order : getAllBuyOrders()) {
         ss << "  " << order->toString() << ::std::endl;
     }
     ss << "Sell Orders:" << ::std::endl;
-    for (const auto& order : sellOrders) {
+    for (const auto& order : getAllSellOrders()) {
         ss << "  " << order->toString() << ::std::endl;
     }
     return ss.str();
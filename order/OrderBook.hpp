@@ -6,26 +6,51 @@
 #define MATCHING_ENGINE_ORDERBOOK_H
 
 #include "Order.hpp"
+#include <functional>
+#include <list>
 #include <map>
-#include <set>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <memory>
 
-struct BuyComparator {
-    bool operator()(const ::std::shared_ptr<Order>& lhs, const ::std::shared_ptr<Order>& rhs) const;
-};
-
-struct SellComparator {
-    bool operator()(const ::std::shared_ptr<Order>& lhs, const ::std::shared_ptr<Order>& rhs) const;
+// Resting orders at one price in time priority. totalQuantity is the
+// displayed size; iceberg reserves are summed separately.
+struct PriceLevel {
+    double price;
+    int totalQuantity = 0;
+    int hiddenQuantity = 0;
+    ::std::list<::std::shared_ptr<Order>> orders;
 };
 
 class OrderBook {
+public:
+    using BidLevels = ::std::map<double, PriceLevel, ::std::greater<double>>;
+    using AskLevels = ::std::map<double, PriceLevel>;
+
 private:
+    using OrderList = ::std::list<::std::shared_ptr<Order>>;
+
+    // ownerPosition is only set for orders with an owner
+    struct OrderEntry {
+        ::std::shared_ptr<Order> order;
+        OrderList::iterator position;
+        OrderList::iterator ownerPosition;
+    };
+
     ::std::string symbol;
-    ::std::set<::std::shared_ptr<Order>, BuyComparator> buyOrders;
-    ::std::set<::std::shared_ptr<Order>, SellComparator> sellOrders;
-    ::std::map<::std::string, ::std::shared_ptr<Order>> ordersSortedById;
+    // Only populated prices are stored, so the best level is always begin()
+    // and emptying it never scans vacant ticks
+    BidLevels bidLevels;
+    AskLevels askLevels;
+    ::std::unordered_map<::std::string, OrderEntry> ordersById;
+    ::std::unordered_map<::std::string, OrderList> ordersByOwner;
+
+    template <typename Levels>
+    void removeFromLevels(Levels& levels, const OrderEntry& entry);
+
+    template <typename Levels>
+    void relinkOrder(Levels& levels, OrderEntry& entry, double newPrice, int newQuantity);
 
 public:
     explicit OrderBook(const ::std::string& symbol);
@@ -39,11 +64,52 @@ public:
     int getBidSize(double price) const;
     int getAskSize(double price) const;
 
+    // Oldest order at the best price on `side`, or nullptr if that side is empty
+    ::std::shared_ptr<Order> getBestOrder(OrderSide side) const;
+
+    // Best price level on `side`, or nullptr if that side is empty
+    const PriceLevel* getBestLevel(OrderSide side) const;
+
+    // Take `quantity` off a resting order's visible slice. An exhausted
+    // iceberg refills from its reserve and moves to the back of its level;
+    // anything else is removed once nothing is left.
+    void fillOrder(const ::std::shared_ptr<Order>& order, int quantity);
+
+    // Change a resting order's total quantity in place. A decrease keeps
+    // its queue position; an increase sends it to the back of its level.
+    bool resizeOrder(const ::std::string& orderId, int newQuantity);
+
+    // Move a resting order to the back of the `newPrice` level with a new
+    // total quantity. The list node is relinked, not reallocated. The
+    // caller makes sure the new price does not cross the other side.
+    bool repriceOrder(const ::std::string& orderId, double newPrice, int newQuantity);
+
+    // Resting quantity, hidden reserves included, that `incoming` could
+    // trade against right now, capped once it covers the incoming total
+    int getMatchableQuantity(const Order& incoming) const;
+
+    // Remove every DAY order and return them
+    ::std::vector<::std::shared_ptr<Order>> expireDayOrders();
+
+    // Remove every order `ownerId` has resting and return them. Walks only
+    // that owner's orders.
+    ::std::vector<::std::shared_ptr<Order>> cancelOwnerOrders(const ::std::string& ownerId);
+
+    // Remove every resting order and return them
+    ::std::vector<::std::shared_ptr<Order>> cancelAllOrders();
+
     ::std::string getSymbol() const;
+
+    // Price levels best first: bids descending, asks ascending
+    const BidLevels& getBidLevels() const;
+    const AskLevels& getAskLevels() const;
     ::std::vector<::std::shared_ptr<Order>> getAllBuyOrders() const;
     ::std::vector<::std::shared_ptr<Order>> getAllSellOrders() const;
 
     ::std::string toString() const;
+
+    // Whether `incoming` is willing to trade at `restingPrice`
+    static bool crosses(const Order& incoming, double restingPrice);
 };
 
-#endif // MATCHING_ENGINE_ORDERBOOK_H
\ No newline at end of file
+#endif // MATCHING_ENGINE_ORDERBOOK_H
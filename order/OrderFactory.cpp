@@ -3,7 +3,8 @@
 //
 
 #include "OrderFactory.hpp"
-#include <iostream>
+#include "../logging/AsyncLogger.hpp"
+#include <cmath>
 
 int OrderFactory::orderIdCounter = 0;
 
@@ -12,13 +13,15 @@ std::string OrderFactory::generateOrderId() {
 }
 
 bool OrderFactory::validateOrderParameters(const std::string& symbol, OrderSide side, double price, int quantity) {
-    if (price < 0) {
-        std::cerr << "Invalid price: " << price << std::endl;
+    // Only priced order types come through here; a zero price would rest
+    // where every incoming order crosses it but no trade can print
+    if (!std::isfinite(price) || price <= 0) {
+        LOG_ERROR("Invalid price: {}", price);
         return false;
     }
 
     if (quantity <= 0) {
-        std::cerr << "Invalid quantity: " << quantity << std::endl;
+        LOG_ERROR("Invalid quantity: {}", quantity);
         return false;
     }
 
@@ -26,18 +29,67 @@ bool OrderFactory::validateOrderParameters(const std::string& symbol, OrderSide
 }
 
 std::shared_ptr<Order> OrderFactory::createLimitOrder(const std::string& symbol, OrderSide side, double price, int quantity, const std::string& callerId) {
+    return createLimitOrder(symbol, side, price, quantity, TimeInForce::GTC, callerId);
+}
+
+std::shared_ptr<Order> OrderFactory::createMarketOrder(const std::string& symbol, OrderSide side, int quantity, const std::string& callerId) {
+    return createMarketOrder(symbol, side, quantity, TimeInForce::IOC, callerId);
+}
+
+std::shared_ptr<Order> OrderFactory::createLimitOrder(const std::string& symbol, OrderSide side, double price, int quantity, TimeInForce timeInForce, const std::string& callerId) {
     if (!validateOrderParameters(symbol, side, price, quantity)) {
         return nullptr;
     }
 
-    return std::make_shared<Order>(generateOrderId(), symbol, side, price, quantity);
+    return std::make_shared<Order>(generateOrderId(), symbol, side, price, quantity, OrderType::LIMIT, timeInForce, callerId);
 }
 
-std::shared_ptr<Order> OrderFactory::createMarketOrder(const std::string& symbol, OrderSide side, int quantity, const std::string& callerId) {
+std::shared_ptr<Order> OrderFactory::createMarketOrder(const std::string& symbol, OrderSide side, int quantity, TimeInForce timeInForce, const std::string& callerId) {
     if (quantity <= 0) {
-        std::cerr << "Invalid quantity: " << quantity << std::endl;
+        LOG_ERROR("Invalid quantity: {}", quantity);
         return nullptr;
     }
 
-    return std::make_shared<Order>(generateOrderId(), symbol, side, 0.0, quantity);
-}
\ No newline at end of file
+    if (timeInForce != TimeInForce::IOC && timeInForce != TimeInForce::FOK) {
+        LOG_ERROR("Market orders must be IOC or FOK");
+        return nullptr;
+    }
+
+    return std::make_shared<Order>(generateOrderId(), symbol, side, 0.0, quantity, OrderType::MARKET, timeInForce, callerId);
+}
+
+std::shared_ptr<Order> OrderFactory::createStopOrder(const std::string& symbol, OrderSide side, double stopPrice, int quantity, const std::string& callerId) {
+    if (!validateOrderParameters(symbol, side, stopPrice, quantity)) {
+        return nullptr;
+    }
+
+    auto order = std::make_shared<Order>(generateOrderId(), symbol, side, 0.0, quantity, OrderType::STOP, TimeInForce::IOC, callerId);
+    order->setStopPrice(stopPrice);
+    return order;
+}
+
+std::shared_ptr<Order> OrderFactory::createStopLimitOrder(const std::string& symbol, OrderSide side, double stopPrice, double limitPrice, int quantity, TimeInForce timeInForce, const std::string& callerId) {
+    if (!validateOrderParameters(symbol, side, stopPrice, quantity) ||
+        !validateOrderParameters(symbol, side, limitPrice, quantity)) {
+        return nullptr;
+    }
+
+    auto order = std::make_shared<Order>(generateOrderId(), symbol, side, limitPrice, quantity, OrderType::STOP_LIMIT, timeInForce, callerId);
+    order->setStopPrice(stopPrice);
+    return order;
+}
+
+std::shared_ptr<Order> OrderFactory::createIcebergOrder(const std::string& symbol, OrderSide side, double price, int quantity, int displayQuantity, TimeInForce timeInForce, const std::string& callerId) {
+    if (!validateOrderParameters(symbol, side, price, quantity)) {
+        return nullptr;
+    }
+
+    if (displayQuantity <= 0 || displayQuantity > quantity) {
+        LOG_ERROR("Invalid display quantity: {}", displayQuantity);
+        return nullptr;
+    }
+
+    auto order = std::make_shared<Order>(generateOrderId(), symbol, side, price, quantity, OrderType::LIMIT, timeInForce, callerId);
+    order->setDisplayQuantity(displayQuantity);
+    return order;
+}
@@ -13,6 +13,22 @@ class OrderFactory {
 public:
     static std::shared_ptr<Order> createLimitOrder(const std::string& symbol, OrderSide side, double price, int quantity, const std::string& callerId="");
     static std::shared_ptr<Order> createMarketOrder(const std::string& symbol, OrderSide side, int quantity, const std::string& callerId="");
+
+    // Same as above with an explicit time in force. Market orders only
+    // accept IOC (the default) or FOK.
+    static std::shared_ptr<Order> createLimitOrder(const std::string& symbol, OrderSide side, double price, int quantity, TimeInForce timeInForce, const std::string& callerId="");
+    static std::shared_ptr<Order> createMarketOrder(const std::string& symbol, OrderSide side, int quantity, TimeInForce timeInForce, const std::string& callerId="");
+
+    // Parked until a trade at or through `stopPrice` (at or above it for a
+    // buy, at or below for a sell), then entered as a market order
+    static std::shared_ptr<Order> createStopOrder(const std::string& symbol, OrderSide side, double stopPrice, int quantity, const std::string& callerId="");
+
+    // As above, but entered as a limit order at `limitPrice`
+    static std::shared_ptr<Order> createStopLimitOrder(const std::string& symbol, OrderSide side, double stopPrice, double limitPrice, int quantity, TimeInForce timeInForce = TimeInForce::GTC, const std::string& callerId="");
+
+    // Limit order for `quantity` that shows at most `displayQuantity` on
+    // the book and refills from the hidden reserve as each slice fills
+    static std::shared_ptr<Order> createIcebergOrder(const std::string& symbol, OrderSide side, double price, int quantity, int displayQuantity, TimeInForce timeInForce = TimeInForce::GTC, const std::string& callerId="");
 private:
     static std::string generateOrderId();
     static int orderIdCounter;
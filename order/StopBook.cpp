@@ -0,0 +1,151 @@
+#include "StopBook.hpp"
+
+StopBook::StopBook(const std::string& symbol) : symbol(symbol), lastTradePrice(0.0) {
+}
+
+bool StopBook::addOrder(std::shared_ptr<Order> order) {
+    if (!order || !order->isStop() || order->getSymbol() != symbol) {
+        return false;
+    }
+
+    if (stopsById.find(order->getId()) != stopsById.end()) {
+        return false;
+    }
+
+    StopEntry entry;
+    entry.order = order;
+    if (order->isBuy()) {
+        entry.buyPosition = buyStops.emplace(order->getStopPrice(), order);
+    } else {
+        entry.sellPosition = sellStops.emplace(order->getStopPrice(), order);
+    }
+    if (!order->getOwnerId().empty()) {
+        OrderList& owned = stopsByOwner[order->getOwnerId()];
+        entry.ownerPosition = owned.insert(owned.end(), order);
+    }
+    stopsById.emplace(order->getId(), entry);
+    return true;
+}
+
+bool StopBook::cancelOrder(const std::string& orderId) {
+    auto it = stopsById.find(orderId);
+    if (it == stopsById.end()) {
+        return false;
+    }
+
+    if (it->second.order->isBuy()) {
+        buyStops.erase(it->second.buyPosition);
+    } else {
+        sellStops.erase(it->second.sellPosition);
+    }
+    unlinkOwner(it->second);
+    stopsById.erase(it);
+    return true;
+}
+
+void StopBook::unlinkOwner(const StopEntry& entry) {
+    const std::string& ownerId = entry.order->getOwnerId();
+    if (ownerId.empty()) {
+        return;
+    }
+
+    auto ownerIt = stopsByOwner.find(ownerId);
+    ownerIt->second.erase(entry.ownerPosition);
+    if (ownerIt->second.empty()) {
+        stopsByOwner.erase(ownerIt);
+    }
+}
+
+std::shared_ptr<Order> StopBook::getOrderById(const std::string& orderId) const {
+    auto it = stopsById.find(orderId);
+    if (it == stopsById.end()) {
+        return nullptr;
+    }
+    return it->second.order;
+}
+
+template <typename Stops>
+void StopBook::electCrossed(Stops& stops, double tradePrice) {
+    auto it = stops.begin();
+    while (it != stops.end() && it->second->isTriggeredBy(tradePrice)) {
+        auto order = it->second;
+        auto entryIt = stopsById.find(order->getId());
+        unlinkOwner(entryIt->second);
+        stopsById.erase(entryIt);
+        it = stops.erase(it);
+        electNow(order);
+    }
+}
+
+void StopBook::onTrade(double tradePrice) {
+    lastTradePrice = tradePrice;
+    electCrossed(buyStops, tradePrice);
+    electCrossed(sellStops, tradePrice);
+}
+
+double StopBook::getLastTradePrice() const {
+    return lastTradePrice;
+}
+
+void StopBook::electNow(std::shared_ptr<Order> order) {
+    order->elect();
+    electedOrders.push_back(std::move(order));
+}
+
+std::shared_ptr<Order> StopBook::popElectedOrder() {
+    if (electedOrders.empty()) {
+        return nullptr;
+    }
+
+    auto order = electedOrders.front();
+    electedOrders.pop_front();
+    return order;
+}
+
+std::vector<std::shared_ptr<Order>> StopBook::expireDayOrders() {
+    std::vector<std::shared_ptr<Order>> expired;
+    for (const auto& [price, order] : buyStops) {
+        if (order->getTimeInForce() == TimeInForce::DAY) {
+            expired.push_back(order);
+        }
+    }
+    for (const auto& [price, order] : sellStops) {
+        if (order->getTimeInForce() == TimeInForce::DAY) {
+            expired.push_back(order);
+        }
+    }
+    for (const auto& order : expired) {
+        cancelOrder(order->getId());
+    }
+    return expired;
+}
+
+std::vector<std::shared_ptr<Order>> StopBook::cancelOwnerOrders(const std::string& ownerId) {
+    auto ownerIt = stopsByOwner.find(ownerId);
+    if (ownerId.empty() || ownerIt == stopsByOwner.end()) {
+        return {};
+    }
+
+    std::vector<std::shared_ptr<Order>> cancelled(ownerIt->second.begin(), ownerIt->second.end());
+    for (const auto& order : cancelled) {
+        cancelOrder(order->getId());
+    }
+    return cancelled;
+}
+
+std::vector<std::shared_ptr<Order>> StopBook::cancelAllOrders() {
+    std::vector<std::shared_ptr<Order>> cancelled;
+    cancelled.reserve(stopsById.size());
+    for (const auto& [id, entry] : stopsById) {
+        cancelled.push_back(entry.order);
+    }
+    buyStops.clear();
+    sellStops.clear();
+    stopsById.clear();
+    stopsByOwner.clear();
+    return cancelled;
+}
+
+size_t StopBook::getParkedCount() const {
+    return stopsById.size();
+}
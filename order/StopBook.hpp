@@ -0,0 +1,81 @@
+#ifndef MATCHING_ENGINE_STOPBOOK_HPP
+#define MATCHING_ENGINE_STOPBOOK_HPP
+
+#include "Order.hpp"
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Parked stop and stop-limit orders for one symbol, kept apart from the
+// resting book and indexed by stop price.
+//
+// Buy stops are ordered by ascending stop price and sell stops by
+// descending stop price, so the stops a trade price crosses are always a
+// prefix of their side. onTrade() moves exactly that prefix to the elected
+// queue in O(k log n) for k triggered orders; nothing else is visited.
+// Elected orders leave in trigger order: the side's stop price nearest the
+// old price first, then time priority within a price.
+class StopBook {
+public:
+    explicit StopBook(const std::string& symbol);
+
+    bool addOrder(std::shared_ptr<Order> order);
+    bool cancelOrder(const std::string& orderId);
+    std::shared_ptr<Order> getOrderById(const std::string& orderId) const;
+
+    // Record a trade price and elect every stop it crosses
+    void onTrade(double tradePrice);
+
+    // 0.0 until the first trade
+    double getLastTradePrice() const;
+
+    // Queue a stop for entry without parking it (its trigger already traded)
+    void electNow(std::shared_ptr<Order> order);
+
+    // Next elected order, already converted by Order::elect(), or nullptr
+    std::shared_ptr<Order> popElectedOrder();
+
+    // Remove every parked DAY stop and return them
+    std::vector<std::shared_ptr<Order>> expireDayOrders();
+
+    // Remove every stop `ownerId` has parked and return them
+    std::vector<std::shared_ptr<Order>> cancelOwnerOrders(const std::string& ownerId);
+
+    // Remove every parked stop and return them
+    std::vector<std::shared_ptr<Order>> cancelAllOrders();
+
+    size_t getParkedCount() const;
+
+private:
+    using BuyStops = std::multimap<double, std::shared_ptr<Order>>;
+    using SellStops = std::multimap<double, std::shared_ptr<Order>, std::greater<double>>;
+    using OrderList = std::list<std::shared_ptr<Order>>;
+
+    // Only the position matching the order's side is set, and ownerPosition
+    // only for orders with an owner
+    struct StopEntry {
+        std::shared_ptr<Order> order;
+        BuyStops::iterator buyPosition;
+        SellStops::iterator sellPosition;
+        OrderList::iterator ownerPosition;
+    };
+
+    template <typename Stops>
+    void electCrossed(Stops& stops, double tradePrice);
+    void unlinkOwner(const StopEntry& entry);
+
+    std::string symbol;
+    BuyStops buyStops;
+    SellStops sellStops;
+    std::unordered_map<std::string, StopEntry> stopsById;
+    std::unordered_map<std::string, OrderList> stopsByOwner;
+    std::deque<std::shared_ptr<Order>> electedOrders;
+    double lastTradePrice;
+};
+
+#endif // MATCHING_ENGINE_STOPBOOK_HPP
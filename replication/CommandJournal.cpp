@@ -0,0 +1,169 @@
+#include "CommandJournal.hpp"
+#include <cstring>
+
+namespace {
+
+using OrderAction = ContinuousMatchingEngine::OrderAction;
+
+constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t length) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+template <typename Value>
+void hashValue(uint64_t& hash, const Value& value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+template <typename Levels>
+void hashLevels(uint64_t& hash, const Levels& levels) {
+    for (const auto& [price, level] : levels) {
+        hashValue(hash, price);
+        for (const auto& order : level.orders) {
+            hashBytes(hash, order->getId().data(), order->getId().size());
+            hashValue(hash, order->getQuantity());
+            hashValue(hash, order->getHiddenQuantity());
+            hashValue(hash, order->getDisplayQuantity());
+        }
+    }
+}
+
+void drainElectedOrders(MatchingEngine& engine, const std::string& symbol) {
+    while (auto elected = engine.popElectedOrder(symbol)) {
+        engine.processOrder(elected);
+    }
+}
+
+} // namespace
+
+JournalEntry makeJournalEntry(const ContinuousMatchingEngine::OrderRequest& request) {
+    JournalEntry entry;
+    entry.action = request.action;
+
+    if (request.action == OrderAction::SUBMIT) {
+        const auto& order = request.order;
+        entry.symbol = order->getSymbol();
+        entry.orderId = order->getId();
+        entry.ownerId = order->getOwnerId();
+        entry.side = order->getSide();
+        entry.type = order->getType();
+        entry.timeInForce = order->getTimeInForce();
+        entry.quantity = order->getTotalQuantity();
+        entry.displayQuantity = order->getDisplayQuantity();
+        entry.price = order->getPrice();
+        entry.stopPrice = order->getStopPrice();
+    } else {
+        entry.symbol = request.symbol;
+        entry.orderId = request.orderId;
+        entry.ownerId = request.ownerId;
+        entry.quantity = request.quantity;
+        entry.price = request.price;
+    }
+    return entry;
+}
+
+void encodeJournalEntry(const JournalEntry& entry, std::string& out) {
+    JournalRecordHeader header{};
+    header.length = static_cast<uint32_t>(sizeof(header) + entry.symbol.size() + entry.orderId.size() + entry.ownerId.size());
+    header.action = static_cast<uint8_t>(entry.action);
+    header.flags = entry.hasChecksum ? JOURNAL_HAS_CHECKSUM : 0;
+    header.side = static_cast<uint8_t>(entry.side);
+    header.type = static_cast<uint8_t>(entry.type);
+    header.timeInForce = static_cast<uint8_t>(entry.timeInForce);
+    header.quantity = entry.quantity;
+    header.displayQuantity = entry.displayQuantity;
+    header.price = entry.price;
+    header.stopPrice = entry.stopPrice;
+    header.bookChecksum = entry.bookChecksum;
+    header.symbolLength = static_cast<uint16_t>(entry.symbol.size());
+    header.orderIdLength = static_cast<uint16_t>(entry.orderId.size());
+    header.ownerIdLength = static_cast<uint16_t>(entry.ownerId.size());
+
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(entry.symbol);
+    out.append(entry.orderId);
+    out.append(entry.ownerId);
+}
+
+bool decodeJournalEntry(const char* data, size_t length, JournalEntry& entry) {
+    if (length < sizeof(JournalRecordHeader)) {
+        return false;
+    }
+
+    JournalRecordHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    size_t stringBytes = static_cast<size_t>(header.symbolLength) + header.orderIdLength + header.ownerIdLength;
+    if (header.length != length || sizeof(header) + stringBytes != length ||
+        header.action > static_cast<uint8_t>(OrderAction::EXPIRE_DAY)) {
+        return false;
+    }
+
+    const char* strings = data + sizeof(header);
+    entry.action = static_cast<OrderAction>(header.action);
+    entry.symbol.assign(strings, header.symbolLength);
+    entry.orderId.assign(strings + header.symbolLength, header.orderIdLength);
+    entry.ownerId.assign(strings + header.symbolLength + header.orderIdLength, header.ownerIdLength);
+    entry.side = static_cast<OrderSide>(header.side);
+    entry.type = static_cast<OrderType>(header.type);
+    entry.timeInForce = static_cast<TimeInForce>(header.timeInForce);
+    entry.quantity = header.quantity;
+    entry.displayQuantity = header.displayQuantity;
+    entry.price = header.price;
+    entry.stopPrice = header.stopPrice;
+    entry.hasChecksum = (header.flags & JOURNAL_HAS_CHECKSUM) != 0;
+    entry.bookChecksum = header.bookChecksum;
+    return true;
+}
+
+void applyJournalEntry(MatchingEngine& engine, const JournalEntry& entry) {
+    switch (entry.action) {
+        case OrderAction::SUBMIT: {
+            auto order = std::make_shared<Order>(entry.orderId, entry.symbol, entry.side, entry.price, entry.quantity,
+                                                 entry.type, entry.timeInForce, entry.ownerId);
+            if (order->isStop()) {
+                order->setStopPrice(entry.stopPrice);
+            }
+            if (entry.displayQuantity > 0) {
+                order->setDisplayQuantity(entry.displayQuantity);
+            }
+            engine.processOrder(order);
+            drainElectedOrders(engine, entry.symbol);
+            break;
+        }
+        case OrderAction::MODIFY: {
+            std::vector<std::shared_ptr<Trade>> trades;
+            engine.modifyOrder(entry.orderId, entry.symbol, entry.price, entry.quantity, trades);
+            drainElectedOrders(engine, entry.symbol);
+            break;
+        }
+        case OrderAction::CANCEL:
+            engine.cancelOrder(entry.orderId, entry.symbol);
+            break;
+        case OrderAction::UNCROSS:
+            engine.uncross(entry.symbol);
+            drainElectedOrders(engine, entry.symbol);
+            break;
+        case OrderAction::MASS_CANCEL:
+            if (entry.ownerId.empty()) {
+                engine.cancelAllOrders(entry.symbol);
+            } else {
+                engine.cancelOwnerOrders(entry.ownerId, entry.symbol);
+            }
+            break;
+        case OrderAction::EXPIRE_DAY:
+            engine.expireDayOrders(entry.symbol);
+            break;
+    }
+}
+
+uint64_t bookChecksum(const OrderBook& book) {
+    uint64_t hash = FNV_OFFSET;
+    hashLevels(hash, book.getBidLevels());
+    hashLevels(hash, book.getAskLevels());
+    return hash;
+}
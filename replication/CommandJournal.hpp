@@ -0,0 +1,98 @@
+#ifndef MATCHING_ENGINE_COMMANDJOURNAL_HPP
+#define MATCHING_ENGINE_COMMANDJOURNAL_HPP
+
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include "../engine/MatchingEngine.hpp"
+#include "../order/OrderBook.hpp"
+#include <cstdint>
+#include <string>
+
+// Binary journal of engine commands, shipped from a primary to a standby.
+//
+// The stream starts with a JournalHello and then carries one record per
+// command: a fixed JournalRecordHeader followed by the symbol, order id and
+// owner id bytes. Records are in host byte order; both ends run on one box.
+// The standby answers with a uint64_t count of applied records whenever it
+// acknowledges.
+
+constexpr uint32_t JOURNAL_MAGIC = 0x4C4E524A; // "JRNL"
+constexpr uint16_t JOURNAL_VERSION = 1;
+
+// Set when bookChecksum holds the symbol's book before this command
+constexpr uint8_t JOURNAL_HAS_CHECKSUM = 0x01;
+
+enum class AckPolicy : uint8_t {
+    NONE,    // the standby never acknowledges
+    ASYNC,   // the standby acknowledges; matching never waits for it
+    BOUNDED  // matching waits while too many commands are unacknowledged
+};
+
+#pragma pack(push, 1)
+
+struct JournalHello {
+    uint32_t magic;
+    uint16_t version;
+    AckPolicy ackPolicy;
+    uint8_t reserved;
+};
+
+struct JournalRecordHeader {
+    uint32_t length;  // whole record, strings included
+    uint8_t action;   // ContinuousMatchingEngine::OrderAction
+    uint8_t flags;
+    uint8_t side;     // SUBMIT order fields
+    uint8_t type;
+    uint8_t timeInForce;
+    uint8_t reserved[3];
+    int32_t quantity;         // SUBMIT total quantity, MODIFY new quantity
+    int32_t displayQuantity;  // SUBMIT iceberg peak, 0 if fully visible
+    double price;             // SUBMIT limit price, MODIFY new price
+    double stopPrice;
+    uint64_t bookChecksum;
+    uint16_t symbolLength;
+    uint16_t orderIdLength;
+    uint16_t ownerIdLength;
+    uint16_t reserved2;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(JournalHello) == 8, "JournalHello layout changed");
+static_assert(sizeof(JournalRecordHeader) == 52, "JournalRecordHeader layout changed");
+
+// A decoded journal record
+struct JournalEntry {
+    ContinuousMatchingEngine::OrderAction action = ContinuousMatchingEngine::OrderAction::SUBMIT;
+    std::string symbol;
+    std::string orderId;
+    std::string ownerId;
+    OrderSide side = OrderSide::BUY;
+    OrderType type = OrderType::LIMIT;
+    TimeInForce timeInForce = TimeInForce::GTC;
+    int quantity = 0;
+    int displayQuantity = 0;
+    double price = 0.0;
+    double stopPrice = 0.0;
+    bool hasChecksum = false;
+    uint64_t bookChecksum = 0;
+};
+
+// Capture a command before the engine applies it (a SUBMIT's order is
+// copied as submitted, not as matching later leaves it)
+JournalEntry makeJournalEntry(const ContinuousMatchingEngine::OrderRequest& request);
+
+// Append the record for `entry` to `out`
+void encodeJournalEntry(const JournalEntry& entry, std::string& out);
+
+// Decode one complete record; false if it is malformed
+bool decodeJournalEntry(const char* data, size_t length, JournalEntry& entry);
+
+// Apply a record to `engine` the way a ContinuousMatchingEngine shard does,
+// including stops the command elects
+void applyJournalEntry(MatchingEngine& engine, const JournalEntry& entry);
+
+// FNV-1a over the resting orders in priority order: price, id and visible,
+// hidden and display quantity. Order timestamps are not included.
+uint64_t bookChecksum(const OrderBook& book);
+
+#endif // MATCHING_ENGINE_COMMANDJOURNAL_HPP
@@ -0,0 +1,170 @@
+#include "ReplicationPrimary.hpp"
+#include "StandbyEngine.hpp"
+#include "../workload/OrderFlowGenerator.hpp"
+#include "../workload/OrderFlowReplayer.hpp"
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// Failover harness: runs a replicated primary in a child process under
+// synthetic load, SIGKILLs it, and promotes the standby in this process.
+//
+// Usage: failover_harness [--socket PATH] [--symbols N] [--threads N]
+//                         [--kill-after-ms N] [--ack-policy none|async|bounded]
+//                         [--checksum-interval N]
+//
+// Reports how many commands the standby applied, how many book checksums it
+// verified, how long it took to notice the primary had gone and how long
+// until the promoted engine had filled its first order. Exits 1 if a
+// checksum mismatched or the takeover failed.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisBetween(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+[[noreturn]] void runPrimary(const std::string& socketPath, size_t symbolCount, size_t numThreads,
+                             const ReplicationConfig& config) {
+    ContinuousMatchingEngine engine(numThreads);
+    for (size_t i = 0; i < symbolCount; ++i) {
+        engine.addSymbol(OrderFlowGenerator::symbolName(i));
+    }
+
+    // The standby is started by the parent after the fork
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (access(socketPath.c_str(), F_OK) != 0 && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ReplicationPrimary primary(engine, config);
+    while (!primary.start(socketPath)) {
+        if (Clock::now() > deadline) {
+            _exit(1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    engine.start();
+
+    OrderFlowConfig flow;
+    flow.symbolCount = symbolCount;
+    OrderFlowGenerator generator(flow);
+    OrderFlowReplayer replayer(engine, flow.orderIdPrefix);
+    while (true) {
+        replayer.submit(generator.next());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string socketPath = "/tmp/matching_engine_standby.sock";
+    size_t symbolCount = 16;
+    size_t numThreads = 4;
+    int killAfterMs = 1000;
+    ReplicationConfig config;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--socket") {
+            socketPath = value;
+        } else if (flag == "--symbols") {
+            symbolCount = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--threads") {
+            numThreads = static_cast<size_t>(std::atoi(value.c_str()));
+        } else if (flag == "--kill-after-ms") {
+            killAfterMs = std::atoi(value.c_str());
+        } else if (flag == "--checksum-interval") {
+            config.checksumInterval = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag == "--ack-policy") {
+            if (value == "none") {
+                config.ackPolicy = AckPolicy::NONE;
+            } else if (value == "async") {
+                config.ackPolicy = AckPolicy::ASYNC;
+            } else if (value == "bounded") {
+                config.ackPolicy = AckPolicy::BOUNDED;
+            } else {
+                std::cerr << "Unknown ack policy: " << value << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    // Fork before any thread exists on either side
+    pid_t primaryPid = fork();
+    if (primaryPid < 0) {
+        std::cerr << "fork failed" << std::endl;
+        return 1;
+    }
+    if (primaryPid == 0) {
+        runPrimary(socketPath, symbolCount, numThreads, config);
+    }
+
+    StandbyEngine standby;
+    for (size_t i = 0; i < symbolCount; ++i) {
+        standby.addSymbol(OrderFlowGenerator::symbolName(i));
+    }
+    if (!standby.start(socketPath)) {
+        kill(primaryPid, SIGKILL);
+        waitpid(primaryPid, nullptr, 0);
+        return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(killAfterMs));
+    auto killTime = Clock::now();
+    kill(primaryPid, SIGKILL);
+
+    if (!standby.waitForPrimaryLoss(std::chrono::seconds(5))) {
+        std::cerr << "Standby did not notice the primary dying" << std::endl;
+        waitpid(primaryPid, nullptr, 0);
+        return 1;
+    }
+    auto detection = Clock::now() - killTime - standby.timeSincePrimaryLoss();
+
+    uint64_t applied = standby.getAppliedCount();
+    uint64_t verified = standby.getChecksumsVerified();
+    uint64_t mismatches = standby.getChecksumMismatches();
+
+    auto engine = standby.promote(numThreads);
+    if (!engine) {
+        std::cerr << "Promotion failed" << std::endl;
+        waitpid(primaryPid, nullptr, 0);
+        return 1;
+    }
+
+    // A crossing pair on the first symbol proves the new primary is matching
+    std::promise<void> filled;
+    std::atomic<bool> signalled{false};
+    engine->registerTradeCallback([&](std::shared_ptr<Trade>) {
+        if (!signalled.exchange(true)) {
+            filled.set_value();
+        }
+    });
+    engine->start();
+    std::string symbol = OrderFlowGenerator::symbolName(0);
+    engine->submitOrder(std::make_shared<Order>("TAKEOVER-S", symbol, OrderSide::SELL, 1.0, 1, OrderType::LIMIT));
+    engine->submitOrder(std::make_shared<Order>("TAKEOVER-B", symbol, OrderSide::BUY, 1.0e9, 1, OrderType::LIMIT));
+    bool traded = filled.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    auto takeover = Clock::now() - killTime;
+    engine->stop();
+
+    waitpid(primaryPid, nullptr, 0);
+
+    std::cout << "Commands applied:     " << applied << std::endl;
+    std::cout << "Checksums verified:   " << verified << std::endl;
+    std::cout << "Checksum mismatches:  " << mismatches << std::endl;
+    std::cout << "Loss detected after:  " << millisBetween(detection) << " ms" << std::endl;
+    std::cout << "First fill after:     " << millisBetween(takeover) << " ms" << std::endl;
+
+    return mismatches == 0 && traded ? 0 : 1;
+}
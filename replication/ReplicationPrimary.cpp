@@ -0,0 +1,256 @@
+#include "ReplicationPrimary.hpp"
+#include "../logging/AsyncLogger.hpp"
+#include "../threading/SymbolThreadPool.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Bound on how long the shipper sleeps with nothing requested
+constexpr auto SHIP_POLL_INTERVAL = std::chrono::milliseconds(1);
+
+bool sendAll(int fd, const char* data, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t sent = send(fd, data + written, length - written, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+} // namespace
+
+ReplicationPrimary::ReplicationPrimary(ContinuousMatchingEngine& engine, const ReplicationConfig& config)
+    : engine(engine),
+      config(config),
+      fd(-1),
+      running(false),
+      connected(false),
+      journaledCount(0),
+      shippedCount(0),
+      ackedCount(0),
+      shipRequested(false) {
+    for (size_t i = 0; i < engine.getNumThreads(); ++i) {
+        shards.push_back(std::make_unique<ShardJournal>());
+    }
+}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+}
+
+bool ReplicationPrimary::start(const std::string& path) {
+    if (running.load()) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("Standby socket path too long: {}", path);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        LOG_ERROR("Cannot reach standby at {}", path);
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        return false;
+    }
+
+    JournalHello hello{JOURNAL_MAGIC, JOURNAL_VERSION, config.ackPolicy, 0};
+    if (!sendAll(fd, reinterpret_cast<const char*>(&hello), sizeof(hello))) {
+        LOG_ERROR("Standby at {} closed during handshake", path);
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    running.store(true);
+    connected.store(true);
+    engine.setCommandListener([this](const ContinuousMatchingEngine::OrderRequest& request, const OrderBook* book) {
+        onCommand(request, book);
+    });
+
+    shipper = std::thread(&ReplicationPrimary::shipLoop, this);
+    if (config.ackPolicy != AckPolicy::NONE) {
+        ackReader = std::thread(&ReplicationPrimary::ackLoop, this);
+    }
+    return true;
+}
+
+void ReplicationPrimary::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shipMutex);
+        shipCondition.notify_one();
+    }
+    if (shipper.joinable()) {
+        shipper.join();
+    }
+
+    // The standby still reads whatever is queued in the socket before EOF
+    shutdown(fd, SHUT_RDWR);
+    if (ackReader.joinable()) {
+        ackReader.join();
+    }
+    close(fd);
+    fd = -1;
+    connected.store(false);
+    engine.setCommandListener(nullptr);
+
+    std::lock_guard<std::mutex> lock(ackMutex);
+    ackCondition.notify_all();
+}
+
+bool ReplicationPrimary::isConnected() const {
+    return connected.load();
+}
+
+uint64_t ReplicationPrimary::getJournaledCount() const {
+    return journaledCount.load();
+}
+
+uint64_t ReplicationPrimary::getShippedCount() const {
+    return shippedCount.load();
+}
+
+uint64_t ReplicationPrimary::getAckedCount() const {
+    return ackedCount.load();
+}
+
+bool ReplicationPrimary::waitForAcks(std::chrono::milliseconds timeout) {
+    if (config.ackPolicy == AckPolicy::NONE) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(ackMutex);
+    return ackCondition.wait_for(lock, timeout, [this] {
+        return !connected.load() || ackedCount.load() >= journaledCount.load();
+    }) && connected.load();
+}
+
+void ReplicationPrimary::onCommand(const ContinuousMatchingEngine::OrderRequest& request, const OrderBook* book) {
+    int shard = SymbolThreadPool::getCurrentThreadIndex();
+    if (!connected.load(std::memory_order_relaxed) || shard < 0 || static_cast<size_t>(shard) >= shards.size()) {
+        return;
+    }
+    auto& journal = *shards[shard];
+
+    JournalEntry entry = makeJournalEntry(request);
+    uint64_t commandNumber = ++journal.symbolCommands[entry.symbol];
+    if (config.checksumInterval > 0 && book && commandNumber % config.checksumInterval == 0) {
+        entry.hasChecksum = true;
+        entry.bookChecksum = bookChecksum(*book);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(journal.mutex);
+        encodeJournalEntry(entry, journal.pending);
+        ++journal.pendingCount;
+    }
+    uint64_t journaled = journaledCount.fetch_add(1) + 1;
+
+    // Only the first request since the last drain needs to wake the shipper
+    if (!shipRequested.exchange(true)) {
+        std::lock_guard<std::mutex> lock(shipMutex);
+        shipCondition.notify_one();
+    }
+
+    if (config.ackPolicy == AckPolicy::BOUNDED) {
+        std::unique_lock<std::mutex> lock(ackMutex);
+        ackCondition.wait(lock, [this, journaled] {
+            return !connected.load() || journaled <= ackedCount.load() + config.maxUnacked;
+        });
+    }
+}
+
+void ReplicationPrimary::shipLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(shipMutex);
+            shipCondition.wait_for(lock, SHIP_POLL_INTERVAL, [this] {
+                return shipRequested.load() || !running.load();
+            });
+        }
+        shipRequested.store(false);
+
+        bool stopping = !running.load();
+        if (!shipPending() || stopping) {
+            return;
+        }
+    }
+}
+
+bool ReplicationPrimary::shipPending() {
+    for (auto& journal : shards) {
+        std::string taken;
+        uint64_t count;
+        {
+            std::lock_guard<std::mutex> lock(journal->mutex);
+            taken.swap(journal->pending);
+            count = journal->pendingCount;
+            journal->pendingCount = 0;
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        // Each shard's records stay in order, which keeps every symbol's order
+        if (!connected.load() || !sendAll(fd, taken.data(), taken.size())) {
+            disconnect();
+            return false;
+        }
+        shippedCount.fetch_add(count);
+    }
+    return connected.load();
+}
+
+void ReplicationPrimary::ackLoop() {
+    uint64_t applied;
+    size_t received = 0;
+    while (true) {
+        ssize_t n = recv(fd, reinterpret_cast<char*>(&applied) + received, sizeof(applied) - received, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        received += static_cast<size_t>(n);
+        if (received == sizeof(applied)) {
+            received = 0;
+            std::lock_guard<std::mutex> lock(ackMutex);
+            ackedCount.store(applied);
+            ackCondition.notify_all();
+        }
+    }
+
+    if (running.load()) {
+        disconnect();
+    }
+}
+
+void ReplicationPrimary::disconnect() {
+    if (connected.exchange(false)) {
+        LOG_ERROR("Standby lost after {} shipped commands; replication stopped", shippedCount.load());
+    }
+    std::lock_guard<std::mutex> lock(ackMutex);
+    ackCondition.notify_all();
+}
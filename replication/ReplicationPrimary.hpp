@@ -0,0 +1,94 @@
+#ifndef MATCHING_ENGINE_REPLICATIONPRIMARY_HPP
+#define MATCHING_ENGINE_REPLICATIONPRIMARY_HPP
+
+#include "CommandJournal.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct ReplicationConfig {
+    AckPolicy ackPolicy = AckPolicy::ASYNC;
+
+    // BOUNDED only: journaled but unacknowledged commands before a shard waits
+    uint64_t maxUnacked = 65536;
+
+    // Commands per symbol between book checksums; 0 sends none
+    uint64_t checksumInterval = 1024;
+};
+
+// Ships a ContinuousMatchingEngine's command journal to a StandbyEngine over
+// a Unix domain socket.
+//
+// Each shard encodes its commands into its own buffer as it applies them;
+// a shipping thread drains the buffers onto the socket, so matching does
+// not wait for the standby unless the BOUNDED policy's window is full. A
+// lost standby is logged and shipping stops; matching carries on.
+class ReplicationPrimary {
+public:
+    ReplicationPrimary(ContinuousMatchingEngine& engine, const ReplicationConfig& config = ReplicationConfig());
+    ~ReplicationPrimary();
+
+    // Connect to the standby listening on `path` and start journaling.
+    // Call before engine.start().
+    bool start(const std::string& path);
+
+    // Ship what is still buffered and close the stream. Stop the engine first.
+    void stop();
+
+    bool isConnected() const;
+
+    uint64_t getJournaledCount() const;
+    uint64_t getShippedCount() const;
+    uint64_t getAckedCount() const;
+
+    // Wait until the standby has applied everything journaled so far.
+    // Returns false on timeout, after the standby is lost, or with AckPolicy::NONE.
+    bool waitForAcks(std::chrono::milliseconds timeout);
+
+private:
+    // One per engine shard, written by that shard's worker
+    struct ShardJournal {
+        std::mutex mutex;
+        std::string pending;
+        uint64_t pendingCount = 0;
+
+        // Worker only
+        std::unordered_map<std::string, uint64_t> symbolCommands;
+    };
+
+    ContinuousMatchingEngine& engine;
+    ReplicationConfig config;
+    std::vector<std::unique_ptr<ShardJournal>> shards;
+    int fd;
+
+    std::atomic<bool> running;
+    std::atomic<bool> connected;
+    std::atomic<uint64_t> journaledCount;
+    std::atomic<uint64_t> shippedCount;
+    std::atomic<uint64_t> ackedCount;
+
+    std::mutex shipMutex;
+    std::condition_variable shipCondition;
+    std::atomic<bool> shipRequested;
+
+    std::mutex ackMutex;
+    std::condition_variable ackCondition;
+
+    std::thread shipper;
+    std::thread ackReader;
+
+    void onCommand(const ContinuousMatchingEngine::OrderRequest& request, const OrderBook* book);
+    void shipLoop();
+    bool shipPending();
+    void ackLoop();
+    void disconnect();
+};
+
+#endif // MATCHING_ENGINE_REPLICATIONPRIMARY_HPP
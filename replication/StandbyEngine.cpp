@@ -0,0 +1,250 @@
+#include "StandbyEngine.hpp"
+#include "../logging/AsyncLogger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+bool recvAll(int fd, char* data, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        ssize_t n = recv(fd, data + received, length - received, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        received += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+StandbyEngine::StandbyEngine()
+    : matchingEngine(std::make_unique<MatchingEngine>()),
+      listenFd(-1),
+      fd(-1),
+      running(false),
+      appliedCount(0),
+      checksumsVerified(0),
+      checksumMismatches(0),
+      primaryLost(false) {
+}
+
+StandbyEngine::~StandbyEngine() {
+    stop();
+}
+
+bool StandbyEngine::addSymbol(const std::string& symbol, MatchingMode mode, AllocationPolicy allocation) {
+    if (running.load()) {
+        return false;
+    }
+    return matchingEngine->addSymbol(symbol, mode, allocation);
+}
+
+bool StandbyEngine::start(const std::string& path) {
+    if (running.load() || !matchingEngine) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("Standby socket path too long: {}", path);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listenFd < 0 ||
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, 1) != 0) {
+        LOG_ERROR("Standby cannot listen on {}", path);
+        if (listenFd >= 0) {
+            close(listenFd);
+            listenFd = -1;
+        }
+        return false;
+    }
+
+    socketPath = path;
+    running.store(true);
+    applier = std::thread(&StandbyEngine::applyLoop, this);
+    return true;
+}
+
+void StandbyEngine::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    // Unblocks accept() or recv() in the applier
+    shutdown(listenFd, SHUT_RDWR);
+    {
+        std::lock_guard<std::mutex> lock(lossMutex);
+        if (fd >= 0) {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    if (applier.joinable()) {
+        applier.join();
+    }
+
+    close(listenFd);
+    listenFd = -1;
+    unlink(socketPath.c_str());
+}
+
+bool StandbyEngine::waitForPrimaryLoss(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(lossMutex);
+    return lossCondition.wait_for(lock, timeout, [this] { return primaryLost; });
+}
+
+bool StandbyEngine::isPrimaryLost() const {
+    std::lock_guard<std::mutex> lock(lossMutex);
+    return primaryLost;
+}
+
+std::chrono::steady_clock::duration StandbyEngine::timeSincePrimaryLoss() const {
+    std::lock_guard<std::mutex> lock(lossMutex);
+    return primaryLost ? std::chrono::steady_clock::now() - lossTime : std::chrono::steady_clock::duration::zero();
+}
+
+std::unique_ptr<ContinuousMatchingEngine> StandbyEngine::promote(size_t numThreads) {
+    if (!isPrimaryLost() || !matchingEngine) {
+        return nullptr;
+    }
+    stop();
+    return std::make_unique<ContinuousMatchingEngine>(std::move(matchingEngine), numThreads);
+}
+
+uint64_t StandbyEngine::getAppliedCount() const {
+    return appliedCount.load();
+}
+
+uint64_t StandbyEngine::getChecksumsVerified() const {
+    return checksumsVerified.load();
+}
+
+uint64_t StandbyEngine::getChecksumMismatches() const {
+    return checksumMismatches.load();
+}
+
+std::shared_ptr<OrderBook> StandbyEngine::getOrderBook(const std::string& symbol) const {
+    return matchingEngine ? matchingEngine->getOrderBook(symbol) : nullptr;
+}
+
+void StandbyEngine::applyLoop() {
+    int connection = accept(listenFd, nullptr, nullptr);
+    if (connection < 0) {
+        // stop() before any primary connected
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(lossMutex);
+        fd = connection;
+    }
+
+    AckPolicy ackPolicy = AckPolicy::NONE;
+    if (!readStream(ackPolicy) && running.load()) {
+        LOG_ERROR("Standby dropped a malformed journal after {} commands", appliedCount.load());
+    }
+    markPrimaryLost();
+}
+
+bool StandbyEngine::readStream(AckPolicy& ackPolicy) {
+    JournalHello hello;
+    if (!recvAll(fd, reinterpret_cast<char*>(&hello), sizeof(hello))) {
+        return true;
+    }
+    if (hello.magic != JOURNAL_MAGIC || hello.version != JOURNAL_VERSION) {
+        return false;
+    }
+    ackPolicy = hello.ackPolicy;
+
+    std::vector<char> buffer(READ_CHUNK);
+    size_t bytes = 0;
+    while (true) {
+        if (buffer.size() - bytes < sizeof(JournalRecordHeader)) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t received = recv(fd, buffer.data() + bytes, buffer.size() - bytes, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            // A record cut off by the primary dying was never acknowledged
+            return true;
+        }
+        bytes += static_cast<size_t>(received);
+
+        size_t offset = 0;
+        while (bytes - offset >= sizeof(JournalRecordHeader)) {
+            uint32_t length;
+            std::memcpy(&length, buffer.data() + offset, sizeof(length));
+            if (length < sizeof(JournalRecordHeader)) {
+                return false;
+            }
+            if (bytes - offset < length) {
+                if (length > buffer.size()) {
+                    buffer.resize(length);
+                }
+                break;
+            }
+            applyRecord(buffer.data() + offset, length);
+            offset += length;
+        }
+
+        if (offset > 0) {
+            std::memmove(buffer.data(), buffer.data() + offset, bytes - offset);
+            bytes -= offset;
+        }
+
+        if (ackPolicy != AckPolicy::NONE) {
+            uint64_t applied = appliedCount.load();
+            ssize_t ignored = send(fd, &applied, sizeof(applied), MSG_NOSIGNAL);
+            (void)ignored;
+        }
+    }
+}
+
+void StandbyEngine::applyRecord(const char* data, size_t length) {
+    JournalEntry entry;
+    if (!decodeJournalEntry(data, length, entry)) {
+        LOG_ERROR("Standby skipped a malformed journal record");
+        return;
+    }
+
+    if (entry.hasChecksum) {
+        auto book = matchingEngine->getOrderBook(entry.symbol);
+        if (book && bookChecksum(*book) == entry.bookChecksum) {
+            checksumsVerified.fetch_add(1);
+        } else {
+            checksumMismatches.fetch_add(1);
+            LOG_ERROR("Standby book for {} diverged from the primary after {} commands", entry.symbol, appliedCount.load());
+        }
+    }
+
+    applyJournalEntry(*matchingEngine, entry);
+    appliedCount.fetch_add(1);
+}
+
+void StandbyEngine::markPrimaryLost() {
+    std::lock_guard<std::mutex> lock(lossMutex);
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    primaryLost = true;
+    lossTime = std::chrono::steady_clock::now();
+    lossCondition.notify_all();
+}
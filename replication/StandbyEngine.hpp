@@ -0,0 +1,78 @@
+#ifndef MATCHING_ENGINE_STANDBYENGINE_HPP
+#define MATCHING_ENGINE_STANDBYENGINE_HPP
+
+#include "CommandJournal.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include "../engine/MatchingEngine.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Hot standby for a ReplicationPrimary.
+//
+// Listens on a Unix domain socket for one primary and applies its journal
+// through a MatchingEngine as it arrives. Records carrying a book checksum
+// are checked against the standby's own book before they are applied. When
+// the stream ends (the primary stopped or died), promote() hands the books
+// to a new ContinuousMatchingEngine.
+class StandbyEngine {
+public:
+    StandbyEngine();
+    ~StandbyEngine();
+
+    // Must mirror the primary's symbol setup, which is not journaled
+    bool addSymbol(const std::string& symbol,
+                   MatchingMode mode = MatchingMode::CONTINUOUS,
+                   AllocationPolicy allocation = AllocationPolicy::FIFO);
+
+    // Listen on `path`, replacing any stale socket file
+    bool start(const std::string& path);
+    void stop();
+
+    // Block until the primary's stream has ended; false on timeout
+    bool waitForPrimaryLoss(std::chrono::milliseconds timeout);
+    bool isPrimaryLost() const;
+
+    // Time from the end of the stream being seen to now
+    std::chrono::steady_clock::duration timeSincePrimaryLoss() const;
+
+    // Take over: returns a stopped engine running on the replicated books,
+    // or nullptr while the primary is still streaming. The standby is spent
+    // afterwards.
+    std::unique_ptr<ContinuousMatchingEngine> promote(size_t numThreads);
+
+    uint64_t getAppliedCount() const;
+    uint64_t getChecksumsVerified() const;
+    uint64_t getChecksumMismatches() const;
+
+    // Only safe once the primary is lost and before promote()
+    std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const;
+
+private:
+    std::unique_ptr<MatchingEngine> matchingEngine;
+    std::string socketPath;
+    int listenFd;
+    int fd;
+    std::thread applier;
+
+    std::atomic<bool> running;
+    std::atomic<uint64_t> appliedCount;
+    std::atomic<uint64_t> checksumsVerified;
+    std::atomic<uint64_t> checksumMismatches;
+
+    mutable std::mutex lossMutex;
+    std::condition_variable lossCondition;
+    bool primaryLost;
+    std::chrono::steady_clock::time_point lossTime;
+
+    void applyLoop();
+    bool readStream(AckPolicy& ackPolicy);
+    void applyRecord(const char* data, size_t length);
+    void markPrimaryLost();
+};
+
+#endif // MATCHING_ENGINE_STANDBYENGINE_HPP
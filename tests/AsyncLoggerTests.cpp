@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../logging/AsyncLogger.hpp"
+#include "../order/OrderFactory.hpp"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Points the logger at a string for the lifetime of the fixture
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AsyncLogger::setSink(output);
+    }
+
+    void TearDown() override {
+        AsyncLogger::setSink(std::cerr);
+    }
+
+    std::string flushed() {
+        AsyncLogger::flush();
+        return output.str();
+    }
+
+    std::ostringstream output;
+};
+
+} // namespace
+
+// Test arguments are substituted into the placeholders in order
+TEST_F(AsyncLoggerTest, FormatsArguments) {
+    LogRecord record{};
+    record.argCount = 4;
+    record.args[0].type = LogArgType::INT;
+    record.args[0].intValue = -5;
+    record.args[1].type = LogArgType::UINT;
+    record.args[1].uintValue = 7;
+    record.args[2].type = LogArgType::DOUBLE;
+    record.args[2].doubleValue = 1.5;
+    record.args[3].type = LogArgType::TEXT;
+    record.args[3].length = 4;
+    std::memcpy(record.args[3].text, "AAPL", 4);
+
+    EXPECT_EQ(AsyncLogger::format("{} {} {} {} {}", record), "-5 7 1.5 AAPL {}");
+}
+
+// Test a logged message reaches the sink with its level
+TEST_F(AsyncLoggerTest, WritesToSink) {
+    LOG_WARN("Logger test {} at {}", std::string("AAPL"), 150.25);
+
+    std::string text = flushed();
+    EXPECT_NE(text.find("[WARN] Logger test AAPL at 150.25\n"), std::string::npos);
+}
+
+// Test long strings are cut to the inline capacity
+TEST_F(AsyncLoggerTest, TruncatesLongText) {
+    std::string longText(LOG_MAX_TEXT_LENGTH + 10, 'x');
+    LOG_INFO("Truncated [{}]", longText);
+
+    std::string text = flushed();
+    EXPECT_NE(text.find("Truncated [" + std::string(LOG_MAX_TEXT_LENGTH, 'x') + "]"), std::string::npos);
+}
+
+// Test every message from several threads is either written or counted as dropped
+TEST_F(AsyncLoggerTest, ConcurrentThreadsWrittenOrDropped) {
+    const int numThreads = 4;
+    const int messagesPerThread = 2000;
+    uint64_t droppedBefore = AsyncLogger::getDroppedCount();
+
+    AsyncLogger::setRingCapacity(64);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([t, messagesPerThread]() {
+            for (int i = 0; i < messagesPerThread; ++i) {
+                LOG_INFO("Concurrent message {} {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AsyncLogger::setRingCapacity(1024);
+
+    std::string text = flushed();
+    uint64_t dropped = AsyncLogger::getDroppedCount() - droppedBefore;
+    EXPECT_EQ(countOccurrences(text, "Concurrent message") + dropped,
+              static_cast<uint64_t>(numThreads * messagesPerThread));
+}
+
+// Test messages from threads that exit before the drain are still written
+TEST_F(AsyncLoggerTest, ShortLivedThreadsWritten) {
+    const int numThreads = 32;
+    for (int t = 0; t < numThreads; ++t) {
+        std::thread([t]() {
+            LOG_INFO("Short-lived thread {}", t);
+        }).join();
+    }
+
+    std::string text = flushed();
+    EXPECT_EQ(countOccurrences(text, "Short-lived thread"), static_cast<size_t>(numThreads));
+    EXPECT_NE(text.find("Short-lived thread 0\n"), std::string::npos);
+    EXPECT_NE(text.find("Short-lived thread 31\n"), std::string::npos);
+}
+
+// Test order validation failures go through the logger
+TEST_F(AsyncLoggerTest, OrderFactoryLogsRejects) {
+    EXPECT_EQ(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, -1.0, 100), nullptr);
+
+    std::string text = flushed();
+    EXPECT_NE(text.find("[ERROR] Invalid price: -1"), std::string::npos);
+}
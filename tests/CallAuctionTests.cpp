@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "engine/CallAuction.hpp"
+#include "engine/Trade.hpp"
+#include "order/OrderFactory.hpp"
+
+class CallAuctionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        orderBook = std::make_unique<OrderBook>("AAPL");
+    }
+
+    void add(OrderSide side, double price, int quantity) {
+        orderBook->addOrder(OrderFactory::createLimitOrder("AAPL", side, price, quantity));
+    }
+
+    std::unique_ptr<OrderBook> orderBook;
+};
+
+TEST_F(CallAuctionTest, NoCrossNoClearing) {
+    add(OrderSide::BUY, 99.0, 10);
+    add(OrderSide::SELL, 100.0, 10);
+
+    auto clearing = CallAuction::computeClearing(*orderBook);
+    EXPECT_EQ(0, clearing.volume);
+    EXPECT_TRUE(CallAuction::execute(*orderBook, clearing).empty());
+    EXPECT_EQ(2u, orderBook->getAllBuyOrders().size() + orderBook->getAllSellOrders().size());
+}
+
+TEST_F(CallAuctionTest, MaximizesVolume) {
+    add(OrderSide::BUY, 101.0, 10);
+    add(OrderSide::BUY, 100.0, 20);
+    add(OrderSide::BUY, 99.0, 30);
+    add(OrderSide::SELL, 98.0, 15);
+    add(OrderSide::SELL, 99.0, 10);
+    add(OrderSide::SELL, 100.0, 20);
+    add(OrderSide::SELL, 102.0, 10);
+
+    // Executable volume is 15 at 98, 25 at 99, 30 at 100 and 10 at 101
+    auto clearing = CallAuction::computeClearing(*orderBook);
+    EXPECT_DOUBLE_EQ(100.0, clearing.price);
+    EXPECT_EQ(30, clearing.volume);
+    EXPECT_EQ(-15, clearing.imbalance);
+
+    auto trades = CallAuction::execute(*orderBook, clearing);
+    int volume = 0;
+    for (const auto& trade : trades) {
+        EXPECT_DOUBLE_EQ(100.0, trade->getPrice());
+        volume += trade->getQuantity();
+    }
+    EXPECT_EQ(30, volume);
+    EXPECT_DOUBLE_EQ(99.0, orderBook->getBestBidPrice());
+    EXPECT_DOUBLE_EQ(100.0, orderBook->getBestAskPrice());
+    EXPECT_EQ(15, orderBook->getAskSize(100.0));
+}
+
+TEST_F(CallAuctionTest, TieBreaks) {
+    add(OrderSide::BUY, 100.0, 10);
+    add(OrderSide::SELL, 99.0, 10);
+
+    // Same volume and imbalance at 99 and 100: the lower price wins
+    auto clearing = CallAuction::computeClearing(*orderBook);
+    EXPECT_DOUBLE_EQ(99.0, clearing.price);
+    EXPECT_EQ(10, clearing.volume);
+
+    // A buy surplus at 99 leaves 100 with the smaller imbalance
+    add(OrderSide::BUY, 99.0, 5);
+    clearing = CallAuction::computeClearing(*orderBook);
+    EXPECT_DOUBLE_EQ(100.0, clearing.price);
+    EXPECT_EQ(10, clearing.volume);
+    EXPECT_EQ(0, clearing.imbalance);
+}
+
+TEST_F(CallAuctionTest, IcebergReserveCounts) {
+    orderBook->addOrder(OrderFactory::createIcebergOrder("AAPL", OrderSide::BUY, 100.0, 50, 10));
+    add(OrderSide::SELL, 100.0, 40);
+
+    auto clearing = CallAuction::computeClearing(*orderBook);
+    EXPECT_EQ(40, clearing.volume);
+
+    auto trades = CallAuction::execute(*orderBook, clearing);
+    EXPECT_EQ(4u, trades.size());
+    EXPECT_EQ(10, orderBook->getBidSize(100.0));
+    EXPECT_TRUE(orderBook->getAllSellOrders().empty());
+}
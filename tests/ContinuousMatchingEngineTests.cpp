@@ -5,10 +5,30 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 #include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <unistd.h>
 #include "../engine/ContinuousMatchingEngine.hpp"
+#include "../engine/EngineStatsReporter.hpp"
 #include "../order/OrderFactory.hpp"
 
+// Fire-and-forget coroutine for driving OrderCompletion's awaitable side
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
 class ContinuousMatchingEngineTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -252,3 +272,569 @@ TEST_F(ContinuousMatchingEngineTest, SubmitMarketBuyOrderNoMatch) {
     EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
     EXPECT_EQ(orderBook->getAllSellOrders().size(), 0);
 }
+
+// Test per-symbol and per-worker statistics
+TEST_F(ContinuousMatchingEngineTest, GetStats) {
+    std::atomic<int> processed(0);
+    matchingEngine->registerOrderProcessingCallback([&processed](std::shared_ptr<OrderProcessingResult>) {
+        processed++;
+    });
+    
+    auto sellOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 100);
+    matchingEngine->submitOrder(sellOrder);
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 40));
+    matchingEngine->submitOrder(OrderFactory::createMarketOrder("AAPL", OrderSide::BUY, 60));
+    matchingEngine->cancelOrder("missing", "AAPL");
+    
+    for (int i = 0; i < 100 && processed.load() < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(processed.load(), 4);
+    
+    auto stats = matchingEngine->getStats();
+    ASSERT_EQ(stats.symbols.size(), 1);
+    EXPECT_EQ(stats.symbols[0].symbol, "AAPL");
+    EXPECT_EQ(stats.symbols[0].shard, matchingEngine->getThreadForSymbol("AAPL"));
+    EXPECT_EQ(stats.symbols[0].orders, 3);
+    EXPECT_EQ(stats.symbols[0].cancels, 1);
+    EXPECT_EQ(stats.symbols[0].trades, 2);
+    EXPECT_EQ(stats.symbols[0].rejects, 1);
+    
+    ASSERT_EQ(stats.workers.size(), matchingEngine->getNumThreads());
+    const auto& worker = stats.workers[stats.symbols[0].shard];
+    EXPECT_EQ(worker.tasksProcessed, 4);
+    EXPECT_GE(worker.queueDepthHighWater, 1);
+    EXPECT_GT(worker.busyNanos, 0);
+    EXPECT_EQ(stats.rejectedSubmissions, 0);
+    
+    matchingEngine->stop();
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 40));
+    EXPECT_EQ(matchingEngine->getStats().rejectedSubmissions, 1);
+}
+
+// Test the stats reporter appends one JSON line per interval
+TEST_F(ContinuousMatchingEngineTest, StatsReporterWritesFile) {
+    std::string path = "/tmp/engine_stats_test_" + std::to_string(getpid()) + ".jsonl";
+    std::remove(path.c_str());
+    
+    EngineStatsReporter reporter(*matchingEngine, path, std::chrono::milliseconds(20));
+    ASSERT_TRUE(reporter.start());
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 40));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    reporter.stop();
+    
+    std::ifstream file(path);
+    std::string line;
+    int lines = 0;
+    std::string last;
+    while (std::getline(file, line)) {
+        EXPECT_EQ(line.front(), '{');
+        EXPECT_EQ(line.back(), '}');
+        last = line;
+        lines++;
+    }
+    EXPECT_GE(lines, 2);
+    EXPECT_NE(last.find("\"symbol\": \"AAPL\""), std::string::npos);
+    EXPECT_NE(last.find("\"orders\": 1"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+// Test an IOC remainder is reported as cancelled and DAY orders expire
+TEST_F(ContinuousMatchingEngineTest, TimeInForceResults) {
+    std::mutex resultsMutex;
+    std::vector<std::shared_ptr<OrderProcessingResult>> results;
+    matchingEngine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        results.push_back(result);
+    });
+    auto resultCount = [&]() {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        return results.size();
+    };
+    
+    auto sellOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 30);
+    auto iocOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 20, TimeInForce::IOC);
+    auto dayOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 140.0, 10, TimeInForce::DAY);
+    matchingEngine->submitOrder(sellOrder);
+    matchingEngine->submitOrder(iocOrder);
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 25, TimeInForce::IOC));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 160.0, 5, TimeInForce::DAY));
+    matchingEngine->submitOrder(dayOrder);
+    matchingEngine->expireDayOrders();
+    
+    for (int i = 0; i < 100 && resultCount() < 7; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(resultCount(), 7);
+    
+    EXPECT_EQ(results[1]->getStatus(), OrderProcessingResult::Status::SUCCESS);
+    EXPECT_EQ(results[1]->getCancelledQuantity(), 0);
+    EXPECT_EQ(results[2]->getStatus(), OrderProcessingResult::Status::PARTIAL_FILL);
+    EXPECT_EQ(results[2]->getCancelledQuantity(), 15);
+    
+    // Both resting DAY orders expire
+    for (size_t i = 5; i < 7; ++i) {
+        EXPECT_EQ(results[i]->getAction(), OrderProcessingResult::Action::CANCEL);
+        EXPECT_EQ(results[i]->getStatus(), OrderProcessingResult::Status::SUCCESS);
+    }
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
+    EXPECT_EQ(orderBook->getAllSellOrders().size(), 0);
+}
+
+// Test a cascade of stops runs on the shard right after the triggering order
+TEST_F(ContinuousMatchingEngineTest, StopCascade) {
+    std::mutex resultsMutex;
+    std::vector<std::shared_ptr<OrderProcessingResult>> results;
+    matchingEngine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        results.push_back(result);
+    });
+    auto resultCount = [&]() {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        return results.size();
+    };
+    
+    // Bids the sell stops will hit
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 149.0, 10));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 147.0, 10));
+    
+    // The first stop's fill at 149 elects the second
+    auto firstStop = OrderFactory::createStopOrder("AAPL", OrderSide::SELL, 150.0, 10);
+    auto secondStop = OrderFactory::createStopOrder("AAPL", OrderSide::SELL, 149.0, 10);
+    matchingEngine->submitOrder(firstStop);
+    matchingEngine->submitOrder(secondStop);
+    
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 5));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 5));
+    
+    for (int i = 0; i < 100 && resultCount() < 8; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(resultCount(), 8);
+    
+    EXPECT_EQ(results[6]->getOrderId(), firstStop->getId());
+    EXPECT_EQ(results[6]->getAction(), OrderProcessingResult::Action::TRIGGER);
+    ASSERT_EQ(results[6]->getTrades().size(), 1);
+    EXPECT_EQ(results[6]->getTrades()[0]->getPrice(), 149.0);
+    EXPECT_EQ(results[7]->getOrderId(), secondStop->getId());
+    ASSERT_EQ(results[7]->getTrades().size(), 1);
+    EXPECT_EQ(results[7]->getTrades()[0]->getPrice(), 147.0);
+    
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
+}
+
+TEST_F(ContinuousMatchingEngineTest, ModifyOrder) {
+    std::mutex resultsMutex;
+    std::vector<std::shared_ptr<OrderProcessingResult>> results;
+    matchingEngine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        results.push_back(result);
+    });
+    auto resultCount = [&]() {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        return results.size();
+    };
+    
+    auto sellOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.0, 40);
+    auto buyOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 100);
+    matchingEngine->submitOrder(sellOrder);
+    matchingEngine->submitOrder(buyOrder);
+    matchingEngine->modifyOrder(buyOrder->getId(), "AAPL", 151.0, 60);
+    matchingEngine->modifyOrder("non-existent-id", "AAPL", 151.0, 60);
+    
+    for (int i = 0; i < 100 && resultCount() < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(resultCount(), 4);
+    
+    // The failed modify has no queued order to wait behind, so it may
+    // overtake the submits; the real one stays behind its own order's submit
+    auto failedModify = std::find_if(results.begin(), results.end(), [](const auto& result) {
+        return result->getOrderId() == "non-existent-id";
+    });
+    ASSERT_NE(failedModify, results.end());
+    EXPECT_EQ((*failedModify)->getStatus(), OrderProcessingResult::Status::ERROR);
+    results.erase(failedModify);
+    
+    // One result for the whole cancel/replace, fills included
+    EXPECT_EQ(results[2]->getAction(), OrderProcessingResult::Action::MODIFY);
+    EXPECT_EQ(results[2]->getStatus(), OrderProcessingResult::Status::PARTIAL_FILL);
+    EXPECT_EQ(results[2]->getModifiedQuantity(), 60);
+    ASSERT_EQ(results[2]->getTrades().size(), 1);
+    EXPECT_EQ(results[2]->getTrades()[0]->getQuantity(), 40);
+    
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getBidSize(151.0), 20);
+    
+    auto stats = matchingEngine->getStats();
+    ASSERT_EQ(stats.symbols.size(), 1);
+    EXPECT_EQ(stats.symbols[0].modifies, 2);
+}
+
+TEST_F(ContinuousMatchingEngineTest, MassCancel) {
+    matchingEngine->addSymbol("MSFT");
+    std::atomic<int> cancels(0);
+    matchingEngine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        if (result->getAction() == OrderProcessingResult::Action::CANCEL) {
+            ++cancels;
+        }
+    });
+    
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 10, "alice"));
+    matchingEngine->submitOrder(OrderFactory::createStopOrder("AAPL", OrderSide::SELL, 140.0, 10, "alice"));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("MSFT", OrderSide::SELL, 300.0, 10, "alice"));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("MSFT", OrderSide::SELL, 301.0, 10, "bob"));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 149.0, 10, "bob"));
+    
+    // Owner-wide cancel covers every symbol, parked stops included
+    matchingEngine->massCancel("alice");
+    for (int i = 0; i < 100 && cancels < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(cancels, 3);
+    EXPECT_EQ(matchingEngine->getOrderBook("AAPL")->getAllBuyOrders().size(), 1);
+    EXPECT_EQ(matchingEngine->getOrderBook("MSFT")->getAllSellOrders().size(), 1);
+    
+    matchingEngine->massCancelSymbol("MSFT");
+    for (int i = 0; i < 100 && cancels < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(cancels, 4);
+    EXPECT_EQ(matchingEngine->getOrderBook("MSFT")->getAllSellOrders().size(), 0);
+    EXPECT_EQ(matchingEngine->getOrderBook("AAPL")->getAllBuyOrders().size(), 1);
+}
+
+TEST_F(ContinuousMatchingEngineTest, AuctionUncross) {
+    ASSERT_TRUE(matchingEngine->addSymbol("MSFT", MatchingMode::AUCTION));
+    std::mutex tradesMutex;
+    std::vector<std::shared_ptr<Trade>> trades;
+    matchingEngine->registerTradeCallback([&](std::shared_ptr<Trade> trade) {
+        std::lock_guard<std::mutex> lock(tradesMutex);
+        trades.push_back(trade);
+    });
+    auto tradeCount = [&]() {
+        std::lock_guard<std::mutex> lock(tradesMutex);
+        return trades.size();
+    };
+    
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("MSFT", OrderSide::BUY, 301.0, 10));
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("MSFT", OrderSide::SELL, 300.0, 10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(tradeCount(), 0);
+    
+    matchingEngine->uncross("MSFT");
+    for (int i = 0; i < 100 && tradeCount() < 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(tradeCount(), 1);
+    EXPECT_EQ(trades[0]->getPrice(), 300.0);
+    EXPECT_EQ(trades[0]->getQuantity(), 10);
+}
+
+// Test that a completion token gets the submit's own result, polled or blocking
+TEST_F(ContinuousMatchingEngineTest, SubmitCompletionToken) {
+    OrderCompletion resting;
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 10), resting);
+    auto restingResult = resting.get();
+    ASSERT_NE(restingResult, nullptr);
+    EXPECT_TRUE(resting.isReady());
+    EXPECT_EQ(restingResult->getStatus(), OrderProcessingResult::Status::SUCCESS);
+    EXPECT_TRUE(restingResult->getTrades().empty());
+
+    // A reused token reports the next order
+    resting.reset();
+    EXPECT_FALSE(resting.isReady());
+    auto taker = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 4);
+    matchingEngine->submitOrder(taker, resting);
+    for (int i = 0; i < 100 && !resting.isReady(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(resting.isReady());
+    EXPECT_EQ(resting.get()->getOrderId(), taker->getId());
+    EXPECT_EQ(resting.get()->getTrades().size(), 1);
+
+    // Refused before reaching a shard: completes on the caller's thread
+    matchingEngine->stop();
+    OrderCompletion refused;
+    matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 149.0, 1), refused);
+    ASSERT_TRUE(refused.isReady());
+    EXPECT_EQ(refused.get()->getStatus(), OrderProcessingResult::Status::ERROR);
+}
+
+// Test that a token can be freed as soon as get() returns, while the shard
+// may still be finishing the wake-up
+TEST_F(ContinuousMatchingEngineTest, CompletionTokenFreedAfterGet) {
+    for (int i = 0; i < 500; ++i) {
+        auto completion = std::make_unique<OrderCompletion>();
+        matchingEngine->submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 100.0, 1), *completion);
+        ASSERT_NE(completion->get(), nullptr);
+        completion.reset();
+    }
+}
+
+// Test that a coroutine awaiting a completion token resumes with the result
+TEST_F(ContinuousMatchingEngineTest, AwaitSubmitCompletion) {
+    std::atomic<bool> resumed{false};
+    std::shared_ptr<OrderProcessingResult> awaited;
+    OrderCompletion completion;
+    auto order = OrderFactory::createMarketOrder("AAPL", OrderSide::BUY, 5);
+
+    auto submitAndAwait = [&]() -> DetachedTask {
+        matchingEngine->submitOrder(order, completion);
+        awaited = co_await completion;
+        resumed.store(true);
+    };
+    submitAndAwait();
+
+    for (int i = 0; i < 100 && !resumed.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(resumed.load());
+    ASSERT_NE(awaited, nullptr);
+    EXPECT_EQ(awaited->getOrderId(), order->getId());
+    EXPECT_EQ(awaited->getStatus(), OrderProcessingResult::Status::NO_MATCH);
+    EXPECT_EQ(awaited->getCancelledQuantity(), 5);
+}
+
+// Test that a full shard sheds new orders and modifies but still takes cancels
+TEST(ContinuousMatchingEngineBackpressureTest, ShedNewOrdersAdmitsCancels) {
+    ContinuousMatchingEngine engine(1);
+    engine.addSymbol("AAPL");
+    engine.setQueueCapacity(2, BackpressurePolicy::SHED_NEW_ORDERS);
+
+    // Hold the shard inside its first command
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::atomic<bool> holding{false};
+    engine.setCommandListener([&](const ContinuousMatchingEngine::OrderRequest&, const OrderBook*) {
+        if (!holding.exchange(true)) {
+            gateOpen.wait();
+        }
+    });
+    // Refusals come back through the return value and token; the callbacks
+    // hear only from the shard
+    std::mutex resultsMutex;
+    std::vector<std::shared_ptr<OrderProcessingResult>> errors;
+    std::vector<std::thread::id> callbackThreads;
+    engine.registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        callbackThreads.push_back(std::this_thread::get_id());
+        if (result->getStatus() == OrderProcessingResult::Status::ERROR) {
+            errors.push_back(result);
+        }
+    });
+    engine.start();
+
+    EXPECT_TRUE(engine.submitOrder(std::make_shared<Order>("held", "AAPL", OrderSide::BUY, 100.0, 10)));
+    for (int i = 0; i < 100 && !holding.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(holding.load());
+    EXPECT_TRUE(engine.submitOrder(std::make_shared<Order>("queued1", "AAPL", OrderSide::BUY, 99.0, 10)));
+    EXPECT_TRUE(engine.submitOrder(std::make_shared<Order>("queued2", "AAPL", OrderSide::BUY, 98.0, 10)));
+    EXPECT_EQ(engine.getQueueDepth("AAPL"), 2);
+
+    OrderCompletion shed;
+    EXPECT_FALSE(engine.submitOrder(std::make_shared<Order>("shed", "AAPL", OrderSide::BUY, 97.0, 10), shed));
+    ASSERT_TRUE(shed.isReady());
+    EXPECT_EQ(shed.get()->getStatus(), OrderProcessingResult::Status::ERROR);
+    EXPECT_FALSE(engine.modifyOrder("queued2", "AAPL", 98.0, 5));
+    EXPECT_TRUE(engine.cancelOrder("held", "AAPL"));
+    EXPECT_EQ(engine.getQueueDepth("AAPL"), 3);
+    EXPECT_EQ(engine.getStats().rejectedSubmissions, 2);
+
+    gate.set_value();
+    for (int i = 0; i < 100 && engine.getQueueDepth("AAPL") > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.stop();
+
+    auto book = engine.getOrderBook("AAPL");
+    EXPECT_EQ(book->getOrderById("held"), nullptr);
+    EXPECT_NE(book->getOrderById("queued1"), nullptr);
+    EXPECT_EQ(book->getOrderById("queued2")->getQuantity(), 10);
+    EXPECT_EQ(book->getOrderById("shed"), nullptr);
+
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    EXPECT_TRUE(errors.empty());
+    ASSERT_EQ(callbackThreads.size(), 4);
+    for (const auto& id : callbackThreads) {
+        EXPECT_EQ(id, callbackThreads[0]);
+    }
+    EXPECT_NE(callbackThreads[0], std::this_thread::get_id());
+}
+
+// Test that cancels overtake queued new orders but never their own order's commands
+TEST(ContinuousMatchingEngineLaneTest, CancelsOvertakeOtherOrders) {
+    ContinuousMatchingEngine engine(1);
+    engine.addSymbol("AAPL");
+
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::atomic<bool> holding{false};
+    std::vector<std::string> applied;
+    engine.setCommandListener([&](const ContinuousMatchingEngine::OrderRequest& request, const OrderBook*) {
+        using Action = ContinuousMatchingEngine::OrderAction;
+        if (request.action == Action::SUBMIT) {
+            applied.push_back("S:" + request.order->getId());
+        } else {
+            applied.push_back((request.action == Action::CANCEL ? "C:" : "M:") + request.orderId);
+        }
+        if (!holding.exchange(true)) {
+            gateOpen.wait();
+        }
+    });
+    engine.start();
+
+    engine.submitOrder(std::make_shared<Order>("held", "AAPL", OrderSide::BUY, 100.0, 10));
+    for (int i = 0; i < 100 && !holding.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(holding.load());
+    for (int i = 0; i < 5; ++i) {
+        engine.submitOrder(std::make_shared<Order>("q" + std::to_string(i), "AAPL", OrderSide::BUY, 90.0 + i, 10));
+    }
+    engine.modifyOrder("q2", "AAPL", 92.0, 5);
+    engine.cancelOrder("q2", "AAPL");
+    for (int i = 5; i < 8; ++i) {
+        engine.submitOrder(std::make_shared<Order>("q" + std::to_string(i), "AAPL", OrderSide::BUY, 90.0 + i, 10));
+    }
+    engine.cancelOrder("held", "AAPL");
+    engine.modifyOrder("q7", "AAPL", 97.0, 5);
+    EXPECT_EQ(engine.getQueueDepth("AAPL"), 12);
+
+    gate.set_value();
+    for (int i = 0; i < 100 && engine.getQueueDepth("AAPL") > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.stop();
+
+    std::vector<std::string> expected = {
+        "S:held", "C:held",
+        "S:q0", "S:q1", "S:q2", "S:q3", "S:q4", "M:q2", "C:q2",
+        "S:q5", "S:q6", "S:q7", "M:q7"
+    };
+    EXPECT_EQ(applied, expected);
+    auto book = engine.getOrderBook("AAPL");
+    EXPECT_EQ(book->getOrderById("held"), nullptr);
+    EXPECT_EQ(book->getOrderById("q2"), nullptr);
+    EXPECT_EQ(book->getOrderById("q7")->getQuantity(), 5);
+}
+
+// Test that a modify sent after a mass cancel never overtakes it
+TEST(ContinuousMatchingEngineLaneTest, ModifyWaitsBehindMassCancel) {
+    ContinuousMatchingEngine engine(1);
+    engine.addSymbol("AAPL");
+
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::atomic<bool> holding{false};
+    engine.setCommandListener([&](const ContinuousMatchingEngine::OrderRequest& request, const OrderBook*) {
+        if (request.action == ContinuousMatchingEngine::OrderAction::SUBMIT &&
+            request.order->getId() == "held" && !holding.exchange(true)) {
+            gateOpen.wait();
+        }
+    });
+    std::atomic<int> trades{0};
+    engine.registerTradeCallback([&](std::shared_ptr<Trade>) {
+        ++trades;
+    });
+    engine.start();
+
+    engine.submitOrder(std::make_shared<Order>("bid", "AAPL", OrderSide::BUY, 100.0, 10,
+                                               OrderType::LIMIT, TimeInForce::GTC, "alice"));
+    engine.submitOrder(std::make_shared<Order>("ask", "AAPL", OrderSide::SELL, 101.0, 10,
+                                               OrderType::LIMIT, TimeInForce::GTC, "bob"));
+    engine.submitOrder(std::make_shared<Order>("held", "AAPL", OrderSide::BUY, 50.0, 10,
+                                               OrderType::LIMIT, TimeInForce::GTC, "carol"));
+    for (int i = 0; i < 100 && !holding.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(holding.load());
+
+    // Kill switch queued behind the held shard, then a modify that would cross
+    engine.massCancel("alice");
+    EXPECT_TRUE(engine.modifyOrder("bid", "AAPL", 101.0, 10));
+    EXPECT_EQ(engine.getQueueDepth("AAPL"), 2);
+
+    gate.set_value();
+    for (int i = 0; i < 100 && engine.getQueueDepth("AAPL") > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.stop();
+
+    EXPECT_EQ(trades.load(), 0);
+    auto book = engine.getOrderBook("AAPL");
+    EXPECT_EQ(book->getOrderById("bid"), nullptr);
+    EXPECT_NE(book->getOrderById("ask"), nullptr);
+}
+
+// Test that a cancel catching its submit in the queue drops both without touching the book
+TEST(ContinuousMatchingEngineLaneTest, CancelCoalescesWithQueuedSubmit) {
+    ContinuousMatchingEngine engine(1);
+    engine.addSymbol("AAPL");
+
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::atomic<bool> holding{false};
+    std::vector<std::string> applied;
+    engine.setCommandListener([&](const ContinuousMatchingEngine::OrderRequest& request, const OrderBook*) {
+        if (request.action == ContinuousMatchingEngine::OrderAction::SUBMIT) {
+            applied.push_back("S:" + request.order->getId());
+        } else {
+            applied.push_back("C:" + request.orderId);
+        }
+        if (!holding.exchange(true)) {
+            gateOpen.wait();
+        }
+    });
+    std::mutex resultsMutex;
+    std::vector<std::shared_ptr<OrderProcessingResult>> results;
+    engine.registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        results.push_back(result);
+    });
+    engine.start();
+
+    engine.submitOrder(std::make_shared<Order>("held", "AAPL", OrderSide::SELL, 100.0, 10));
+    for (int i = 0; i < 100 && !holding.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(holding.load());
+
+    // Would trade with "held" if it reached the book
+    OrderCompletion completion;
+    engine.submitOrder(std::make_shared<Order>("taker", "AAPL", OrderSide::BUY, 100.0, 4), completion);
+    engine.cancelOrder("taker", "AAPL");
+    engine.cancelOrder("taker", "AAPL");
+    EXPECT_EQ(engine.getQueueDepth("AAPL"), 2);
+
+    gate.set_value();
+    auto awaited = completion.get();
+    EXPECT_EQ(awaited->getStatus(), OrderProcessingResult::Status::CANCELLED);
+    EXPECT_EQ(awaited->getCancelledQuantity(), 4);
+    for (int i = 0; i < 100 && engine.getQueueDepth("AAPL") > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.stop();
+
+    // The second cancel came too late to coalesce and finds nothing to cancel
+    std::vector<std::string> expected = {"S:held", "C:taker"};
+    EXPECT_EQ(applied, expected);
+    EXPECT_EQ(engine.getOrderBook("AAPL")->getOrderById("held")->getQuantity(), 10);
+
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(results[1]->getAction(), OrderProcessingResult::Action::SUBMIT);
+    EXPECT_EQ(results[1]->getStatus(), OrderProcessingResult::Status::CANCELLED);
+    EXPECT_EQ(results[2]->getAction(), OrderProcessingResult::Action::CANCEL);
+    EXPECT_EQ(results[2]->getStatus(), OrderProcessingResult::Status::SUCCESS);
+    EXPECT_EQ(results[3]->getAction(), OrderProcessingResult::Action::CANCEL);
+    EXPECT_EQ(results[3]->getStatus(), OrderProcessingResult::Status::ERROR);
+}
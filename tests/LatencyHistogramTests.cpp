@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../metrics/LatencyHistogram.hpp"
+#include "../metrics/PipelineLatency.hpp"
+#include "../metrics/TscClock.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include "../order/OrderFactory.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Test an empty histogram reports zeros
+TEST(LatencyHistogramTest, EmptyHistogram) {
+    LatencyHistogram histogram;
+
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getMax(), 0u);
+    EXPECT_EQ(histogram.getPercentile(0.5), 0u);
+}
+
+// Test small values land in exact buckets
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10; ++value) {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.getCount(), 10u);
+    EXPECT_EQ(histogram.getMax(), 10u);
+    EXPECT_EQ(histogram.getPercentile(0.5), 5u);
+    EXPECT_EQ(histogram.getPercentile(1.0), 10u);
+}
+
+// Test percentiles over a wide range stay within the bucket precision
+TEST(LatencyHistogramTest, PercentilesWithinPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value * 100);
+    }
+
+    auto withinPrecision = [](uint64_t reported, double expected) {
+        return std::abs(static_cast<double>(reported) - expected) <= expected * 0.04;
+    };
+    EXPECT_TRUE(withinPrecision(histogram.getPercentile(0.50), 5000000.0));
+    EXPECT_TRUE(withinPrecision(histogram.getPercentile(0.99), 9900000.0));
+    EXPECT_TRUE(withinPrecision(histogram.getPercentile(0.999), 9990000.0));
+    EXPECT_EQ(histogram.getMax(), 10000000u);
+    EXPECT_EQ(histogram.getPercentile(1.0), 10000000u);
+}
+
+// Test reset clears counts and max
+TEST(LatencyHistogramTest, Reset) {
+    LatencyHistogram histogram;
+    histogram.record(1000);
+    histogram.reset();
+
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getMax(), 0u);
+    EXPECT_EQ(histogram.getPercentile(0.99), 0u);
+}
+
+// Test concurrent writers lose no samples
+TEST(LatencyHistogramTest, ConcurrentRecord) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&histogram, t]() {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                histogram.record(i + static_cast<uint64_t>(t));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    EXPECT_EQ(histogram.getCount(), 40000u);
+    EXPECT_EQ(histogram.getMax(), 10002u);
+}
+
+// Test the single-writer path counts the same as record()
+TEST(LatencyHistogramTest, SingleWriterRecord) {
+    LatencyHistogram shared;
+    LatencyHistogram owned;
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        shared.record(value * 7);
+        owned.recordSingleWriter(value * 7);
+    }
+
+    EXPECT_EQ(owned.getCount(), shared.getCount());
+    EXPECT_EQ(owned.getMax(), 7000u);
+    EXPECT_EQ(owned.getPercentile(0.5), shared.getPercentile(0.5));
+    EXPECT_EQ(owned.getPercentile(0.99), shared.getPercentile(0.99));
+}
+
+// Test the TSC clock converts a known sleep to roughly the right duration
+TEST(TscClockTest, ConvertsToNanos) {
+    uint64_t start = TscClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t elapsed = TscClock::toNanos(TscClock::now() - start);
+
+    EXPECT_GE(elapsed, 15000000u);
+    EXPECT_LT(elapsed, 1000000000u);
+}
+
+// Test each stage records the delta between its two timestamps
+TEST(PipelineLatencyTest, RecordsStageDeltas) {
+    PipelineLatencyRecorder recorder;
+    StageTimestamps timestamps;
+    timestamps.enqueue = 1000;
+    timestamps.dequeue = 1000;
+    timestamps.matchStart = 1000;
+    timestamps.matchEnd = 1000;
+    timestamps.publish = 1000;
+    recorder.record(timestamps);
+
+    auto summaries = recorder.summarize();
+    ASSERT_EQ(summaries.size(), PIPELINE_STAGE_COUNT);
+    for (const auto& summary : summaries) {
+        EXPECT_EQ(summary.count, 1u);
+        EXPECT_EQ(summary.maxNanos, 0u);
+    }
+    EXPECT_EQ(summaries[static_cast<size_t>(PipelineStage::MATCH)].stage, PipelineStage::MATCH);
+
+    // Out-of-order timestamps from different cores clamp to zero
+    timestamps.dequeue = 500;
+    recorder.reset();
+    recorder.record(timestamps);
+    EXPECT_EQ(recorder.summarize()[static_cast<size_t>(PipelineStage::QUEUE_WAIT)].maxNanos, 0u);
+}
+
+// Test the engine fills every stage for the shard that processed the order
+TEST(PipelineLatencyTest, EngineRecordsPerShard) {
+    if (!ContinuousMatchingEngine::isLatencyTrackingEnabled()) {
+        ContinuousMatchingEngine engine(2);
+        EXPECT_TRUE(engine.getStageLatencies(0).empty());
+        GTEST_SKIP() << "Built without ENABLE_LATENCY_TRACKING";
+    }
+
+    ContinuousMatchingEngine engine(2);
+    engine.addSymbol("AAPL");
+    engine.start();
+    for (int i = 0; i < 10; ++i) {
+        engine.submitOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 100));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    engine.stop();
+
+    size_t shard = static_cast<size_t>(engine.getThreadForSymbol("AAPL"));
+    auto summaries = engine.getStageLatencies(shard);
+    ASSERT_EQ(summaries.size(), PIPELINE_STAGE_COUNT);
+    for (const auto& summary : summaries) {
+        EXPECT_EQ(summary.count, 10u);
+        EXPECT_LE(summary.p50Nanos, summary.maxNanos);
+    }
+    EXPECT_EQ(engine.getStageLatencies(1 - shard)[0].count, 0u);
+}
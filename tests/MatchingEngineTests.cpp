@@ -229,3 +229,233 @@ TEST_F(MatchingEngineTest, MarketOrderNoMatch) {
     auto orderBook = matchingEngine->getOrderBook("AAPL");
     EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
 }
+
+// Test a partly filled market order does not rest at price zero
+TEST_F(MatchingEngineTest, MarketOrderRemainderDoesNotRest) {
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 30));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 140.0, 10));
+
+    auto buyOrder = OrderFactory::createMarketOrder("AAPL", OrderSide::BUY, 50);
+    auto trades = matchingEngine->processOrder(buyOrder);
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(buyOrder->getQuantity(), 20);
+
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 1);
+    EXPECT_EQ(orderBook->getBestBidPrice(), 140.0);
+    EXPECT_EQ(orderBook->getAllSellOrders().size(), 0);
+}
+
+// Test an IOC limit order fills what crosses and drops the rest
+TEST_F(MatchingEngineTest, ImmediateOrCancel) {
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 30));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.0, 30));
+
+    auto buyOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 50, TimeInForce::IOC);
+    auto trades = matchingEngine->processOrder(buyOrder);
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0]->getQuantity(), 30);
+
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
+    EXPECT_EQ(orderBook->getAskSize(151.0), 30);
+}
+
+// Test a FOK order trades only when the whole quantity is available
+TEST_F(MatchingEngineTest, FillOrKill) {
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 30));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.0, 30));
+
+    auto tooLarge = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 151.0, 61, TimeInForce::FOK);
+    EXPECT_TRUE(matchingEngine->processOrder(tooLarge).empty());
+    EXPECT_EQ(tooLarge->getQuantity(), 61);
+
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAskSize(150.0), 30);
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
+
+    auto fits = OrderFactory::createMarketOrder("AAPL", OrderSide::BUY, 45, TimeInForce::FOK);
+    auto trades = matchingEngine->processOrder(fits);
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(fits->getQuantity(), 0);
+    EXPECT_EQ(orderBook->getAskSize(151.0), 15);
+}
+
+// Test DAY orders rest like GTC until expired
+TEST_F(MatchingEngineTest, ExpireDayOrders) {
+    auto dayOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 10, TimeInForce::DAY);
+    auto gtcOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 149.0, 10);
+    matchingEngine->processOrder(dayOrder);
+    matchingEngine->processOrder(gtcOrder);
+
+    auto expired = matchingEngine->expireDayOrders("AAPL");
+    ASSERT_EQ(expired.size(), 1);
+    EXPECT_EQ(expired[0]->getId(), dayOrder->getId());
+    EXPECT_EQ(matchingEngine->getBestBidPrice("AAPL"), 149.0);
+}
+
+// Test stops park off the book and enter it once a trade crosses them
+TEST_F(MatchingEngineTest, StopOrdersElectedByTrades) {
+    auto buyStop = OrderFactory::createStopOrder("AAPL", OrderSide::BUY, 151.0, 10);
+    auto sellStop = OrderFactory::createStopLimitOrder("AAPL", OrderSide::SELL, 149.0, 148.0, 10);
+    EXPECT_TRUE(matchingEngine->processOrder(buyStop).empty());
+    EXPECT_TRUE(matchingEngine->processOrder(sellStop).empty());
+
+    auto orderBook = matchingEngine->getOrderBook("AAPL");
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0);
+    EXPECT_EQ(matchingEngine->getStopBook("AAPL")->getParkedCount(), 2);
+
+    // A trade at 150 triggers neither stop
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 150.0, 5));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 5));
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), nullptr);
+
+    // A trade at 151 elects the buy stop as a market order
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.0, 5));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 152.0, 20));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 151.0, 5));
+
+    auto elected = matchingEngine->popElectedOrder("AAPL");
+    ASSERT_EQ(elected, buyStop);
+    EXPECT_TRUE(elected->isMarket());
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), nullptr);
+
+    auto trades = matchingEngine->processOrder(elected);
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0]->getPrice(), 152.0);
+    EXPECT_EQ(matchingEngine->getStopBook("AAPL")->getParkedCount(), 1);
+
+    // Cancelling reaches parked stops too
+    EXPECT_TRUE(matchingEngine->cancelOrder(sellStop->getId(), "AAPL"));
+    EXPECT_EQ(matchingEngine->getStopBook("AAPL")->getParkedCount(), 0);
+}
+
+// Test stops crossed by one trade are elected nearest trigger first
+TEST_F(MatchingEngineTest, StopElectionOrder) {
+    auto farStop = OrderFactory::createStopLimitOrder("AAPL", OrderSide::SELL, 145.0, 140.0, 10);
+    auto nearStop = OrderFactory::createStopLimitOrder("AAPL", OrderSide::SELL, 148.0, 140.0, 10);
+    auto laterNearStop = OrderFactory::createStopLimitOrder("AAPL", OrderSide::SELL, 148.0, 140.0, 10);
+    matchingEngine->processOrder(farStop);
+    matchingEngine->processOrder(nearStop);
+    matchingEngine->processOrder(laterNearStop);
+
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 144.0, 5));
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 144.0, 5));
+
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), nearStop);
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), laterNearStop);
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), farStop);
+    EXPECT_EQ(matchingEngine->popElectedOrder("AAPL"), nullptr);
+}
+
+// Test an aggressor sweeps an iceberg's reserve, and an incoming iceberg
+// rests only its displayed slice
+TEST_F(MatchingEngineTest, IcebergOrders) {
+    auto iceberg = OrderFactory::createIcebergOrder("AAPL", OrderSide::SELL, 150.0, 100, 25);
+    matchingEngine->processOrder(iceberg);
+    EXPECT_EQ(matchingEngine->getAskSize("AAPL", 150.0), 25);
+
+    auto buyOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.0, 60, TimeInForce::FOK);
+    auto trades = matchingEngine->processOrder(buyOrder);
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[2]->getQuantity(), 10);
+    EXPECT_EQ(iceberg->getTotalQuantity(), 40);
+    EXPECT_EQ(matchingEngine->getAskSize("AAPL", 150.0), 15);
+
+    auto buyIceberg = OrderFactory::createIcebergOrder("AAPL", OrderSide::BUY, 150.0, 100, 20);
+    trades = matchingEngine->processOrder(buyIceberg);
+    EXPECT_EQ(trades.size(), 3);
+    EXPECT_EQ(buyIceberg->getTotalQuantity(), 60);
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 150.0), 20);
+}
+
+TEST_F(MatchingEngineTest, ModifyOrder) {
+    auto buyOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 149.0, 100);
+    auto sellOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.0, 50);
+    matchingEngine->processOrder(buyOrder);
+    matchingEngine->processOrder(sellOrder);
+
+    std::vector<std::shared_ptr<Trade>> trades;
+    EXPECT_TRUE(matchingEngine->modifyOrder(buyOrder->getId(), "AAPL", 149.0, 80, trades));
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 149.0), 80);
+
+    EXPECT_TRUE(matchingEngine->modifyOrder(buyOrder->getId(), "AAPL", 150.0, 80, trades));
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 149.0), 0);
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 150.0), 80);
+    EXPECT_TRUE(trades.empty());
+
+    // Repricing through the ask trades and rests the remainder
+    EXPECT_TRUE(matchingEngine->modifyOrder(buyOrder->getId(), "AAPL", 151.0, 80, trades));
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0]->getQuantity(), 50);
+    EXPECT_EQ(trades[0]->getPrice(), 151.0);
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 151.0), 30);
+
+    EXPECT_FALSE(matchingEngine->modifyOrder("non-existent-id", "AAPL", 150.0, 10, trades));
+}
+
+TEST_F(MatchingEngineTest, AuctionMode) {
+    EXPECT_TRUE(matchingEngine->setMatchingMode("AAPL", MatchingMode::AUCTION));
+    EXPECT_FALSE(matchingEngine->setMatchingMode("MSFT", MatchingMode::AUCTION));
+
+    // Crossing orders collect instead of trading; IOC has nothing to hit
+    EXPECT_TRUE(matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 101.0, 30)).empty());
+    EXPECT_TRUE(matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 99.0, 20)).empty());
+    EXPECT_TRUE(matchingEngine->processOrder(
+        OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 99.0, 20, TimeInForce::IOC)).empty());
+    EXPECT_EQ(matchingEngine->getAskSize("AAPL", 99.0), 20);
+
+    // Cannot go back to continuous matching with a crossed book
+    EXPECT_FALSE(matchingEngine->setMatchingMode("AAPL", MatchingMode::CONTINUOUS));
+
+    auto trades = matchingEngine->uncross("AAPL");
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0]->getQuantity(), 20);
+    EXPECT_EQ(trades[0]->getPrice(), 99.0);
+    EXPECT_EQ(matchingEngine->getBidSize("AAPL", 101.0), 10);
+
+    EXPECT_TRUE(matchingEngine->setMatchingMode("AAPL", MatchingMode::CONTINUOUS));
+    EXPECT_EQ(matchingEngine->processOrder(OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 101.0, 10)).size(), 1);
+}
+
+TEST_F(MatchingEngineTest, ProRataAllocation) {
+    ASSERT_TRUE(matchingEngine->addSymbol("ES", MatchingMode::CONTINUOUS, AllocationPolicy::PRO_RATA));
+    auto a = OrderFactory::createLimitOrder("ES", OrderSide::SELL, 100.0, 10);
+    auto b = OrderFactory::createLimitOrder("ES", OrderSide::SELL, 100.0, 30);
+    auto c = OrderFactory::createLimitOrder("ES", OrderSide::SELL, 100.0, 60);
+    matchingEngine->processOrder(a);
+    matchingEngine->processOrder(b);
+    matchingEngine->processOrder(c);
+
+    auto trades = matchingEngine->processOrder(OrderFactory::createLimitOrder("ES", OrderSide::BUY, 100.0, 50));
+    EXPECT_EQ(trades.size(), 3);
+    EXPECT_EQ(a->getQuantity(), 5);
+    EXPECT_EQ(b->getQuantity(), 15);
+    EXPECT_EQ(c->getQuantity(), 30);
+
+    // 7 lots: floors of 0.7, 2.1 and 4.2 leave one lot for time priority
+    matchingEngine->processOrder(OrderFactory::createLimitOrder("ES", OrderSide::BUY, 100.0, 7));
+    EXPECT_EQ(a->getQuantity(), 4);
+    EXPECT_EQ(b->getQuantity(), 13);
+    EXPECT_EQ(c->getQuantity(), 26);
+    EXPECT_EQ(matchingEngine->getAskSize("ES", 100.0), 43);
+}
+
+TEST_F(MatchingEngineTest, TopProRataAllocation) {
+    ASSERT_TRUE(matchingEngine->addSymbol("ZN", MatchingMode::CONTINUOUS, AllocationPolicy::TOP_PRO_RATA));
+    EXPECT_EQ(matchingEngine->getAllocationPolicy("ZN"), AllocationPolicy::TOP_PRO_RATA);
+    auto a = OrderFactory::createLimitOrder("ZN", OrderSide::BUY, 100.0, 10);
+    auto b = OrderFactory::createLimitOrder("ZN", OrderSide::BUY, 100.0, 30);
+    auto c = OrderFactory::createLimitOrder("ZN", OrderSide::BUY, 100.0, 60);
+    matchingEngine->processOrder(a);
+    matchingEngine->processOrder(b);
+    matchingEngine->processOrder(c);
+
+    // The top order fills first; 40 lots are then shared 13 / 26 plus one by time
+    auto trades = matchingEngine->processOrder(OrderFactory::createLimitOrder("ZN", OrderSide::SELL, 99.0, 50));
+    EXPECT_EQ(trades.size(), 3);
+    EXPECT_EQ(a->getQuantity(), 0);
+    EXPECT_EQ(b->getQuantity(), 16);
+    EXPECT_EQ(c->getQuantity(), 34);
+    EXPECT_EQ(trades[0]->getPrice(), 100.0);
+}
@@ -77,3 +77,143 @@ TEST_F(OrderBookTest, GetSizes) {
     EXPECT_EQ(0, orderBook->getBidSize(999.99));
     EXPECT_EQ(0, orderBook->getAskSize(999.99));
 }
+
+TEST_F(OrderBookTest, LevelKeepsTimePriorityAndTotal) {
+    auto first = std::make_shared<Order>("L1", "AAPL", OrderSide::SELL, 150.75, 10);
+    auto second = std::make_shared<Order>("L2", "AAPL", OrderSide::SELL, 150.75, 20);
+    EXPECT_TRUE(orderBook->addOrder(first));
+    EXPECT_TRUE(orderBook->addOrder(second));
+    EXPECT_EQ(30, orderBook->getAskSize(150.75));
+    EXPECT_EQ(first, orderBook->getBestOrder(OrderSide::SELL));
+
+    // Partial fill keeps the order first in line
+    orderBook->fillOrder(first, 4);
+    EXPECT_EQ(6, first->getQuantity());
+    EXPECT_EQ(26, orderBook->getAskSize(150.75));
+    EXPECT_EQ(first, orderBook->getBestOrder(OrderSide::SELL));
+
+    // A full fill removes it
+    orderBook->fillOrder(first, 6);
+    EXPECT_EQ(0, first->getQuantity());
+    EXPECT_EQ(second, orderBook->getBestOrder(OrderSide::SELL));
+    EXPECT_EQ(nullptr, orderBook->getOrderById("L1"));
+
+    EXPECT_TRUE(orderBook->cancelOrder("L2"));
+    EXPECT_EQ(0, orderBook->getAskSize(150.75));
+    EXPECT_EQ(nullptr, orderBook->getBestOrder(OrderSide::SELL));
+}
+
+TEST_F(OrderBookTest, MatchableQuantity) {
+    orderBook->addOrder(sellOrder1);
+    orderBook->addOrder(sellOrder2);
+
+    Order limitBuy("Q1", "AAPL", OrderSide::BUY, 150.75, 60);
+    EXPECT_EQ(50, orderBook->getMatchableQuantity(limitBuy));
+
+    Order marketBuy("Q2", "AAPL", OrderSide::BUY, 0.0, 60, OrderType::MARKET, TimeInForce::IOC);
+    EXPECT_EQ(75, orderBook->getMatchableQuantity(marketBuy));
+
+    Order lowSell("Q3", "AAPL", OrderSide::SELL, 150.0, 10);
+    EXPECT_EQ(0, orderBook->getMatchableQuantity(lowSell));
+}
+
+TEST_F(OrderBookTest, ExpireDayOrders) {
+    auto dayOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.25, 10, TimeInForce::DAY);
+    orderBook->addOrder(buyOrder1);
+    orderBook->addOrder(dayOrder);
+
+    auto expired = orderBook->expireDayOrders();
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(dayOrder, expired[0]);
+    EXPECT_EQ(100, orderBook->getBidSize(150.25));
+    EXPECT_EQ(1u, orderBook->getAllBuyOrders().size());
+}
+
+TEST_F(OrderBookTest, IcebergShowsSliceAndRequeues) {
+    auto iceberg = OrderFactory::createIcebergOrder("AAPL", OrderSide::SELL, 150.75, 100, 30);
+    auto other = std::make_shared<Order>("I2", "AAPL", OrderSide::SELL, 150.75, 20);
+    ASSERT_NE(nullptr, iceberg);
+    orderBook->addOrder(iceberg);
+    orderBook->addOrder(other);
+
+    // Depth shows only the displayed slice
+    EXPECT_EQ(50, orderBook->getAskSize(150.75));
+    EXPECT_EQ(30, iceberg->getQuantity());
+    EXPECT_EQ(70, iceberg->getHiddenQuantity());
+
+    // Exhausting the slice refills it and sends the order behind `other`
+    orderBook->fillOrder(iceberg, 30);
+    EXPECT_EQ(30, iceberg->getQuantity());
+    EXPECT_EQ(40, iceberg->getHiddenQuantity());
+    EXPECT_EQ(50, orderBook->getAskSize(150.75));
+    EXPECT_EQ(other, orderBook->getBestOrder(OrderSide::SELL));
+
+    // The last slice is smaller than the peak
+    orderBook->fillOrder(other, 20);
+    orderBook->fillOrder(iceberg, 30);
+    orderBook->fillOrder(iceberg, 30);
+    EXPECT_EQ(10, iceberg->getQuantity());
+    EXPECT_EQ(0, iceberg->getHiddenQuantity());
+    EXPECT_EQ(10, orderBook->getAskSize(150.75));
+
+    orderBook->fillOrder(iceberg, 10);
+    EXPECT_EQ(nullptr, orderBook->getOrderById(iceberg->getId()));
+    EXPECT_EQ(0, orderBook->getAskSize(150.75));
+}
+
+TEST_F(OrderBookTest, ResizeOrder) {
+    auto other = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.25, 40);
+    orderBook->addOrder(buyOrder1);
+    orderBook->addOrder(other);
+
+    // A decrease keeps the order at the front of its level
+    EXPECT_TRUE(orderBook->resizeOrder(buyOrder1->getId(), 60));
+    EXPECT_EQ(60, buyOrder1->getQuantity());
+    EXPECT_EQ(100, orderBook->getBidSize(150.25));
+    EXPECT_EQ(buyOrder1, orderBook->getBestOrder(OrderSide::BUY));
+
+    // An increase loses priority
+    EXPECT_TRUE(orderBook->resizeOrder(buyOrder1->getId(), 80));
+    EXPECT_EQ(120, orderBook->getBidSize(150.25));
+    EXPECT_EQ(other, orderBook->getBestOrder(OrderSide::BUY));
+
+    EXPECT_FALSE(orderBook->resizeOrder(buyOrder1->getId(), 0));
+    EXPECT_FALSE(orderBook->resizeOrder("non-existent-id", 10));
+}
+
+TEST_F(OrderBookTest, RepriceOrder) {
+    orderBook->addOrder(buyOrder1);
+    orderBook->addOrder(buyOrder2);
+
+    EXPECT_TRUE(orderBook->repriceOrder(buyOrder1->getId(), 150.50, 30));
+    EXPECT_DOUBLE_EQ(150.50, buyOrder1->getPrice());
+    EXPECT_EQ(0, orderBook->getBidSize(150.25));
+    EXPECT_EQ(105, orderBook->getBidSize(150.50));
+    EXPECT_EQ(buyOrder2, orderBook->getBestOrder(OrderSide::BUY));
+    EXPECT_EQ(buyOrder1, orderBook->getOrderById(buyOrder1->getId()));
+    EXPECT_EQ(2u, orderBook->getAllBuyOrders().size());
+}
+
+TEST_F(OrderBookTest, CancelOwnerOrders) {
+    auto owned1 = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.25, 10, "alice");
+    auto owned2 = OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 151.00, 10, "alice");
+    auto other = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.25, 20, "bob");
+    orderBook->addOrder(owned1);
+    orderBook->addOrder(owned2);
+    orderBook->addOrder(other);
+    orderBook->addOrder(buyOrder1);
+
+    // An order that already left the book is not cancelled again
+    orderBook->fillOrder(owned2, 10);
+
+    auto cancelled = orderBook->cancelOwnerOrders("alice");
+    ASSERT_EQ(1u, cancelled.size());
+    EXPECT_EQ(owned1, cancelled[0]);
+    EXPECT_EQ(120, orderBook->getBidSize(150.25));
+    EXPECT_TRUE(orderBook->cancelOwnerOrders("alice").empty());
+    EXPECT_TRUE(orderBook->cancelOwnerOrders("").empty());
+
+    EXPECT_EQ(2u, orderBook->cancelAllOrders().size());
+    EXPECT_DOUBLE_EQ(0.0, orderBook->getBestBidPrice());
+    EXPECT_TRUE(orderBook->cancelOwnerOrders("bob").empty());
+}
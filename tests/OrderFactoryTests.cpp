@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "order/OrderFactory.hpp"
+#include <cmath>
 
 TEST(OrderFactoryTest, CreateLimitOrder) {
     auto order = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, 150.25, 100);
@@ -29,6 +30,12 @@ TEST(OrderFactoryTest, InvalidLimitOrder) {
     // Test with invalid price
     invalidOrder = OrderFactory::createLimitOrder("AAPL", OrderSide::BUY, -5.0, 100);
     EXPECT_EQ(nullptr, invalidOrder);
+
+    // Test with zero and non-finite prices
+    EXPECT_EQ(nullptr, OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, 0.0, 100));
+    EXPECT_EQ(nullptr, OrderFactory::createLimitOrder("AAPL", OrderSide::SELL, std::nan(""), 100));
+    EXPECT_EQ(nullptr, OrderFactory::createStopLimitOrder("AAPL", OrderSide::SELL, 140.0, 0.0, 100));
+    EXPECT_EQ(nullptr, OrderFactory::createStopOrder("AAPL", OrderSide::SELL, INFINITY, 100));
 }
 
 TEST(OrderFactoryTest, InvalidMarketOrder) {
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "../workload/OrderFlowGenerator.hpp"
+#include "../workload/OrderFlowFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+OrderFlowConfig testConfig() {
+    OrderFlowConfig config;
+    config.seed = 7;
+    config.symbolCount = 8;
+    config.zipfExponent = 1.2;
+    config.cancelRatio = 0.3;
+    config.aggressorRatio = 0.2;
+    config.meanRatePerSecond = 100000.0;
+    return config;
+}
+
+bool sameEvent(const OrderFlowEvent& a, const OrderFlowEvent& b) {
+    return std::memcmp(&a, &b, sizeof(OrderFlowEvent)) == 0;
+}
+
+} // namespace
+
+// Test that the same seed produces the same stream and a different seed does not
+TEST(OrderFlowGeneratorTest, DeterministicForSeed) {
+    auto first = OrderFlowGenerator(testConfig()).generate(5000);
+    auto second = OrderFlowGenerator(testConfig()).generate(5000);
+
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        ASSERT_TRUE(sameEvent(first[i], second[i])) << "event " << i;
+    }
+
+    auto config = testConfig();
+    config.seed = 8;
+    auto other = OrderFlowGenerator(config).generate(5000);
+    size_t identical = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        identical += sameEvent(first[i], other[i]) ? 1 : 0;
+    }
+    EXPECT_LT(identical, first.size() / 10);
+}
+
+// Test the message mix and symbol skew follow the configuration
+TEST(OrderFlowGeneratorTest, MixAndSkew) {
+    auto events = OrderFlowGenerator(testConfig()).generate(50000);
+
+    size_t cancels = 0;
+    size_t aggressors = 0;
+    std::vector<size_t> perSymbol(8, 0);
+    for (const auto& event : events) {
+        cancels += event.action == OrderFlowAction::CANCEL ? 1 : 0;
+        aggressors += event.aggressive ? 1 : 0;
+        perSymbol[event.symbolIndex]++;
+    }
+
+    double total = static_cast<double>(events.size());
+    EXPECT_NEAR(cancels / total, 0.3, 0.03);
+    EXPECT_NEAR(aggressors / total, 0.2, 0.03);
+
+    // Zipf: popularity falls with rank
+    EXPECT_GT(perSymbol[0], perSymbol[1]);
+    EXPECT_GT(perSymbol[1], perSymbol[7]);
+}
+
+// Test cancels only target live orders of the same symbol, each at most once
+TEST(OrderFlowGeneratorTest, CancelsTargetLiveOrders) {
+    auto events = OrderFlowGenerator(testConfig()).generate(20000);
+
+    std::unordered_map<uint64_t, uint32_t> added;
+    std::unordered_set<uint64_t> cancelled;
+    for (const auto& event : events) {
+        if (event.action == OrderFlowAction::ADD) {
+            EXPECT_TRUE(added.emplace(event.orderSequence, event.symbolIndex).second);
+            EXPECT_GT(event.quantity, 0);
+            EXPECT_GT(event.price, 0.0);
+            continue;
+        }
+        auto it = added.find(event.orderSequence);
+        ASSERT_NE(it, added.end());
+        EXPECT_EQ(it->second, event.symbolIndex);
+        EXPECT_TRUE(cancelled.insert(event.orderSequence).second);
+    }
+}
+
+// Test passive orders rest behind the mid and aggressors cross it
+TEST(OrderFlowGeneratorTest, PricesClusterAroundMid) {
+    auto config = testConfig();
+    config.midVolatilityTicks = 0.0;
+    config.midReversion = 0.0;
+    auto events = OrderFlowGenerator(config).generate(10000);
+
+    for (const auto& event : events) {
+        if (event.action != OrderFlowAction::ADD) {
+            continue;
+        }
+        bool belowMid = event.price < config.startMid - config.tickSize / 2;
+        bool aboveMid = event.price > config.startMid + config.tickSize / 2;
+        if (event.aggressive) {
+            EXPECT_FALSE(event.side == OrderSide::BUY ? belowMid : aboveMid);
+        } else {
+            EXPECT_TRUE(event.side == OrderSide::BUY ? belowMid : aboveMid);
+        }
+    }
+}
+
+// Test arrival timestamps are monotonic at roughly the configured rate, faster in bursts
+TEST(OrderFlowGeneratorTest, PoissonArrivalsAndBursts) {
+    auto events = OrderFlowGenerator(testConfig()).generate(50000);
+    for (size_t i = 1; i < events.size(); ++i) {
+        ASSERT_GE(events[i].timestampNanos, events[i - 1].timestampNanos);
+    }
+    double seconds = static_cast<double>(events.back().timestampNanos) / 1e9;
+    EXPECT_NEAR(events.size() / seconds, 100000.0, 5000.0);
+
+    auto bursty = testConfig();
+    bursty.burstProbability = 0.01;
+    auto burstEvents = OrderFlowGenerator(bursty).generate(50000);
+    EXPECT_LT(burstEvents.back().timestampNanos, events.back().timestampNanos);
+}
+
+// Test a stream survives a binary file round trip and bad files are rejected
+TEST(OrderFlowGeneratorTest, FileRoundTrip) {
+    auto events = OrderFlowGenerator(testConfig()).generate(1000);
+    std::string path = "/tmp/order_flow_test_" + std::to_string(getpid()) + ".bin";
+
+    ASSERT_TRUE(writeOrderFlowFile(path, events));
+    std::vector<OrderFlowEvent> loaded;
+    ASSERT_TRUE(readOrderFlowFile(path, loaded));
+    ASSERT_EQ(loaded.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        ASSERT_TRUE(sameEvent(loaded[i], events[i]));
+    }
+
+    // Truncate the last record
+    ASSERT_EQ(truncate(path.c_str(), 24 + 999 * sizeof(OrderFlowEvent) + 10), 0);
+    EXPECT_FALSE(readOrderFlowFile(path, loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(readOrderFlowFile(path, loaded));
+}
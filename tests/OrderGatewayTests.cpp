@@ -0,0 +1,341 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <thread>
+#include "../gateway/OrderGateway.hpp"
+
+class OrderGatewayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        engine = std::make_unique<ContinuousMatchingEngine>(2);
+        engine->addSymbol("AAPL");
+        engine->start();
+
+        gateway = std::make_unique<OrderGateway>(*engine, 2);
+        ASSERT_TRUE(gateway->start(0));
+    }
+
+    void TearDown() override {
+        gateway->stop();
+        engine->stop();
+    }
+
+    int connectClient() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(gateway->getPort());
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        EXPECT_EQ(0, connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+
+        timeval timeout{2, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return fd;
+    }
+
+    static void sendNewOrder(int fd, uint64_t clientOrderId, WireSide side, double price, int quantity) {
+        auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+        message.clientOrderId = clientOrderId;
+        encodeSymbol("AAPL", message.symbol);
+        message.side = side;
+        message.price = price;
+        message.quantity = quantity;
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(message)), send(fd, &message, sizeof(message), 0));
+    }
+
+    static void sendCancel(int fd, uint64_t clientOrderId) {
+        auto message = makeMessage<CancelOrderMessage>(MessageType::CANCEL_ORDER);
+        message.clientOrderId = clientOrderId;
+        encodeSymbol("AAPL", message.symbol);
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(message)), send(fd, &message, sizeof(message), 0));
+    }
+
+    static void sendModify(int fd, uint64_t clientOrderId, double price, int quantity) {
+        auto message = makeMessage<ModifyOrderMessage>(MessageType::MODIFY_ORDER);
+        message.clientOrderId = clientOrderId;
+        encodeSymbol("AAPL", message.symbol);
+        message.price = price;
+        message.quantity = quantity;
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(message)), send(fd, &message, sizeof(message), 0));
+    }
+
+    static ExecutionReportMessage readReport(int fd) {
+        ExecutionReportMessage report{};
+        size_t received = 0;
+        while (received < sizeof(report)) {
+            ssize_t n = recv(fd, reinterpret_cast<char*>(&report) + received, sizeof(report) - received, 0);
+            if (n <= 0) {
+                ADD_FAILURE() << "Timed out waiting for an execution report";
+                return report;
+            }
+            received += static_cast<size_t>(n);
+        }
+        return report;
+    }
+
+    std::unique_ptr<ContinuousMatchingEngine> engine;
+    std::unique_ptr<OrderGateway> gateway;
+};
+
+// Test that a resting order is acknowledged to its session
+TEST_F(OrderGatewayTest, NewOrderAcknowledged) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 1, WireSide::BUY, 150.0, 100);
+    auto report = readReport(fd);
+
+    EXPECT_EQ(report.header.type, MessageType::EXECUTION_REPORT);
+    EXPECT_EQ(report.clientOrderId, 1u);
+    EXPECT_EQ(report.reportType, ExecutionReportType::NEW);
+    EXPECT_EQ(report.leavesQuantity, 100);
+    EXPECT_EQ(decodeSymbol(report.symbol), "AAPL");
+
+    close(fd);
+}
+
+// Test that fills are reported to both sessions involved in a trade
+TEST_F(OrderGatewayTest, FillsReportedToBothSessions) {
+    int seller = connectClient();
+    int buyer = connectClient();
+
+    sendNewOrder(seller, 7, WireSide::SELL, 150.0, 100);
+    EXPECT_EQ(readReport(seller).reportType, ExecutionReportType::NEW);
+
+    sendNewOrder(buyer, 7, WireSide::BUY, 150.0, 40);
+    EXPECT_EQ(readReport(buyer).reportType, ExecutionReportType::NEW);
+
+    auto buyerFill = readReport(buyer);
+    EXPECT_EQ(buyerFill.reportType, ExecutionReportType::FILL);
+    EXPECT_EQ(buyerFill.lastQuantity, 40);
+    EXPECT_EQ(buyerFill.leavesQuantity, 0);
+    EXPECT_DOUBLE_EQ(buyerFill.lastPrice, 150.0);
+
+    auto sellerFill = readReport(seller);
+    EXPECT_EQ(sellerFill.clientOrderId, 7u);
+    EXPECT_EQ(sellerFill.reportType, ExecutionReportType::PARTIAL_FILL);
+    EXPECT_EQ(sellerFill.lastQuantity, 40);
+    EXPECT_EQ(sellerFill.leavesQuantity, 60);
+
+    close(seller);
+    close(buyer);
+}
+
+// Test cancelling a resting order and rejecting a cancel for an unknown order
+TEST_F(OrderGatewayTest, CancelOrder) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 3, WireSide::SELL, 160.0, 10);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::NEW);
+
+    sendCancel(fd, 3);
+    auto cancelled = readReport(fd);
+    EXPECT_EQ(cancelled.clientOrderId, 3u);
+    EXPECT_EQ(cancelled.reportType, ExecutionReportType::CANCELLED);
+    EXPECT_EQ(cancelled.leavesQuantity, 0);
+
+    sendCancel(fd, 99);
+    auto rejected = readReport(fd);
+    EXPECT_EQ(rejected.clientOrderId, 99u);
+    EXPECT_EQ(rejected.reportType, ExecutionReportType::CANCEL_REJECTED);
+
+    close(fd);
+}
+
+// Test that a cancel/replace is acknowledged once with the new size
+TEST_F(OrderGatewayTest, ModifyOrder) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 4, WireSide::SELL, 160.0, 10);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::NEW);
+
+    sendModify(fd, 4, 159.0, 6);
+    auto replaced = readReport(fd);
+    EXPECT_EQ(replaced.clientOrderId, 4u);
+    EXPECT_EQ(replaced.reportType, ExecutionReportType::REPLACED);
+    EXPECT_EQ(replaced.leavesQuantity, 6);
+
+    sendModify(fd, 99, 159.0, 6);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::REPLACE_REJECTED);
+
+    close(fd);
+}
+
+// Test that a session's resting orders are cancelled when it disconnects
+TEST_F(OrderGatewayTest, CancelOnDisconnect) {
+    int leaving = connectClient();
+    int staying = connectClient();
+
+    sendNewOrder(leaving, 1, WireSide::SELL, 160.0, 10);
+    sendNewOrder(leaving, 2, WireSide::BUY, 140.0, 10);
+    sendNewOrder(staying, 1, WireSide::SELL, 161.0, 10);
+    EXPECT_EQ(readReport(leaving).reportType, ExecutionReportType::NEW);
+    EXPECT_EQ(readReport(leaving).reportType, ExecutionReportType::NEW);
+    EXPECT_EQ(readReport(staying).reportType, ExecutionReportType::NEW);
+
+    close(leaving);
+
+    auto orderBook = engine->getOrderBook("AAPL");
+    for (int i = 0; i < 100 && orderBook->getAllBuyOrders().size() + orderBook->getAllSellOrders().size() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0u);
+    ASSERT_EQ(orderBook->getAllSellOrders().size(), 1u);
+    EXPECT_DOUBLE_EQ(orderBook->getAllSellOrders()[0]->getPrice(), 161.0);
+
+    close(staying);
+}
+
+// Test that an order refused by a full shard queue is rejected to its
+// session and its client order id freed for reuse
+TEST_F(OrderGatewayTest, FullQueueRejected) {
+    gateway->stop();
+    engine->stop();
+    engine = std::make_unique<ContinuousMatchingEngine>(1);
+    engine->addSymbol("AAPL");
+    engine->setQueueCapacity(1, BackpressurePolicy::REJECT);
+
+    // Hold the shard inside its first command
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::atomic<bool> holding{false};
+    engine->setCommandListener([&](const ContinuousMatchingEngine::OrderRequest&, const OrderBook*) {
+        if (!holding.exchange(true)) {
+            gateOpen.wait();
+        }
+    });
+    engine->start();
+    gateway = std::make_unique<OrderGateway>(*engine, 1);
+    ASSERT_TRUE(gateway->start(0));
+    int fd = connectClient();
+
+    sendNewOrder(fd, 1, WireSide::BUY, 150.0, 10);
+    for (int i = 0; i < 100 && !holding.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(holding.load());
+    sendNewOrder(fd, 2, WireSide::BUY, 149.0, 10);
+    sendNewOrder(fd, 3, WireSide::BUY, 148.0, 10);
+
+    auto refused = readReport(fd);
+    gate.set_value();
+    EXPECT_EQ(refused.clientOrderId, 3u);
+    EXPECT_EQ(refused.reportType, ExecutionReportType::REJECTED);
+    EXPECT_EQ(readReport(fd).clientOrderId, 1u);
+    EXPECT_EQ(readReport(fd).clientOrderId, 2u);
+
+    sendNewOrder(fd, 3, WireSide::BUY, 148.0, 10);
+    auto accepted = readReport(fd);
+    EXPECT_EQ(accepted.clientOrderId, 3u);
+    EXPECT_EQ(accepted.reportType, ExecutionReportType::NEW);
+
+    // The listener captures locals, so stop before the disconnect's mass
+    // cancel can reach it after they are gone
+    close(fd);
+    gateway->stop();
+    engine->stop();
+}
+
+// Test that a session which stops reading is closed once its backlog passes the cap
+TEST_F(OrderGatewayTest, SlowConsumerClosed) {
+    gateway->stop();
+    gateway = std::make_unique<OrderGateway>(*engine, 1);
+    gateway->setMaxPendingOutput(16 * 1024);
+    ASSERT_TRUE(gateway->start(0));
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int receiveBuffer = 4096;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(gateway->getPort());
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    ASSERT_EQ(0, connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+
+    for (int i = 0; i < 100 && gateway->getSessionCount() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(gateway->getSessionCount(), 1u);
+
+    // Every order rests, so each one owes the client a report it never
+    // reads; enough to fill the kernel's buffers and pass the cap
+    for (uint64_t i = 1; i <= 200000 && gateway->getSessionCount() > 0; ++i) {
+        auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+        message.clientOrderId = i;
+        encodeSymbol("AAPL", message.symbol);
+        message.side = WireSide::BUY;
+        message.price = 100.0;
+        message.quantity = 1;
+        if (send(fd, &message, sizeof(message), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(message))) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < 200 && gateway->getSessionCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(gateway->getSessionCount(), 0u);
+
+    close(fd);
+}
+
+// Test that orders for unknown symbols are rejected without reaching the engine
+TEST_F(OrderGatewayTest, UnknownSymbolRejected) {
+    int fd = connectClient();
+
+    auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    message.clientOrderId = 5;
+    encodeSymbol("NOPE", message.symbol);
+    message.side = WireSide::BUY;
+    message.price = 10.0;
+    message.quantity = 1;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(message)), send(fd, &message, sizeof(message), 0));
+
+    auto report = readReport(fd);
+    EXPECT_EQ(report.clientOrderId, 5u);
+    EXPECT_EQ(report.reportType, ExecutionReportType::REJECTED);
+    EXPECT_FALSE(engine->hasSymbol("NOPE"));
+
+    close(fd);
+}
+
+// Test that non-finite prices are rejected before they can reach a book
+TEST_F(OrderGatewayTest, NonFinitePriceRejected) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 6, WireSide::BUY, std::nan(""), 10);
+    auto rejected = readReport(fd);
+    EXPECT_EQ(rejected.clientOrderId, 6u);
+    EXPECT_EQ(rejected.reportType, ExecutionReportType::REJECTED);
+
+    sendNewOrder(fd, 7, WireSide::SELL, 160.0, 10);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::NEW);
+
+    sendModify(fd, 7, std::nan(""), 10);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::REPLACE_REJECTED);
+
+    sendModify(fd, 7, INFINITY, 10);
+    EXPECT_EQ(readReport(fd).reportType, ExecutionReportType::REPLACE_REJECTED);
+
+    close(fd);
+}
+
+// Test that a malformed frame closes the session
+TEST_F(OrderGatewayTest, MalformedFrameClosesSession) {
+    int fd = connectClient();
+
+    MessageHeader header{};
+    header.length = 2; // shorter than the header itself
+    header.type = MessageType::NEW_ORDER;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(header)), send(fd, &header, sizeof(header), 0));
+
+    char byte;
+    EXPECT_EQ(0, recv(fd, &byte, 1, 0));
+
+    close(fd);
+}
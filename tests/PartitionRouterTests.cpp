@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include "../gateway/OrderGateway.hpp"
+#include "../gateway/PartitionRouter.hpp"
+
+// Runs a real order_gateway process per engine, AAPL on engine 0 and MSFT
+// on engine 1, behind an in-process router
+class PartitionRouterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string prefix = "/tmp/partition_router_test_" + std::to_string(getpid());
+        enginePaths = {prefix + "_0.sock", prefix + "_1.sock"};
+        engines.push_back(startEngine(enginePaths[0], "AAPL"));
+        engines.push_back(startEngine(enginePaths[1], "MSFT"));
+        for (const auto& path : enginePaths) {
+            ASSERT_TRUE(waitForEngine(path)) << "engine at " << path << " never came up";
+        }
+
+        gateway = std::make_unique<OrderGateway>([this](ExecutionReportRouter::ReportSink sink) -> std::unique_ptr<FrameHandler> {
+            auto partitionRouter = std::make_unique<PartitionRouter>(enginePaths, std::move(sink));
+            partitionRouter->assignSymbol("AAPL", 0);
+            partitionRouter->assignSymbol("MSFT", 1);
+            router = partitionRouter.get();
+            return partitionRouter;
+        });
+        ASSERT_TRUE(gateway->start(0));
+    }
+
+    void TearDown() override {
+        gateway->stop();
+        gateway.reset();
+        for (pid_t engine : engines) {
+            if (engine > 0) {
+                kill(engine, SIGTERM);
+                waitpid(engine, nullptr, 0);
+            }
+        }
+    }
+
+    static pid_t startEngine(const std::string& path, const char* symbols) {
+        pid_t child = fork();
+        if (child == 0) {
+            int devNull = open("/dev/null", O_WRONLY);
+            dup2(devNull, STDOUT_FILENO);
+            execl(ORDER_GATEWAY_PATH, "order_gateway", "--unix", path.c_str(),
+                  "--symbols", symbols, "--threads", "1", static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        return child;
+    }
+
+    static bool waitForEngine(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        for (int i = 0; i < 500; ++i) {
+            int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            bool connected = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+            close(fd);
+            if (connected) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    int connectClient() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(gateway->getPort());
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        EXPECT_EQ(0, connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+
+        timeval timeout{2, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return fd;
+    }
+
+    static void sendNewOrder(int fd, uint64_t clientOrderId, const std::string& symbol, WireSide side,
+                             double price, int quantity, WireTimeInForce timeInForce = WireTimeInForce::GTC) {
+        auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+        message.clientOrderId = clientOrderId;
+        encodeSymbol(symbol, message.symbol);
+        message.side = side;
+        message.timeInForce = timeInForce;
+        message.price = price;
+        message.quantity = quantity;
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(message)), send(fd, &message, sizeof(message), 0));
+    }
+
+    static ExecutionReportMessage readReport(int fd) {
+        ExecutionReportMessage report{};
+        size_t received = 0;
+        while (received < sizeof(report)) {
+            ssize_t n = recv(fd, reinterpret_cast<char*>(&report) + received, sizeof(report) - received, 0);
+            if (n <= 0) {
+                ADD_FAILURE() << "Timed out waiting for an execution report";
+                return report;
+            }
+            received += static_cast<size_t>(n);
+        }
+        return report;
+    }
+
+    std::vector<std::string> enginePaths;
+    std::vector<pid_t> engines;
+    std::unique_ptr<OrderGateway> gateway;
+    PartitionRouter* router = nullptr;
+};
+
+// Test that each symbol reaches the only engine that lists it
+TEST_F(PartitionRouterTest, RoutesSymbolsToTheirEngine) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 1, "AAPL", WireSide::BUY, 100.0, 10);
+    sendNewOrder(fd, 2, "MSFT", WireSide::BUY, 200.0, 10);
+
+    std::map<uint64_t, ExecutionReportType> reports;
+    for (int i = 0; i < 2; ++i) {
+        auto report = readReport(fd);
+        reports[report.clientOrderId] = report.reportType;
+    }
+    EXPECT_EQ(reports[1], ExecutionReportType::NEW);
+    EXPECT_EQ(reports[2], ExecutionReportType::NEW);
+    EXPECT_EQ(router->getUpstreamCount(), 2u);
+    EXPECT_EQ(router->getEngineForSymbol("MSFT"), 1u);
+
+    close(fd);
+}
+
+// Test that reports merged from both engines stay in each symbol's sequence
+TEST_F(PartitionRouterTest, MergedReportsKeepSymbolSequence) {
+    int seller = connectClient();
+    int buyer = connectClient();
+
+    sendNewOrder(seller, 1, "AAPL", WireSide::SELL, 100.0, 10);
+    sendNewOrder(seller, 2, "MSFT", WireSide::SELL, 200.0, 10);
+    readReport(seller);
+    readReport(seller);
+
+    for (uint64_t i = 0; i < 5; ++i) {
+        sendNewOrder(buyer, 10 + i, "AAPL", WireSide::BUY, 100.0, 2);
+        sendNewOrder(buyer, 20 + i, "MSFT", WireSide::BUY, 200.0, 2);
+    }
+
+    std::map<std::string, uint32_t> lastSequence;
+    std::map<std::string, int> filled;
+    while (filled["AAPL"] < 10 || filled["MSFT"] < 10) {
+        auto report = readReport(buyer);
+        if (report.header.length == 0) {
+            break;
+        }
+        std::string symbol = decodeSymbol(report.symbol);
+        EXPECT_GT(report.sequence, lastSequence[symbol]) << symbol;
+        lastSequence[symbol] = report.sequence;
+        filled[symbol] += report.lastQuantity;
+    }
+    EXPECT_EQ(filled["AAPL"], 10);
+    EXPECT_EQ(filled["MSFT"], 10);
+
+    close(seller);
+    close(buyer);
+}
+
+// Test that closing a client session cancels its orders on every engine
+TEST_F(PartitionRouterTest, CancelOnDisconnectReachesEveryEngine) {
+    int leaving = connectClient();
+    int staying = connectClient();
+
+    sendNewOrder(leaving, 1, "AAPL", WireSide::SELL, 100.0, 10);
+    sendNewOrder(leaving, 2, "MSFT", WireSide::SELL, 200.0, 10);
+    EXPECT_EQ(readReport(leaving).reportType, ExecutionReportType::NEW);
+    EXPECT_EQ(readReport(leaving).reportType, ExecutionReportType::NEW);
+    close(leaving);
+
+    for (int i = 0; i < 100 && router->getUpstreamCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(router->getUpstreamCount(), 0u);
+    // Give each engine time to act on its closed session
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // A full-size IOC finds nothing left to hit on either engine
+    sendNewOrder(staying, 3, "AAPL", WireSide::BUY, 100.0, 10, WireTimeInForce::IOC);
+    sendNewOrder(staying, 4, "MSFT", WireSide::BUY, 200.0, 10, WireTimeInForce::IOC);
+    EXPECT_EQ(readReport(staying).reportType, ExecutionReportType::CANCELLED);
+    EXPECT_EQ(readReport(staying).reportType, ExecutionReportType::CANCELLED);
+
+    close(staying);
+}
+
+// Test that orders left working on an engine that goes away are reported cancelled
+TEST_F(PartitionRouterTest, EngineExitCancelsWorkingOrders) {
+    int fd = connectClient();
+
+    sendNewOrder(fd, 1, "AAPL", WireSide::BUY, 100.0, 10);
+    sendNewOrder(fd, 2, "AAPL", WireSide::SELL, 101.0, 10);
+    sendNewOrder(fd, 3, "AAPL", WireSide::BUY, 101.0, 10);
+    sendNewOrder(fd, 4, "MSFT", WireSide::BUY, 200.0, 10);
+
+    // 1 and 4 rest; 2 and 3 fill against each other
+    std::map<uint64_t, ExecutionReportType> last;
+    for (int i = 0; i < 6; ++i) {
+        auto report = readReport(fd);
+        last[report.clientOrderId] = report.reportType;
+    }
+    EXPECT_EQ(last[1], ExecutionReportType::NEW);
+    EXPECT_EQ(last[2], ExecutionReportType::FILL);
+    EXPECT_EQ(last[3], ExecutionReportType::FILL);
+    EXPECT_EQ(last[4], ExecutionReportType::NEW);
+
+    kill(engines[0], SIGKILL);
+    waitpid(engines[0], nullptr, 0);
+    engines[0] = -1;
+
+    auto cancelled = readReport(fd);
+    EXPECT_EQ(cancelled.clientOrderId, 1u);
+    EXPECT_EQ(cancelled.reportType, ExecutionReportType::CANCELLED);
+    EXPECT_EQ(decodeSymbol(cancelled.symbol), "AAPL");
+    EXPECT_EQ(cancelled.sequence, 0u);
+
+    // The MSFT session is untouched
+    for (int i = 0; i < 100 && router->getUpstreamCount() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(router->getUpstreamCount(), 1u);
+
+    close(fd);
+}
+
+// Test that an order for an engine that cannot be reached is rejected by the router
+TEST(PartitionRouterStandaloneTest, UnreachableEngineRejects) {
+    std::vector<std::pair<uint64_t, ExecutionReportMessage>> reports;
+    PartitionRouter router({"/tmp/partition_router_test_missing.sock"},
+                           [&reports](uint64_t sessionId, const ExecutionReportMessage& report) {
+                               reports.emplace_back(sessionId, report);
+                           });
+
+    auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    message.clientOrderId = 7;
+    encodeSymbol("AAPL", message.symbol);
+    message.side = WireSide::BUY;
+    message.price = 10.0;
+    message.quantity = 1;
+    EXPECT_TRUE(router.handleMessage(3, reinterpret_cast<const char*>(&message), sizeof(message)));
+
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].first, 3u);
+    EXPECT_EQ(reports[0].second.clientOrderId, 7u);
+    EXPECT_EQ(reports[0].second.reportType, ExecutionReportType::REJECTED);
+    EXPECT_EQ(reports[0].second.sequence, 0u);
+    EXPECT_EQ(router.getUpstreamCount(), 0u);
+
+    // A truncated frame is a protocol violation
+    EXPECT_FALSE(router.handleMessage(3, reinterpret_cast<const char*>(&message), sizeof(message) - 1));
+}
+
+// Test that an engine that stops reading never blocks the router
+TEST(PartitionRouterStandaloneTest, StalledEngineBuffersOutput) {
+    std::string path = "/tmp/partition_router_test_stalled_" + std::to_string(getpid()) + ".sock";
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    ASSERT_EQ(0, bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+    ASSERT_EQ(0, listen(listenFd, 4));
+
+    std::atomic<int> rejects{0};
+    PartitionRouter router({path}, [&rejects](uint64_t, const ExecutionReportMessage&) {
+        ++rejects;
+    });
+
+    // Far more than the socket buffer holds, all sent before anything is read
+    const int frames = 50000;
+    auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    encodeSymbol("AAPL", message.symbol);
+    message.side = WireSide::BUY;
+    message.price = 10.0;
+    message.quantity = 1;
+    for (int i = 0; i < frames; ++i) {
+        message.clientOrderId = static_cast<uint64_t>(i);
+        ASSERT_TRUE(router.handleMessage(3, reinterpret_cast<const char*>(&message), sizeof(message)));
+    }
+    EXPECT_EQ(rejects.load(), 0);
+
+    // Once the engine reads, the buffered frames arrive whole and in order
+    int engineFd = accept(listenFd, nullptr, nullptr);
+    ASSERT_GE(engineFd, 0);
+    timeval timeout{2, 0};
+    setsockopt(engineFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    size_t expected = frames * sizeof(NewOrderMessage);
+    std::vector<char> received(expected);
+    size_t total = 0;
+    while (total < expected) {
+        ssize_t n = recv(engineFd, received.data() + total, expected - total, 0);
+        if (n <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(n);
+    }
+    ASSERT_EQ(total, expected);
+    NewOrderMessage last;
+    std::memcpy(&last, received.data() + expected - sizeof(last), sizeof(last));
+    EXPECT_EQ(last.clientOrderId, static_cast<uint64_t>(frames - 1));
+
+    close(engineFd);
+    close(listenFd);
+    unlink(path.c_str());
+}
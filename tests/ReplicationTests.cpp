@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+#include "../order/OrderFactory.hpp"
+#include "../replication/CommandJournal.hpp"
+#include "../replication/ReplicationPrimary.hpp"
+#include "../replication/StandbyEngine.hpp"
+
+using OrderAction = ContinuousMatchingEngine::OrderAction;
+
+// Test that stop-limit and iceberg submits survive the record format
+TEST(CommandJournalTest, EncodeDecodeRoundTrip) {
+    ContinuousMatchingEngine::OrderRequest stopRequest;
+    stopRequest.action = OrderAction::SUBMIT;
+    stopRequest.order = OrderFactory::createStopLimitOrder("AAPL", OrderSide::BUY, 151.0, 152.0, 30, TimeInForce::DAY, "alice");
+
+    ContinuousMatchingEngine::OrderRequest icebergRequest;
+    icebergRequest.action = OrderAction::SUBMIT;
+    icebergRequest.order = OrderFactory::createIcebergOrder("MSFT", OrderSide::SELL, 300.0, 100, 25);
+
+    ContinuousMatchingEngine::OrderRequest modifyRequest;
+    modifyRequest.action = OrderAction::MODIFY;
+    modifyRequest.symbol = "AAPL";
+    modifyRequest.orderId = "order-7";
+    modifyRequest.price = 149.5;
+    modifyRequest.quantity = 40;
+
+    JournalEntry checksummed = makeJournalEntry(modifyRequest);
+    checksummed.hasChecksum = true;
+    checksummed.bookChecksum = 0x0123456789abcdefULL;
+
+    std::string stream;
+    encodeJournalEntry(makeJournalEntry(stopRequest), stream);
+    encodeJournalEntry(makeJournalEntry(icebergRequest), stream);
+    encodeJournalEntry(checksummed, stream);
+
+    std::vector<JournalEntry> decoded;
+    size_t offset = 0;
+    while (offset < stream.size()) {
+        JournalRecordHeader header;
+        std::memcpy(&header, stream.data() + offset, sizeof(header));
+        JournalEntry entry;
+        ASSERT_TRUE(decodeJournalEntry(stream.data() + offset, header.length, entry));
+        decoded.push_back(entry);
+        offset += header.length;
+    }
+    ASSERT_EQ(decoded.size(), 3);
+
+    EXPECT_EQ(decoded[0].action, OrderAction::SUBMIT);
+    EXPECT_EQ(decoded[0].orderId, stopRequest.order->getId());
+    EXPECT_EQ(decoded[0].symbol, "AAPL");
+    EXPECT_EQ(decoded[0].ownerId, "alice");
+    EXPECT_EQ(decoded[0].type, OrderType::STOP_LIMIT);
+    EXPECT_EQ(decoded[0].timeInForce, TimeInForce::DAY);
+    EXPECT_DOUBLE_EQ(decoded[0].stopPrice, 151.0);
+    EXPECT_DOUBLE_EQ(decoded[0].price, 152.0);
+    EXPECT_EQ(decoded[0].quantity, 30);
+    EXPECT_FALSE(decoded[0].hasChecksum);
+
+    EXPECT_EQ(decoded[1].side, OrderSide::SELL);
+    EXPECT_EQ(decoded[1].quantity, 100);
+    EXPECT_EQ(decoded[1].displayQuantity, 25);
+
+    EXPECT_EQ(decoded[2].action, OrderAction::MODIFY);
+    EXPECT_EQ(decoded[2].orderId, "order-7");
+    EXPECT_DOUBLE_EQ(decoded[2].price, 149.5);
+    EXPECT_EQ(decoded[2].quantity, 40);
+    EXPECT_TRUE(decoded[2].hasChecksum);
+    EXPECT_EQ(decoded[2].bookChecksum, 0x0123456789abcdefULL);
+}
+
+// Test that a record cut short is rejected rather than misread
+TEST(CommandJournalTest, DecodeRejectsTruncatedRecord) {
+    JournalEntry entry;
+    entry.symbol = "AAPL";
+    entry.orderId = "order-1";
+    std::string stream;
+    encodeJournalEntry(entry, stream);
+
+    JournalEntry decoded;
+    EXPECT_FALSE(decodeJournalEntry(stream.data(), stream.size() - 1, decoded));
+    EXPECT_FALSE(decodeJournalEntry(stream.data(), sizeof(JournalRecordHeader) - 1, decoded));
+    EXPECT_TRUE(decodeJournalEntry(stream.data(), stream.size(), decoded));
+}
+
+// A primary engine on two shards replicating AAPL and MSFT to an in-process standby
+class ReplicationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        socketPath = "/tmp/replication_test_" + std::to_string(getpid()) + ".sock";
+        standby = std::make_unique<StandbyEngine>();
+        engine = std::make_unique<ContinuousMatchingEngine>(2);
+        for (const char* symbol : {"AAPL", "MSFT"}) {
+            standby->addSymbol(symbol);
+            engine->addSymbol(symbol);
+        }
+        ASSERT_TRUE(standby->start(socketPath));
+    }
+
+    void TearDown() override {
+        if (primary) {
+            primary->stop();
+        }
+        engine->stop();
+        standby->stop();
+    }
+
+    void startPrimary(const ReplicationConfig& config) {
+        // A cancel that catches its submit still queued drops both unjournaled
+        engine->registerOrderProcessingCallback([this](std::shared_ptr<OrderProcessingResult> result) {
+            if (result->getStatus() == OrderProcessingResult::Status::CANCELLED) {
+                coalescedPairs.fetch_add(1);
+            }
+        });
+        primary = std::make_unique<ReplicationPrimary>(*engine, config);
+        ASSERT_TRUE(primary->start(socketPath));
+        engine->start();
+    }
+
+    // Flow touching every command kind, with trades, an elected stop and an
+    // iceberg refill. Returns the number of commands submitted.
+    uint64_t submitMixedFlow() {
+        for (int i = 0; i < 20; ++i) {
+            engine->submitOrder(std::make_shared<Order>("A-BID-" + std::to_string(i), "AAPL", OrderSide::BUY,
+                                                        150.0 - i * 0.01, 10 + i, OrderType::LIMIT));
+            engine->submitOrder(std::make_shared<Order>("A-ASK-" + std::to_string(i), "AAPL", OrderSide::SELL,
+                                                        150.5 + i * 0.01, 10 + i, OrderType::LIMIT));
+        }
+        engine->submitOrder(OrderFactory::createIcebergOrder("MSFT", OrderSide::SELL, 300.0, 100, 20));
+        engine->submitOrder(OrderFactory::createStopOrder("AAPL", OrderSide::BUY, 150.5, 15));
+        engine->submitOrder(std::make_shared<Order>("A-TAKE", "AAPL", OrderSide::BUY, 150.5, 5, OrderType::LIMIT));
+        engine->submitOrder(std::make_shared<Order>("M-TAKE", "MSFT", OrderSide::BUY, 300.0, 45, OrderType::LIMIT));
+        engine->modifyOrder("A-BID-3", "AAPL", 150.1, 12);
+        engine->cancelOrder("A-ASK-10", "AAPL");
+        engine->submitOrder(std::make_shared<Order>("M-OWNED", "MSFT", OrderSide::BUY, 299.0, 10,
+                                                    OrderType::LIMIT, TimeInForce::GTC, "bob"));
+        engine->massCancel("bob", "MSFT");
+        return 48;
+    }
+
+    // Let the primary apply `commands`, then end the stream so the standby's
+    // books are final (stopping the engine drops whatever is still queued)
+    void finishPrimary(uint64_t commands) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (primary->getJournaledCount() + 2 * coalescedPairs.load() < commands &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        engine->stop();
+        EXPECT_TRUE(primary->waitForAcks(std::chrono::seconds(5)));
+        primary->stop();
+        ASSERT_TRUE(standby->waitForPrimaryLoss(std::chrono::seconds(5)));
+    }
+
+    std::string socketPath;
+    std::unique_ptr<StandbyEngine> standby;
+    std::unique_ptr<ContinuousMatchingEngine> engine;
+    std::unique_ptr<ReplicationPrimary> primary;
+    std::atomic<uint64_t> coalescedPairs{0};
+};
+
+// Test that the standby rebuilds the primary's books command for command
+TEST_F(ReplicationTest, StandbyMirrorsPrimaryBooks) {
+    ReplicationConfig config;
+    config.checksumInterval = 4;
+    startPrimary(config);
+    finishPrimary(submitMixedFlow());
+
+    EXPECT_EQ(standby->getAppliedCount(), primary->getJournaledCount());
+    EXPECT_EQ(primary->getShippedCount(), primary->getJournaledCount());
+    EXPECT_GT(standby->getChecksumsVerified(), 0);
+    EXPECT_EQ(standby->getChecksumMismatches(), 0);
+    for (const char* symbol : {"AAPL", "MSFT"}) {
+        EXPECT_EQ(bookChecksum(*standby->getOrderBook(symbol)), bookChecksum(*engine->getOrderBook(symbol))) << symbol;
+    }
+    EXPECT_NE(standby->getOrderBook("AAPL")->getOrderById("A-BID-3"), nullptr);
+    EXPECT_EQ(standby->getOrderBook("AAPL")->getOrderById("A-ASK-10"), nullptr);
+    EXPECT_EQ(standby->getOrderBook("MSFT")->getOrderById("M-OWNED"), nullptr);
+}
+
+// Test that the standby only hands over its books once the primary is gone
+TEST_F(ReplicationTest, PromotedStandbyKeepsTrading) {
+    startPrimary(ReplicationConfig());
+    EXPECT_EQ(standby->promote(1), nullptr);
+
+    finishPrimary(submitMixedFlow());
+
+    auto promoted = standby->promote(1);
+    ASSERT_NE(promoted, nullptr);
+    EXPECT_TRUE(promoted->hasSymbol("AAPL"));
+
+    std::promise<std::shared_ptr<Trade>> tradePromise;
+    std::atomic<bool> traded{false};
+    promoted->registerTradeCallback([&](std::shared_ptr<Trade> trade) {
+        if (!traded.exchange(true)) {
+            tradePromise.set_value(trade);
+        }
+    });
+    promoted->start();
+
+    // A-BID-3 was modified up to the best bid on the primary before the failover
+    promoted->submitOrder(std::make_shared<Order>("NEW-SELL", "AAPL", OrderSide::SELL, 150.0, 5, OrderType::LIMIT));
+    auto future = tradePromise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future.get()->getBuyOrderId(), "A-BID-3");
+    promoted->stop();
+}
+
+// Test that BOUNDED keeps a shard from running more than maxUnacked commands ahead
+TEST_F(ReplicationTest, BoundedPolicyLimitsLag) {
+    engine = std::make_unique<ContinuousMatchingEngine>(1);
+    engine->addSymbol("AAPL");
+
+    ReplicationConfig config;
+    config.ackPolicy = AckPolicy::BOUNDED;
+    config.maxUnacked = 4;
+
+    std::atomic<uint64_t> maxLag{0};
+    std::atomic<int> results{0};
+    engine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult>) {
+        uint64_t lag = primary->getJournaledCount() - primary->getAckedCount();
+        uint64_t seen = maxLag.load();
+        while (lag > seen && !maxLag.compare_exchange_weak(seen, lag)) {
+        }
+        results.fetch_add(1);
+    });
+    startPrimary(config);
+
+    for (int i = 0; i < 200; ++i) {
+        engine->submitOrder(std::make_shared<Order>("B-" + std::to_string(i), "AAPL", OrderSide::BUY,
+                                                    100.0 - (i % 50) * 0.01, 10, OrderType::LIMIT));
+    }
+    finishPrimary(200);
+
+    EXPECT_EQ(results.load(), 200);
+    EXPECT_LE(maxLag.load(), config.maxUnacked);
+    EXPECT_EQ(standby->getAppliedCount(), 200);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../ipc/SharedMemoryClient.hpp"
+#include "../ipc/SharedMemoryServer.hpp"
+
+namespace {
+
+bool waitForReport(SharedMemoryClient& client, ExecutionReportMessage& report) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (client.pollReport(report)) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+NewOrderMessage makeNewOrder(uint64_t clientOrderId, WireSide side, double price, int quantity) {
+    auto message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    message.clientOrderId = clientOrderId;
+    encodeSymbol("AAPL", message.symbol);
+    message.side = side;
+    message.price = price;
+    message.quantity = quantity;
+    return message;
+}
+
+} // namespace
+
+// Test the ring on ordinary process memory
+TEST(SpscRingTest, PushPopAndFull) {
+    std::vector<char> memory(SpscRing::bytesRequired(4) + CACHE_LINE_SIZE);
+    void* aligned = reinterpret_cast<void*>(
+        (reinterpret_cast<uintptr_t>(memory.data()) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1));
+
+    SpscRing ring(aligned, 4);
+    ring.reset(4);
+
+    EXPECT_EQ(ring.front(), nullptr);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.tryPush(&i, sizeof(i)));
+    }
+    int overflow = 4;
+    EXPECT_FALSE(ring.tryPush(&overflow, sizeof(overflow)));
+
+    for (int i = 0; i < 4; ++i) {
+        const char* slot = ring.front();
+        ASSERT_NE(slot, nullptr);
+        int value;
+        std::memcpy(&value, slot, sizeof(value));
+        EXPECT_EQ(value, i);
+        ring.pop();
+    }
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+class SharedMemoryTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        regionName = "/matching_engine_test_" + std::to_string(getpid());
+
+        engine = std::make_unique<ContinuousMatchingEngine>(2);
+        engine->addSymbol("AAPL");
+        engine->start();
+
+        server = std::make_unique<SharedMemoryServer>(*engine, regionName, 8, 64);
+        ASSERT_TRUE(server->start());
+    }
+
+    void TearDown() override {
+        server->stop();
+        engine->stop();
+    }
+
+    std::string regionName;
+    std::unique_ptr<ContinuousMatchingEngine> engine;
+    std::unique_ptr<SharedMemoryServer> server;
+};
+
+// Test the session handshake and disconnect
+TEST_F(SharedMemoryTransportTest, ConnectAndDisconnect) {
+    SharedMemoryClient client;
+    ASSERT_TRUE(client.connect(regionName));
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_NE(client.getSessionId() & SharedMemoryServer::SESSION_ID_BIT, 0u);
+    EXPECT_EQ(server->getSessionCount(), 1u);
+
+    client.disconnect();
+    for (int i = 0; i < 100 && server->getSessionCount() != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(server->getSessionCount(), 0u);
+
+    // Connecting to a region that does not exist fails cleanly
+    SharedMemoryClient missing;
+    EXPECT_FALSE(missing.connect("/matching_engine_no_such_region"));
+}
+
+// Test order entry, fills and cancels between two in-process clients
+TEST_F(SharedMemoryTransportTest, OrdersAndReports) {
+    SharedMemoryClient seller;
+    SharedMemoryClient buyer;
+    ASSERT_TRUE(seller.connect(regionName));
+    ASSERT_TRUE(buyer.connect(regionName));
+
+    ExecutionReportMessage report;
+
+    ASSERT_TRUE(seller.sendNewOrder(makeNewOrder(1, WireSide::SELL, 150.0, 100)));
+    ASSERT_TRUE(waitForReport(seller, report));
+    EXPECT_EQ(report.reportType, ExecutionReportType::NEW);
+
+    ASSERT_TRUE(buyer.sendNewOrder(makeNewOrder(1, WireSide::BUY, 150.0, 30)));
+    ASSERT_TRUE(waitForReport(buyer, report));
+    EXPECT_EQ(report.reportType, ExecutionReportType::NEW);
+    ASSERT_TRUE(waitForReport(buyer, report));
+    EXPECT_EQ(report.reportType, ExecutionReportType::FILL);
+    EXPECT_EQ(report.lastQuantity, 30);
+
+    ASSERT_TRUE(waitForReport(seller, report));
+    EXPECT_EQ(report.reportType, ExecutionReportType::PARTIAL_FILL);
+    EXPECT_EQ(report.leavesQuantity, 70);
+
+    auto cancel = makeMessage<CancelOrderMessage>(MessageType::CANCEL_ORDER);
+    cancel.clientOrderId = 1;
+    encodeSymbol("AAPL", cancel.symbol);
+    ASSERT_TRUE(seller.sendCancel(cancel));
+    ASSERT_TRUE(waitForReport(seller, report));
+    EXPECT_EQ(report.reportType, ExecutionReportType::CANCELLED);
+
+    EXPECT_EQ(engine->getOrderBook("AAPL")->getAllSellOrders().size(), 0u);
+}
+
+// Test order entry from a separate process
+TEST_F(SharedMemoryTransportTest, CrossProcessClient) {
+    pid_t child = fork();
+    if (child == 0) {
+        SharedMemoryClient client;
+        if (!client.connect(regionName)) {
+            _exit(2);
+        }
+        if (!client.sendNewOrder(makeNewOrder(42, WireSide::BUY, 99.0, 5))) {
+            _exit(3);
+        }
+        ExecutionReportMessage report;
+        if (!waitForReport(client, report) || report.clientOrderId != 42 ||
+            report.reportType != ExecutionReportType::NEW) {
+            _exit(4);
+        }
+        client.disconnect();
+        _exit(0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    // The child's order rested, then went with it when it disconnected
+    auto orderBook = engine->getOrderBook("AAPL");
+    for (int i = 0; i < 100 && !orderBook->getAllBuyOrders().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(orderBook->getAllBuyOrders().size(), 0u);
+}
@@ -1,5 +1,7 @@
 #include "../engine/ContinuousMatchingEngine.hpp"
 #include "../order/Order.hpp"
+#include "../workload/OrderFlowReplayer.hpp"
+#include "../threading/CpuTopology.hpp"
 #include <gtest/gtest.h>
 #include <thread>
 #include <vector>
@@ -7,6 +9,8 @@
 #include <chrono>
 #include <random>
 #include <unordered_set>
+#include <future>
+#include <sched.h>
 
 class ThreadingTests : public ::testing::Test {
 protected:
@@ -286,6 +290,60 @@ TEST_F(ThreadingTests, StressTest) {
     EXPECT_GT(completedOperations.load(), NUM_OPERATIONS / 2);
 }
 
+// Test replaying generated order flow from several producers concurrently
+TEST_F(ThreadingTests, GeneratedOrderFlowReplay) {
+    const size_t NUM_SYMBOLS = 8;
+    const size_t EVENTS_PER_PRODUCER = 5000;
+    for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+        engine->addSymbol(OrderFlowGenerator::symbolName(i));
+    }
+
+    std::atomic<size_t> processed(0);
+    std::atomic<size_t> successfulCancels(0);
+    engine->registerOrderProcessingCallback([&](std::shared_ptr<OrderProcessingResult> result) {
+        if (result->getAction() == OrderProcessingResult::Action::CANCEL &&
+            result->getStatus() == OrderProcessingResult::Status::SUCCESS) {
+            successfulCancels++;
+        }
+        processed++;
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&, p]() {
+            OrderFlowConfig config;
+            config.seed = 100 + p;
+            config.orderIdPrefix = "G" + std::to_string(p) + "-";
+            config.symbolCount = NUM_SYMBOLS;
+            auto events = OrderFlowGenerator(config).generate(EVENTS_PER_PRODUCER);
+            OrderFlowReplayer(*engine, config.orderIdPrefix).replay(events, 0.0);
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    while (processed.load() < 2 * EVENTS_PER_PRODUCER &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    engine->stop();
+
+    EXPECT_EQ(processed.load(), 2 * EVENTS_PER_PRODUCER);
+    EXPECT_GT(successfulCancels.load(), 0u);
+
+    // Every book is left uncrossed
+    for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+        auto book = engine->getOrderBook(OrderFlowGenerator::symbolName(i));
+        double bid = book->getBestBidPrice();
+        double ask = book->getBestAskPrice();
+        if (bid > 0.0 && ask > 0.0) {
+            EXPECT_LT(bid, ask) << OrderFlowGenerator::symbolName(i);
+        }
+    }
+}
+
 // Test shutdown behavior with pending orders
 TEST_F(ThreadingTests, ShutdownWithPendingOrders) {
     std::atomic<int> processedOrders(0);
@@ -320,3 +378,84 @@ int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+TEST(SymbolThreadPoolTest, PinnedWorkersRunOnTheirPlannedCpu) {
+    auto nodes = readNumaTopology();
+    ASSERT_FALSE(nodes.empty());
+
+    SymbolThreadPool pool(3);
+    pool.setPinWorkers(true);
+    std::vector<std::atomic<int>> runningOn(3);
+    pool.setWorkerStartHook([&](size_t threadIndex) {
+        runningOn[threadIndex].store(sched_getcpu());
+    });
+    pool.start();
+
+    std::vector<std::promise<void>> done(3);
+    for (size_t i = 0; i < 3; ++i) {
+        pool.submitShardTask(i, [&done, i] { done[i].set_value(); });
+    }
+    for (auto& promise : done) {
+        promise.get_future().wait();
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        WorkerStats stats = pool.getWorkerStats(i);
+        WorkerPlacement planned = placeWorker(nodes, i);
+        EXPECT_EQ(planned.cpu, stats.cpu);
+        EXPECT_EQ(planned.numaNode, stats.numaNode);
+        EXPECT_EQ(planned.cpu, runningOn[i].load());
+    }
+    pool.stop();
+}
+
+TEST(SymbolThreadPoolTest, UnpinnedWorkersReportNoPlacement) {
+    SymbolThreadPool pool(1);
+    pool.start();
+    WorkerStats stats = pool.getWorkerStats(0);
+    pool.stop();
+
+    EXPECT_EQ(-1, stats.cpu);
+    EXPECT_EQ(-1, stats.numaNode);
+}
+
+TEST(SymbolThreadPoolTest, BoundedQueueAdmission) {
+    SymbolThreadPool pool(1);
+    pool.setQueueCapacity(2);
+    pool.start();
+
+    // Hold the worker so queued tasks stay queued
+    std::promise<void> gate;
+    std::shared_future<void> gateOpen = gate.get_future().share();
+    std::promise<void> holding;
+    std::atomic<int> ran{0};
+    pool.submitShardTask(0, [&] {
+        holding.set_value();
+        gateOpen.wait();
+    });
+    holding.get_future().wait();
+
+    EXPECT_TRUE(pool.submitShardTask(0, [&] { ran++; }));
+    EXPECT_TRUE(pool.submitShardTask(0, [&] { ran++; }));
+    EXPECT_EQ(2, pool.getQueueDepth(0));
+    EXPECT_FALSE(pool.submitShardTask(0, [&] { ran++; }, QueueAdmission::REFUSE));
+    EXPECT_TRUE(pool.submitShardTask(0, [&] { ran++; }, QueueAdmission::ALWAYS));
+    EXPECT_EQ(3, pool.getWorkerStats(0).queueDepth);
+
+    std::atomic<bool> waitedSubmitReturned{false};
+    std::thread producer([&] {
+        EXPECT_TRUE(pool.submitShardTask(0, [&] { ran++; }));
+        waitedSubmitReturned.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(waitedSubmitReturned.load());
+
+    gate.set_value();
+    producer.join();
+    for (int i = 0; i < 100 && ran.load() < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(4, ran.load());
+    EXPECT_EQ(0, pool.getQueueDepth(0));
+    pool.stop();
+}
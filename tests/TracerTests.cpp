@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "../metrics/Tracer.hpp"
+#include "../metrics/TscClock.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include "../order/OrderFactory.hpp"
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string dumpTrace(double lastSeconds = 60.0) {
+    std::ostringstream out;
+    Tracer::dumpChromeTrace(out, lastSeconds);
+    return out.str();
+}
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+// The registry is process-wide, so each test starts from an empty trace
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::reset();
+    }
+};
+
+// Test a recorded span shows up with its thread name, type and symbol
+TEST_F(TracerTest, RecordsSpanWithThreadName) {
+    uint32_t symbolId = Tracer::internSymbol("TRACE_BASIC");
+    EXPECT_EQ(Tracer::internSymbol("TRACE_BASIC"), symbolId);
+
+    std::thread writer([symbolId]() {
+        Tracer::setThreadName("trace-basic-writer");
+        uint64_t begin = TscClock::now();
+        Tracer::record(TraceEventType::MATCH, symbolId, begin, TscClock::now());
+    });
+    writer.join();
+
+    std::string trace = dumpTrace();
+    EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\": {\"name\": \"trace-basic-writer\"}"), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"MATCH\""), std::string::npos);
+    EXPECT_EQ(countOccurrences(trace, "\"symbol\": \"TRACE_BASIC\""), 1u);
+}
+
+// Test a full ring keeps only the most recent events. The dump skips the
+// oldest slot of a wrapped ring since the writer may be reusing it.
+TEST_F(TracerTest, RingOverwritesOldestEvents) {
+    uint32_t oldId = Tracer::internSymbol("TRACE_WRAP_OLD");
+    uint32_t newId = Tracer::internSymbol("TRACE_WRAP_NEW");
+
+    Tracer::setRingCapacity(8);
+    std::thread writer([oldId, newId]() {
+        uint64_t now = TscClock::now();
+        for (int i = 0; i < 8; ++i) {
+            Tracer::record(TraceEventType::TASK, oldId, now, now);
+        }
+        for (int i = 0; i < 5; ++i) {
+            Tracer::record(TraceEventType::TASK, newId, now, now);
+        }
+    });
+    writer.join();
+    Tracer::setRingCapacity(16384);
+
+    std::string trace = dumpTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"symbol\": \"TRACE_WRAP_OLD\""), 2u);
+    EXPECT_EQ(countOccurrences(trace, "\"symbol\": \"TRACE_WRAP_NEW\""), 5u);
+}
+
+// Test only the most recent exited threads stay in the dump, and a reused
+// ring shows none of its previous owner's events
+TEST_F(TracerTest, ExitedRingsAreRecycled) {
+    Tracer::setRetainedExitedRings(2);
+    for (int i = 0; i < 5; ++i) {
+        uint32_t symbolId = Tracer::internSymbol("TRACE_EXIT_" + std::to_string(i));
+        std::thread writer([symbolId]() {
+            uint64_t now = TscClock::now();
+            Tracer::record(TraceEventType::TASK, symbolId, now, now);
+        });
+        writer.join();
+    }
+    Tracer::setRetainedExitedRings(8);
+
+    std::string trace = dumpTrace();
+    for (int i = 0; i < 5; ++i) {
+        std::string tag = "\"symbol\": \"TRACE_EXIT_" + std::to_string(i) + "\"";
+        EXPECT_EQ(countOccurrences(trace, tag), i >= 3 ? 1u : 0u) << i;
+    }
+}
+
+// Test spans that ended before the requested window are left out
+TEST_F(TracerTest, DumpHonoursWindow) {
+    uint32_t symbolId = Tracer::internSymbol("TRACE_WINDOW");
+    uint64_t oneSecondTicks = static_cast<uint64_t>(1e9 / TscClock::nanosPerTick());
+
+    std::thread writer([symbolId, oneSecondTicks]() {
+        uint64_t now = TscClock::now();
+        Tracer::record(TraceEventType::PUBLISH, symbolId, now - 3 * oneSecondTicks, now - 2 * oneSecondTicks);
+        Tracer::record(TraceEventType::PUBLISH, symbolId, now, now);
+    });
+    writer.join();
+
+    EXPECT_EQ(countOccurrences(dumpTrace(1.0), "\"symbol\": \"TRACE_WINDOW\""), 1u);
+    EXPECT_EQ(countOccurrences(dumpTrace(60.0), "\"symbol\": \"TRACE_WINDOW\""), 2u);
+}
+
+// Test thread names and symbols are escaped so the dump stays valid JSON
+TEST_F(TracerTest, EscapesStrings) {
+    uint32_t symbolId = Tracer::internSymbol(std::string("T\"R\\A\n\x01\xff", 8));
+
+    std::thread writer([symbolId]() {
+        Tracer::setThreadName("trace \"escape\"");
+        uint64_t now = TscClock::now();
+        Tracer::record(TraceEventType::MATCH, symbolId, now, now);
+    });
+    writer.join();
+
+    std::string trace = dumpTrace();
+    EXPECT_NE(trace.find("\"args\": {\"name\": \"trace \\\"escape\\\"\"}"), std::string::npos);
+    EXPECT_NE(trace.find("\"symbol\": \"T\\\"R\\\\A\\u000a\\u0001\\u00ff\""), std::string::npos);
+    EXPECT_EQ(trace.find('\x01'), std::string::npos);
+}
+
+// Test the engine traces every command on its shard's track
+TEST_F(TracerTest, EngineRecordsShardSpans) {
+    ContinuousMatchingEngine engine(2);
+    engine.addSymbol("TRACEENG");
+    engine.start();
+
+    auto sell = OrderFactory::createLimitOrder("TRACEENG", OrderSide::SELL, 100.0, 10);
+    engine.submitOrder(sell);
+    engine.submitOrder(OrderFactory::createLimitOrder("TRACEENG", OrderSide::BUY, 100.0, 10));
+    engine.cancelOrder("missing", "TRACEENG");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    engine.stop();
+
+    std::string trace = dumpTrace();
+    int shard = engine.getThreadForSymbol("TRACEENG");
+    EXPECT_NE(trace.find("\"args\": {\"name\": \"shard-" + std::to_string(shard) + "\"}"), std::string::npos);
+
+    // Four spans per command: queue wait, task, match and publish
+    EXPECT_EQ(countOccurrences(trace, "\"symbol\": \"TRACEENG\""), 12u);
+}
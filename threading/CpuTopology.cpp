@@ -0,0 +1,103 @@
+#include "CpuTopology.hpp"
+#include <sched.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+const char* NODE_DIRECTORY = "/sys/devices/system/node";
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &mask)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Parse a kernel cpulist such as "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        auto dash = range.find('-');
+        int first = std::atoi(range.c_str());
+        int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+} // namespace
+
+std::vector<NumaNode> readNumaTopology() {
+    std::vector<int> allowed = allowedCpus();
+    std::vector<NumaNode> nodes;
+
+    if (DIR* directory = opendir(NODE_DIRECTORY)) {
+        while (dirent* entry = readdir(directory)) {
+            if (std::strncmp(entry->d_name, "node", 4) != 0 || !std::isdigit(static_cast<unsigned char>(entry->d_name[4]))) {
+                continue;
+            }
+            std::ifstream cpulist(std::string(NODE_DIRECTORY) + "/" + entry->d_name + "/cpulist");
+            std::string list;
+            std::getline(cpulist, list);
+
+            NumaNode node{std::atoi(entry->d_name + 4), {}};
+            for (int cpu : parseCpuList(list)) {
+                if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+            // Memory-only nodes and nodes outside our affinity mask get no workers
+            if (!node.cpus.empty()) {
+                nodes.push_back(std::move(node));
+            }
+        }
+        closedir(directory);
+    }
+
+    if (nodes.empty() && !allowed.empty()) {
+        nodes.push_back({0, allowed});
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) {
+        return a.id < b.id;
+    });
+    return nodes;
+}
+
+WorkerPlacement placeWorker(const std::vector<NumaNode>& nodes, size_t workerIndex) {
+    if (nodes.empty()) {
+        return {-1, -1};
+    }
+    const auto& node = nodes[workerIndex % nodes.size()];
+    size_t slot = (workerIndex / nodes.size()) % node.cpus.size();
+    return {node.cpus[slot], node.id};
+}
+
+bool pinCurrentThread(int cpu) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
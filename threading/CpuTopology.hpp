@@ -0,0 +1,29 @@
+#ifndef MATCHING_ENGINE_CPUTOPOLOGY_HPP
+#define MATCHING_ENGINE_CPUTOPOLOGY_HPP
+
+#include <cstddef>
+#include <vector>
+
+// CPUs this process may run on, grouped by NUMA node
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+// Where one pool worker runs
+struct WorkerPlacement {
+    int cpu;
+    int numaNode;
+};
+
+// Nodes listed under /sys/devices/system/node, limited to the process
+// affinity mask. Without that tree every allowed CPU is reported as node 0.
+std::vector<NumaNode> readNumaTopology();
+
+// Spread workers round-robin across nodes, then across each node's CPUs
+WorkerPlacement placeWorker(const std::vector<NumaNode>& nodes, size_t workerIndex);
+
+// Restrict the calling thread to `cpu`. Returns false if the kernel refuses.
+bool pinCurrentThread(int cpu);
+
+#endif // MATCHING_ENGINE_CPUTOPOLOGY_HPP
@@ -1,6 +1,24 @@
 #include "SymbolThreadPool.hpp"
+#include "CpuTopology.hpp"
 #include <iostream>
 #include <functional>
+#include <chrono>
+
+namespace {
+
+thread_local int currentThreadIndex = -1;
+thread_local bool currentTaskSuperseded = false;
+
+// Counters have a single writer, so a plain load/store avoids a locked RMW
+void addTo(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+uint64_t nanosBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+} // namespace
 
 SymbolThreadPool::SymbolThreadPool(size_t numThreads)
     : numThreads(numThreads), running(false) {
@@ -19,12 +37,67 @@ bool SymbolThreadPool::isRunning() const {
     return running.load();
 }
 
+size_t SymbolThreadPool::getNumThreads() const {
+    return numThreads;
+}
+
+int SymbolThreadPool::getCurrentThreadIndex() {
+    return currentThreadIndex;
+}
+
+bool SymbolThreadPool::isCurrentTaskSuperseded() {
+    return currentTaskSuperseded;
+}
+
+WorkerStats SymbolThreadPool::getWorkerStats(size_t threadIndex) const {
+    const auto& counters = threadData[threadIndex]->counters;
+    return {
+        threadIndex,
+        counters.tasksProcessed.load(std::memory_order_relaxed),
+        counters.busyNanos.load(std::memory_order_relaxed),
+        counters.idleNanos.load(std::memory_order_relaxed),
+        counters.queueDepthHighWater.load(std::memory_order_relaxed),
+        threadData[threadIndex]->depth.load(std::memory_order_relaxed),
+        threadData[threadIndex]->cpu.load(std::memory_order_relaxed),
+        threadData[threadIndex]->numaNode.load(std::memory_order_relaxed)
+    };
+}
+
+void SymbolThreadPool::setWorkerStartHook(std::function<void(size_t)> hook) {
+    workerStartHook = std::move(hook);
+}
+
+void SymbolThreadPool::setPinWorkers(bool pin) {
+    pinWorkers = pin;
+}
+
+void SymbolThreadPool::setQueueCapacity(size_t capacity) {
+    queueCapacity = capacity;
+}
+
+size_t SymbolThreadPool::getQueueCapacity() const {
+    return queueCapacity;
+}
+
+size_t SymbolThreadPool::getQueueDepth(size_t threadIndex) const {
+    return threadData[threadIndex]->depth.load(std::memory_order_relaxed);
+}
+
 void SymbolThreadPool::start() {
     if (isRunning()) {
         return;
     }
     
     running.store(true);
+
+    if (pinWorkers) {
+        auto nodes = readNumaTopology();
+        for (size_t i = 0; i < numThreads; ++i) {
+            WorkerPlacement placement = placeWorker(nodes, i);
+            threadData[i]->cpu.store(placement.cpu, std::memory_order_relaxed);
+            threadData[i]->numaNode.store(placement.numaNode, std::memory_order_relaxed);
+        }
+    }
     
     threads.reserve(numThreads);
     for (size_t i = 0; i < numThreads; ++i) {
@@ -41,9 +114,12 @@ void SymbolThreadPool::stop() {
     
     running.store(false);
     
-    // Notify all threads to wake up and check running status
+    // Notify all threads to wake up and check running status, and release
+    // producers waiting for room
     for (size_t i = 0; i < numThreads; ++i) {
+        std::lock_guard<std::mutex> lock(threadData[i]->queueMutex);
         threadData[i]->condition.notify_one();
+        threadData[i]->notFull.notify_all();
     }
     
     // Join all threads
@@ -57,16 +133,73 @@ void SymbolThreadPool::stop() {
     std::cout << "Symbol Thread Pool stopped" << std::endl;
 }
 
-void SymbolThreadPool::submitTask(const std::string& symbol, std::function<void()> task) {
+bool SymbolThreadPool::submitTask(const std::string& symbol, std::function<void()> task, QueueAdmission admission,
+                                  TaskLane lane, uint64_t orderKey, const void* tag) {
     // First, ensure the symbol is assigned to a thread
-    size_t threadIndex = assignSymbolToThread(symbol);
-    
+    return submitShardTask(assignSymbolToThread(symbol), std::move(task), admission, lane, orderKey, tag);
+}
+
+bool SymbolThreadPool::submitShardTask(size_t threadIndex, std::function<void()> task, QueueAdmission admission,
+                                       TaskLane lane, uint64_t orderKey, const void* tag) {
+    auto& data = threadData[threadIndex];
+    // Waiting on our own queue would never end
+    if (admission == QueueAdmission::WAIT && currentThreadIndex == static_cast<int>(threadIndex)) {
+        admission = QueueAdmission::ALWAYS;
+    }
+
     {
-        std::lock_guard<std::mutex> lock(threadData[threadIndex]->queueMutex);
-        threadData[threadIndex]->taskQueue.push(std::move(task));
+        std::unique_lock<std::mutex> lock(data->queueMutex);
+        if (queueCapacity > 0 && admission != QueueAdmission::ALWAYS && data->size() >= queueCapacity) {
+            if (admission == QueueAdmission::REFUSE) {
+                return false;
+            }
+            data->notFull.wait(lock, [this, &data] {
+                return data->size() < queueCapacity || !isRunning();
+            });
+            if (!isRunning()) {
+                return false;
+            }
+        }
+
+        if (lane == TaskLane::PRIORITY &&
+            (data->pendingBarriers > 0 || (orderKey != 0 && data->pendingKeys.count(orderKey) > 0))) {
+            lane = TaskLane::NORMAL;
+        }
+        if (lane == TaskLane::PRIORITY) {
+            data->priorityQueue.push({std::move(task), orderKey, nullptr, false, false});
+        } else {
+            bool barrier = lane == TaskLane::BARRIER;
+            data->taskQueue.push({std::move(task), orderKey, orderKey != 0 ? tag : nullptr, false, barrier});
+            if (barrier) {
+                ++data->pendingBarriers;
+            }
+            if (orderKey != 0) {
+                PendingKey& pending = data->pendingKeys[orderKey];
+                ++pending.count;
+                pending.newest = &data->taskQueue.back();
+            }
+        }
+        data->depth.store(data->size(), std::memory_order_relaxed);
     }
     
-    threadData[threadIndex]->condition.notify_one();
+    data->condition.notify_one();
+    return true;
+}
+
+bool SymbolThreadPool::supersedeQueuedTask(size_t threadIndex, uint64_t orderKey,
+                                           const std::function<bool(const void*)>& matches) {
+    auto& data = threadData[threadIndex];
+    std::lock_guard<std::mutex> lock(data->queueMutex);
+    auto pending = data->pendingKeys.find(orderKey);
+    if (pending == data->pendingKeys.end()) {
+        return false;
+    }
+    QueuedTask* newest = pending->second.newest;
+    if (!newest->tag || newest->superseded || !matches(newest->tag)) {
+        return false;
+    }
+    newest->superseded = true;
+    return true;
 }
 
 int SymbolThreadPool::getThreadForSymbol(const std::string& symbol) const {
@@ -82,30 +215,72 @@ int SymbolThreadPool::getThreadForSymbol(const std::string& symbol) const {
 
 void SymbolThreadPool::workerThread(size_t threadIndex) {
     auto& data = threadData[threadIndex];
+    auto& counters = data->counters;
+    currentThreadIndex = static_cast<int>(threadIndex);
+    // Pin before the worker allocates anything so its heap pages are local
+    int cpu = data->cpu.load(std::memory_order_relaxed);
+    if (cpu >= 0 && !pinCurrentThread(cpu)) {
+        std::cerr << "Could not pin thread " << threadIndex << " to CPU " << cpu << std::endl;
+        data->cpu.store(-1, std::memory_order_relaxed);
+        data->numaNode.store(-1, std::memory_order_relaxed);
+    }
+    if (workerStartHook) {
+        workerStartHook(threadIndex);
+    }
+    auto waitStart = std::chrono::steady_clock::now();
     
     while (isRunning()) {
         std::function<void()> task;
         bool hasTask = false;
+        bool superseded = false;
         
         {
             std::unique_lock<std::mutex> lock(data->queueMutex);
             
             data->condition.wait(lock, [this, &data] {
-                return !data->taskQueue.empty() || !isRunning();
+                return data->size() > 0 || !isRunning();
             });
             
-            if (!isRunning() && data->taskQueue.empty()) {
+            if (!isRunning() && data->size() == 0) {
                 break;
             }
             
-            if (!data->taskQueue.empty()) {
-                task = std::move(data->taskQueue.front());
-                data->taskQueue.pop();
+            uint64_t depth = data->size();
+            if (depth > 0) {
+                if (depth > counters.queueDepthHighWater.load(std::memory_order_relaxed)) {
+                    counters.queueDepthHighWater.store(depth, std::memory_order_relaxed);
+                }
+                if (!data->priorityQueue.empty()) {
+                    task = std::move(data->priorityQueue.front().task);
+                    data->priorityQueue.pop();
+                } else {
+                    uint64_t orderKey = data->taskQueue.front().orderKey;
+                    superseded = data->taskQueue.front().superseded;
+                    if (data->taskQueue.front().barrier) {
+                        --data->pendingBarriers;
+                    }
+                    task = std::move(data->taskQueue.front().task);
+                    data->taskQueue.pop();
+                    if (orderKey != 0) {
+                        auto pending = data->pendingKeys.find(orderKey);
+                        if (--pending->second.count == 0) {
+                            data->pendingKeys.erase(pending);
+                        }
+                    }
+                }
+                data->depth.store(depth - 1, std::memory_order_relaxed);
                 hasTask = true;
             }
         }
+
+        if (hasTask && queueCapacity > 0) {
+            data->notFull.notify_one();
+        }
         
         if (hasTask) {
+            auto taskStart = std::chrono::steady_clock::now();
+            addTo(counters.idleNanos, nanosBetween(waitStart, taskStart));
+            currentTaskSuperseded = superseded;
             try {
                 task();
             } catch (const std::exception& e) {
@@ -113,6 +288,10 @@ void SymbolThreadPool::workerThread(size_t threadIndex) {
             } catch (...) {
                 std::cerr << "Unknown exception in thread " << threadIndex << std::endl;
             }
+            currentTaskSuperseded = false;
+            waitStart = std::chrono::steady_clock::now();
+            addTo(counters.busyNanos, nanosBetween(taskStart, waitStart));
+            addTo(counters.tasksProcessed, 1);
         }
     }
 }
@@ -12,6 +12,32 @@
 #include <string>
 #include <memory>
 
+struct WorkerStats {
+    size_t threadIndex;
+    uint64_t tasksProcessed;
+    uint64_t busyNanos;            // running tasks
+    uint64_t idleNanos;            // waiting for work
+    uint64_t queueDepthHighWater;  // deepest queue seen at dequeue
+    uint64_t queueDepth;           // tasks waiting now
+    int cpu;                       // pinned CPU, -1 when not pinned
+    int numaNode;                  // node of the pinned CPU, -1 when not pinned
+};
+
+// What submitting to a full queue does
+enum class QueueAdmission {
+    WAIT,    // block until the worker makes room (or the pool stops)
+    REFUSE,  // return false without queueing
+    ALWAYS   // queue past the capacity
+};
+
+// Each worker drains its PRIORITY lane before its NORMAL lane. A BARRIER
+// task queues in the NORMAL lane and nothing submitted after it overtakes it.
+enum class TaskLane {
+    NORMAL,
+    PRIORITY,
+    BARRIER
+};
+
 class SymbolThreadPool {
 public:
     SymbolThreadPool(size_t numThreads);
@@ -20,8 +46,45 @@ public:
     void start();
     void stop();
     
-    // Submit a task for a specific symbol
-    void submitTask(const std::string& symbol, std::function<void()> task);
+    // Submit a task for a specific symbol. Returns false if the task was
+    // not queued: refused by a full queue, or the pool stopped while waiting.
+    //
+    // A PRIORITY task overtakes queued NORMAL tasks, except that tasks with
+    // the same non-zero orderKey never overtake one another: while a NORMAL
+    // task with its key, or any BARRIER task, is queued on the worker, a
+    // PRIORITY task joins the NORMAL lane.
+    // A keyed NORMAL task may carry a tag for supersedeQueuedTask().
+    bool submitTask(const std::string& symbol, std::function<void()> task,
+                    QueueAdmission admission = QueueAdmission::WAIT,
+                    TaskLane lane = TaskLane::NORMAL, uint64_t orderKey = 0,
+                    const void* tag = nullptr);
+
+    // Submit a task straight to one worker, for commands spanning every
+    // symbol that worker owns
+    bool submitShardTask(size_t threadIndex, std::function<void()> task,
+                         QueueAdmission admission = QueueAdmission::WAIT,
+                         TaskLane lane = TaskLane::NORMAL, uint64_t orderKey = 0,
+                         const void* tag = nullptr);
+
+    // Mark the newest queued task with orderKey as superseded if it has a
+    // tag and matches(tag) holds. It stays in place and still runs, with
+    // isCurrentTaskSuperseded() true, so it can report rather than act.
+    // Returns false if no queued task qualified.
+    bool supersedeQueuedTask(size_t threadIndex, uint64_t orderKey,
+                             const std::function<bool(const void*)>& matches);
+
+    // Whether the task running on the calling worker was superseded
+    static bool isCurrentTaskSuperseded();
+
+    // Most tasks each worker's queue holds, both lanes together, before
+    // admission applies; 0 (the default) leaves queues unbounded. Must be
+    // set before start(). A worker submitting to its own full queue never
+    // waits.
+    void setQueueCapacity(size_t capacity);
+    size_t getQueueCapacity() const;
+
+    // Tasks waiting in one worker's queue; safe from any thread
+    size_t getQueueDepth(size_t threadIndex) const;
     
     // Get the current thread assignment for a symbol
     int getThreadForSymbol(const std::string& symbol) const;
@@ -29,17 +92,81 @@ public:
     // Check if the thread pool is running
     bool isRunning() const;
 
+    size_t getNumThreads() const;
+
+    // Index of the pool worker running the caller, or -1 off the pool
+    static int getCurrentThreadIndex();
+
+    // Run on each worker thread as it starts, before it takes any task.
+    // Must be set before start().
+    void setWorkerStartHook(std::function<void(size_t)> hook);
+
+    // Pin each worker to one CPU, spreading workers across NUMA nodes, so
+    // the book memory a worker allocates is first touched on its own node.
+    // Must be set before start().
+    void setPinWorkers(bool pin);
+
+    // Snapshot of one worker's counters
+    WorkerStats getWorkerStats(size_t threadIndex) const;
+
 private:
+    // Own cache line so updating one worker's counters never invalidates
+    // another worker's
+    struct alignas(64) WorkerCounters {
+        std::atomic<uint64_t> tasksProcessed{0};
+        std::atomic<uint64_t> busyNanos{0};
+        std::atomic<uint64_t> idleNanos{0};
+        std::atomic<uint64_t> queueDepthHighWater{0};
+    };
+
+    struct QueuedTask {
+        std::function<void()> task;
+        uint64_t orderKey;
+        const void* tag;
+        bool superseded;
+        bool barrier;
+    };
+
+    // std::queue keeps elements in a deque, so newest stays valid until
+    // that task is popped, which also retires its key
+    struct PendingKey {
+        uint32_t count;
+        QueuedTask* newest;
+    };
+
     struct ThreadData {
-        std::queue<std::function<void()>> taskQueue;
+        std::queue<QueuedTask> taskQueue;
+        std::queue<QueuedTask> priorityQueue;
         std::mutex queueMutex;
         std::condition_variable condition;
+        std::condition_variable notFull;
+
+        // NORMAL-lane tasks queued per order key
+        std::unordered_map<uint64_t, PendingKey> pendingKeys;
+
+        // BARRIER tasks queued
+        size_t pendingBarriers = 0;
+
+        // Both lanes' size, mirrored for lock-free readers
+        std::atomic<size_t> depth{0};
+
+        size_t size() const { return taskQueue.size() + priorityQueue.size(); }
+
+        // Written only by the owning worker
+        WorkerCounters counters;
+
+        // Planned in start(); reset to -1 by the worker if pinning fails
+        std::atomic<int> cpu{-1};
+        std::atomic<int> numaNode{-1};
     };
 
     size_t numThreads;
     std::vector<std::thread> threads;
     std::vector<std::unique_ptr<ThreadData>> threadData;
     std::atomic<bool> running;
+    std::function<void(size_t)> workerStartHook;
+    bool pinWorkers = false;
+    size_t queueCapacity = 0;
     
     // Map symbols to thread indices
     mutable std::mutex symbolMapMutex;
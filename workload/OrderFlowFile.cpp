@@ -0,0 +1,98 @@
+#include "OrderFlowFile.hpp"
+#include <iostream>
+
+namespace {
+
+constexpr uint32_t ORDER_FLOW_MAGIC = 0x574C464F; // "OFLW"
+constexpr uint32_t ORDER_FLOW_VERSION = 1;
+
+struct OrderFlowFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t eventCount;
+};
+
+bool writeHeader(FILE* file, uint64_t eventCount) {
+    OrderFlowFileHeader header{ORDER_FLOW_MAGIC, ORDER_FLOW_VERSION, sizeof(OrderFlowEvent), 0, eventCount};
+    return std::fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+} // namespace
+
+OrderFlowWriter::OrderFlowWriter() : file(nullptr), eventCount(0) {
+}
+
+OrderFlowWriter::~OrderFlowWriter() {
+    close();
+}
+
+bool OrderFlowWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open order flow file: " << path << std::endl;
+        return false;
+    }
+    eventCount = 0;
+    return writeHeader(file, 0);
+}
+
+bool OrderFlowWriter::write(const OrderFlowEvent& event) {
+    if (!file || std::fwrite(&event, sizeof(event), 1, file) != 1) {
+        return false;
+    }
+    ++eventCount;
+    return true;
+}
+
+bool OrderFlowWriter::close() {
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fseek(file, 0, SEEK_SET) == 0 && writeHeader(file, eventCount);
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
+
+bool writeOrderFlowFile(const std::string& path, const std::vector<OrderFlowEvent>& events) {
+    OrderFlowWriter writer;
+    if (!writer.open(path)) {
+        return false;
+    }
+    for (const auto& event : events) {
+        if (!writer.write(event)) {
+            return false;
+        }
+    }
+    return writer.close();
+}
+
+bool readOrderFlowFile(const std::string& path, std::vector<OrderFlowEvent>& events) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Failed to open order flow file: " << path << std::endl;
+        return false;
+    }
+
+    OrderFlowFileHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == ORDER_FLOW_MAGIC &&
+              header.version == ORDER_FLOW_VERSION &&
+              header.recordSize == sizeof(OrderFlowEvent);
+
+    if (ok) {
+        events.resize(header.eventCount);
+        ok = header.eventCount == 0 ||
+             std::fread(events.data(), sizeof(OrderFlowEvent), events.size(), file) == events.size();
+    }
+    std::fclose(file);
+
+    if (!ok) {
+        std::cerr << "Invalid order flow file: " << path << std::endl;
+        events.clear();
+    }
+    return ok;
+}
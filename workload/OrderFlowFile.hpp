@@ -0,0 +1,33 @@
+#ifndef MATCHING_ENGINE_ORDERFLOWFILE_HPP
+#define MATCHING_ENGINE_ORDERFLOWFILE_HPP
+
+#include "OrderFlowGenerator.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Binary order-flow files: a small header followed by raw OrderFlowEvent
+// records in host byte order.
+//
+// OrderFlowWriter streams events so long runs need not fit in memory; the
+// event count in the header is patched in on close().
+class OrderFlowWriter {
+public:
+    OrderFlowWriter();
+    ~OrderFlowWriter();
+
+    bool open(const std::string& path);
+    bool write(const OrderFlowEvent& event);
+    bool close();
+
+private:
+    FILE* file;
+    uint64_t eventCount;
+};
+
+bool writeOrderFlowFile(const std::string& path, const std::vector<OrderFlowEvent>& events);
+
+// Returns false if the file is missing, truncated or not an order-flow file
+bool readOrderFlowFile(const std::string& path, std::vector<OrderFlowEvent>& events);
+
+#endif // MATCHING_ENGINE_ORDERFLOWFILE_HPP
@@ -0,0 +1,133 @@
+#include "OrderFlowGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+
+OrderFlowGenerator::OrderFlowGenerator(const OrderFlowConfig& config)
+    : config(config),
+      rng(config.seed),
+      symbolCdf(std::max<size_t>(config.symbolCount, 1)),
+      mids(symbolCdf.size(), config.startMid),
+      liveOrders(symbolCdf.size()),
+      nextSequence(1),
+      clockNanos(0),
+      burstRemaining(0),
+      uniform(0.0, 1.0),
+      midStep(0.0, std::max(config.midVolatilityTicks, 1e-9)),
+      depth(1.0 / std::max(1.0, config.meanDepthTicks)),
+      lots(std::log(std::max(1.0, config.medianLots)), std::max(config.sizeSigma, 1e-9)) {
+    double total = 0.0;
+    for (size_t k = 0; k < symbolCdf.size(); ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), config.zipfExponent);
+        symbolCdf[k] = total;
+    }
+    for (auto& value : symbolCdf) {
+        value /= total;
+    }
+}
+
+const OrderFlowConfig& OrderFlowGenerator::getConfig() const {
+    return config;
+}
+
+double OrderFlowGenerator::getMid(size_t symbolIndex) const {
+    return mids[symbolIndex];
+}
+
+std::string OrderFlowGenerator::symbolName(size_t symbolIndex) {
+    return "SYM" + std::to_string(symbolIndex);
+}
+
+std::string OrderFlowGenerator::orderId(const std::string& prefix, uint64_t orderSequence) {
+    return prefix + std::to_string(orderSequence);
+}
+
+std::shared_ptr<Order> OrderFlowGenerator::toOrder(const OrderFlowEvent& event, const std::string& orderIdPrefix) {
+    return std::make_shared<Order>(orderId(orderIdPrefix, event.orderSequence),
+                                   symbolName(event.symbolIndex),
+                                   event.side,
+                                   event.price,
+                                   event.quantity);
+}
+
+size_t OrderFlowGenerator::pickSymbol() {
+    auto it = std::lower_bound(symbolCdf.begin(), symbolCdf.end(), uniform(rng));
+    return std::min(static_cast<size_t>(it - symbolCdf.begin()), symbolCdf.size() - 1);
+}
+
+int OrderFlowGenerator::pickQuantity() {
+    double sampled = std::round(lots(rng));
+    return static_cast<int>(std::max(1.0, sampled)) * config.lotSize;
+}
+
+uint64_t OrderFlowGenerator::nextTimestamp() {
+    if (burstRemaining == 0 && config.burstProbability > 0.0 && uniform(rng) < config.burstProbability) {
+        std::exponential_distribution<double> burstLength(1.0 / std::max(1.0, config.meanBurstLength));
+        burstRemaining = 1 + static_cast<uint64_t>(burstLength(rng));
+    }
+
+    double rate = config.meanRatePerSecond;
+    if (burstRemaining > 0) {
+        rate *= config.burstMultiplier;
+        --burstRemaining;
+    }
+
+    if (rate > 0.0) {
+        std::exponential_distribution<double> gap(rate);
+        clockNanos += static_cast<uint64_t>(gap(rng) * 1e9);
+    }
+    return clockNanos;
+}
+
+OrderFlowEvent OrderFlowGenerator::next() {
+    OrderFlowEvent event{};
+    event.timestampNanos = nextTimestamp();
+    event.symbolIndex = static_cast<uint32_t>(pickSymbol());
+
+    // Move this symbol's mid, staying on the tick grid and above zero
+    double& mid = mids[event.symbolIndex];
+    double step = config.midVolatilityTicks > 0.0 ? midStep(rng) : 0.0;
+    step += config.midReversion * (config.startMid - mid) / config.tickSize;
+    double ticks = std::round(mid / config.tickSize + step);
+    mid = std::max(1.0, ticks) * config.tickSize;
+
+    auto& live = liveOrders[event.symbolIndex];
+    double choice = uniform(rng);
+
+    if (choice < config.cancelRatio && !live.empty()) {
+        size_t victim = static_cast<size_t>(rng() % live.size());
+        event.action = OrderFlowAction::CANCEL;
+        event.orderSequence = live[victim];
+        live[victim] = live.back();
+        live.pop_back();
+        return event;
+    }
+
+    event.action = OrderFlowAction::ADD;
+    event.orderSequence = nextSequence++;
+    event.side = (rng() & 1) ? OrderSide::BUY : OrderSide::SELL;
+    event.aggressive = choice >= config.cancelRatio && choice < config.cancelRatio + config.aggressorRatio;
+    event.quantity = pickQuantity();
+
+    // Buys rest below the mid and cross above it; sells the reverse
+    double direction = event.side == OrderSide::BUY ? 1.0 : -1.0;
+    int offsetTicks = event.aggressive
+        ? static_cast<int>(rng() % static_cast<uint64_t>(std::max(1, config.maxCrossTicks + 1)))
+        : -(1 + depth(rng));
+    event.price = std::max(config.tickSize, mid + direction * offsetTicks * config.tickSize);
+
+    if (live.size() < config.maxLiveOrdersPerSymbol) {
+        live.push_back(event.orderSequence);
+    } else if (!live.empty()) {
+        live[static_cast<size_t>(rng() % live.size())] = event.orderSequence;
+    }
+    return event;
+}
+
+std::vector<OrderFlowEvent> OrderFlowGenerator::generate(size_t count) {
+    std::vector<OrderFlowEvent> events;
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        events.push_back(next());
+    }
+    return events;
+}
@@ -0,0 +1,109 @@
+#ifndef MATCHING_ENGINE_ORDERFLOWGENERATOR_HPP
+#define MATCHING_ENGINE_ORDERFLOWGENERATOR_HPP
+
+#include "../order/Order.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class OrderFlowAction : uint8_t {
+    ADD,
+    CANCEL
+};
+
+// One generated message. Fixed-size and trivially copyable so streams can be
+// written to and read back from binary files unchanged.
+struct OrderFlowEvent {
+    uint64_t timestampNanos;  // offset from the start of the stream
+    uint64_t orderSequence;   // new order for ADD, the order to cancel for CANCEL
+    double price;
+    int32_t quantity;
+    uint32_t symbolIndex;
+    OrderSide side;
+    OrderFlowAction action;
+    bool aggressive;          // ADD priced through the mid to take liquidity
+    uint8_t reserved[2];
+};
+
+static_assert(sizeof(OrderFlowEvent) == 40, "OrderFlowEvent is a binary file record");
+
+struct OrderFlowConfig {
+    uint64_t seed = 1;
+    std::string orderIdPrefix = "W";
+
+    // Symbol popularity: symbol k is picked with weight 1 / (k + 1)^zipfExponent
+    size_t symbolCount = 16;
+    double zipfExponent = 1.0;
+
+    // Message mix; the remainder after cancels and aggressors rests passively
+    double cancelRatio = 0.3;
+    double aggressorRatio = 0.2;
+
+    // Each symbol's mid does a random walk of midVolatilityTicks per message,
+    // pulled back towards startMid by midReversion of the gap each step;
+    // passive prices sit a geometric number of ticks (mean meanDepthTicks)
+    // behind it and aggressors cross it by up to maxCrossTicks
+    double startMid = 100.0;
+    double tickSize = 0.01;
+    double midVolatilityTicks = 0.5;
+    double midReversion = 0.001;
+    double meanDepthTicks = 3.0;
+    int maxCrossTicks = 2;
+
+    // Sizes are lognormal in lots: round(exp(N(log(medianLots), sizeSigma)))
+    int lotSize = 100;
+    double medianLots = 2.0;
+    double sizeSigma = 0.8;
+
+    // Arrivals are Poisson at meanRate; a burst multiplies the rate by
+    // burstMultiplier for an exponentially distributed number of messages
+    double meanRatePerSecond = 100000.0;
+    double burstProbability = 0.0;
+    double burstMultiplier = 10.0;
+    double meanBurstLength = 100.0;
+
+    // Resting orders remembered per symbol as cancel candidates
+    size_t maxLiveOrdersPerSymbol = 4096;
+};
+
+// Deterministic synthetic order flow: with the same standard library, the
+// same config and seed always produce the same stream.
+class OrderFlowGenerator {
+public:
+    explicit OrderFlowGenerator(const OrderFlowConfig& config);
+
+    OrderFlowEvent next();
+    std::vector<OrderFlowEvent> generate(size_t count);
+
+    const OrderFlowConfig& getConfig() const;
+    double getMid(size_t symbolIndex) const;
+
+    static std::string symbolName(size_t symbolIndex);
+    static std::string orderId(const std::string& prefix, uint64_t orderSequence);
+
+    // Engine order for an ADD event
+    static std::shared_ptr<Order> toOrder(const OrderFlowEvent& event, const std::string& orderIdPrefix);
+
+private:
+    size_t pickSymbol();
+    int pickQuantity();
+    uint64_t nextTimestamp();
+
+    OrderFlowConfig config;
+    std::mt19937_64 rng;
+    std::vector<double> symbolCdf;
+    std::vector<double> mids;
+    std::vector<std::vector<uint64_t>> liveOrders;
+    uint64_t nextSequence;
+    uint64_t clockNanos;
+    uint64_t burstRemaining;
+
+    std::uniform_real_distribution<double> uniform;
+    std::normal_distribution<double> midStep;
+    std::geometric_distribution<int> depth;
+    std::lognormal_distribution<double> lots;
+};
+
+#endif // MATCHING_ENGINE_ORDERFLOWGENERATOR_HPP
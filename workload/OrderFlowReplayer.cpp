@@ -0,0 +1,57 @@
+#include "OrderFlowReplayer.hpp"
+#include <chrono>
+#include <thread>
+
+OrderFlowReplayer::OrderFlowReplayer(ContinuousMatchingEngine& engine, const std::string& orderIdPrefix)
+    : engine(engine), orderIdPrefix(orderIdPrefix), stopRequested(false) {
+}
+
+void OrderFlowReplayer::submit(const OrderFlowEvent& event) {
+    if (event.action == OrderFlowAction::CANCEL) {
+        engine.cancelOrder(OrderFlowGenerator::orderId(orderIdPrefix, event.orderSequence),
+                           OrderFlowGenerator::symbolName(event.symbolIndex));
+    } else {
+        engine.submitOrder(OrderFlowGenerator::toOrder(event, orderIdPrefix));
+    }
+}
+
+size_t OrderFlowReplayer::replay(const std::vector<OrderFlowEvent>& events, double speed) {
+    using Clock = std::chrono::steady_clock;
+    stopRequested.store(false);
+
+    auto start = Clock::now();
+    uint64_t firstTimestamp = events.empty() ? 0 : events.front().timestampNanos;
+    size_t submitted = 0;
+
+    for (const auto& event : events) {
+        if (stopRequested.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        if (speed > 0.0) {
+            auto due = start + std::chrono::nanoseconds(
+                static_cast<int64_t>(static_cast<double>(event.timestampNanos - firstTimestamp) / speed));
+
+            // Sleep through long gaps, spin out the last stretch for accuracy
+            while (true) {
+                auto remaining = due - Clock::now();
+                if (remaining <= Clock::duration::zero()) {
+                    break;
+                }
+                if (remaining > std::chrono::microseconds(200)) {
+                    std::this_thread::sleep_for(remaining - std::chrono::microseconds(100));
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        submit(event);
+        ++submitted;
+    }
+    return submitted;
+}
+
+void OrderFlowReplayer::stop() {
+    stopRequested.store(true);
+}
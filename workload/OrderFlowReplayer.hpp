@@ -0,0 +1,34 @@
+#ifndef MATCHING_ENGINE_ORDERFLOWREPLAYER_HPP
+#define MATCHING_ENGINE_ORDERFLOWREPLAYER_HPP
+
+#include "OrderFlowGenerator.hpp"
+#include "../engine/ContinuousMatchingEngine.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Feeds an order-flow stream into a ContinuousMatchingEngine.
+//
+// With speed 1.0 events are submitted at their recorded timestamps, 2.0
+// replays twice as fast, and 0 submits as fast as possible. Orders are
+// named orderIdPrefix + sequence and symbols SYM<index>; the caller must
+// have added the symbols.
+class OrderFlowReplayer {
+public:
+    OrderFlowReplayer(ContinuousMatchingEngine& engine, const std::string& orderIdPrefix = "W");
+
+    // Returns the number of events submitted; stops early on stop()
+    size_t replay(const std::vector<OrderFlowEvent>& events, double speed = 1.0);
+
+    // Submit a single event without pacing
+    void submit(const OrderFlowEvent& event);
+
+    void stop();
+
+private:
+    ContinuousMatchingEngine& engine;
+    std::string orderIdPrefix;
+    std::atomic<bool> stopRequested;
+};
+
+#endif // MATCHING_ENGINE_ORDERFLOWREPLAYER_HPP
@@ -0,0 +1,140 @@
+#include "OrderFlowFile.hpp"
+#include "OrderFlowReplayer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+// Generates a synthetic order-flow file, or replays one into an engine.
+//
+// Usage: order_flow_tool generate --output PATH [--events N] [--seed N]
+//                        [--symbols N] [--zipf S] [--cancel-ratio R]
+//                        [--aggressive-ratio R] [--rate MSGS_PER_SEC]
+//                        [--bursts P]
+//        order_flow_tool replay --input PATH [--speed X] [--threads N]
+//
+// Replay speed 1.0 follows the recorded timestamps, 0 submits as fast as
+// possible.
+
+namespace {
+
+int generate(const OrderFlowConfig& config, size_t eventCount, const std::string& output) {
+    OrderFlowGenerator generator(config);
+    OrderFlowWriter writer;
+    if (!writer.open(output)) {
+        return 1;
+    }
+    for (size_t i = 0; i < eventCount; ++i) {
+        if (!writer.write(generator.next())) {
+            std::cerr << "Failed to write " << output << std::endl;
+            return 1;
+        }
+    }
+    if (!writer.close()) {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << eventCount << " events to " << output << std::endl;
+    return 0;
+}
+
+int replay(const std::string& input, double speed, size_t threads) {
+    std::vector<OrderFlowEvent> events;
+    if (!readOrderFlowFile(input, events)) {
+        return 1;
+    }
+
+    uint32_t symbolCount = 0;
+    for (const auto& event : events) {
+        symbolCount = std::max(symbolCount, event.symbolIndex + 1);
+    }
+
+    ContinuousMatchingEngine engine(threads);
+    for (uint32_t i = 0; i < symbolCount; ++i) {
+        engine.addSymbol(OrderFlowGenerator::symbolName(i));
+    }
+
+    std::atomic<size_t> processed(0);
+    engine.registerOrderProcessingCallback([&processed](std::shared_ptr<OrderProcessingResult>) {
+        processed++;
+    });
+    engine.start();
+
+    auto start = std::chrono::steady_clock::now();
+    size_t submitted = OrderFlowReplayer(engine).replay(events, speed);
+    while (processed.load() < submitted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    engine.stop();
+
+    std::cout << "Replayed:   " << submitted << " events" << std::endl;
+    std::cout << "Elapsed:    " << elapsedSeconds << " s" << std::endl;
+    std::cout << "Throughput: " << static_cast<double>(submitted) / elapsedSeconds << " msgs/s" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: order_flow_tool generate|replay [options]" << std::endl;
+        return 1;
+    }
+
+    std::string mode = argv[1];
+    OrderFlowConfig config;
+    size_t eventCount = 1000000;
+    std::string input;
+    std::string output;
+    double speed = 1.0;
+    size_t threads = 4;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--output") {
+            output = value;
+        } else if (flag == "--input") {
+            input = value;
+        } else if (flag == "--events") {
+            eventCount = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag == "--seed") {
+            config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag == "--symbols") {
+            config.symbolCount = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (flag == "--zipf") {
+            config.zipfExponent = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--cancel-ratio") {
+            config.cancelRatio = std::atof(value.c_str());
+        } else if (flag == "--aggressive-ratio") {
+            config.aggressorRatio = std::atof(value.c_str());
+        } else if (flag == "--rate") {
+            config.meanRatePerSecond = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--bursts") {
+            config.burstProbability = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--speed") {
+            speed = std::max(0.0, std::atof(value.c_str()));
+        } else if (flag == "--threads") {
+            threads = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    if (mode == "generate" && !output.empty()) {
+        return generate(config, eventCount, output);
+    }
+    if (mode == "replay" && !input.empty()) {
+        return replay(input, speed, threads);
+    }
+    std::cerr << "Usage: order_flow_tool generate --output PATH | replay --input PATH" << std::endl;
+    return 1;
+}